@@ -10,7 +10,18 @@
  * Test Configuration:
  * - Image size: 2000x1500 pixels (RGB) = ~9 MB
  * - Test image: Synthetic gradient pattern (no I/O overhead)
- * - Filters tested: Grayscale, Box Blur (radius=3)
+ * - Filters tested: Grayscale, Box Blur (radius=3, direct vs summed-area table)
+ * - Pipeline check: in-place vs out-of-place execution (identical output)
+ * - Lazy expressions: fused brighten/invert/blend vs materialized steps
+ * - Floyd-Steinberg dithering: wavefront-parallel vs sequential (identical)
+ * - Denoising quality vs time: NL-Means (normal/fast) and Box Blur on
+ *   photos from test_images/ with synthetic Gaussian noise (PSNR, SSIM)
+ *
+ * Quality Gates (ImageCompare, exit code 1 when one fails):
+ * - GPU vs CPU: max absolute difference <= 1
+ * - Fused lazy expression vs materialized steps: max absolute difference <= 1
+ * - Summed-area blur, in-place pipeline, wavefront dithering: identical
+ * - NL-Means fast mode: at least 3 dB above the noisy input
  *
  * Measurements:
  * - Execution time per filter (milliseconds)
@@ -25,6 +36,7 @@
  * - Run multiple times for consistent results (first run may be slower)
  * - GPU performance depends on driver, device, and memory bandwidth
  * - Small images may show CPU faster due to GPU setup overhead
+ * - Usage: ./benchmark [test_images directory] (default: ../test_images)
  *
  * @see GrayscaleFilter, GrayscaleFilterGPU for grayscale implementations
  * @see BoxBlurFilter, BoxBlurFilterGPU for blur implementations
@@ -39,6 +51,23 @@
 #include "filters/GrayscaleFilterGPU.hpp"
 #include "filters/BoxBlurFilter.hpp"
 #include "filters/BoxBlurFilterGPU.hpp"
+#include "filters/InvertFilter.hpp"
+#include "filters/BrightnessFilter.hpp"
+#include "filters/SepiaFilter.hpp"
+#include "filters/NLMeansFilter.hpp"
+#include "filters/NLMeansFilterGPU.hpp"
+#include "filters/DitherFilter.hpp"
+#include "FilterPipeline.hpp"
+#include "ImageCompare.hpp"
+#include "ImageExpr.hpp"
+#include <cstring>
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <random>
+#include <vector>
+
+namespace fs = std::filesystem;
 
 void printHeader() {
     std::cout << "\n╔═══════════════════════════════════════════════════════════════╗\n";
@@ -46,7 +75,7 @@ void printHeader() {
     std::cout << "╚═══════════════════════════════════════════════════════════════╝\n\n";
 }
 
-void benchmark(const std::string& name, Filter& filter, const Image& img) {
+Image benchmark(const std::string& name, Filter& filter, const Image& img) {
     Image result;
     filter.apply(img, result);
     
@@ -54,10 +83,60 @@ void benchmark(const std::string& name, Filter& filter, const Image& img) {
               << ": " << std::setw(10) << std::right 
               << std::fixed << std::setprecision(2) 
               << filter.getLastExecutionTime() << " ms\n";
+    return result;
+}
+
+// Center crop (keeps the denoising section's runtime reasonable)
+Image cropCenter(const Image& img, int maxSide) {
+    const int w = std::min(img.getWidth(), maxSide);
+    const int h = std::min(img.getHeight(), maxSide);
+    const int x0 = (img.getWidth() - w) / 2;
+    const int y0 = (img.getHeight() - h) / 2;
+    const int channels = img.getChannels();
+    Image cropped(w, h, channels);
+    for (int y = 0; y < h; ++y) {
+        std::memcpy(cropped.data() + static_cast<size_t>(y) * w * channels,
+                    img.data() + (static_cast<size_t>(y0 + y) * img.getWidth() + x0) * channels,
+                    static_cast<size_t>(w) * channels);
+    }
+    return cropped;
+}
+
+Image addGaussianNoise(const Image& img, float sigma, unsigned seed) {
+    Image noisy = img;
+    std::mt19937 rng(seed);
+    std::normal_distribution<float> noise(0.0f, sigma);
+    for (size_t i = 0; i < noisy.size(); ++i) {
+        noisy.data()[i] = static_cast<uint8_t>(std::clamp(img.data()[i] + noise(rng) + 0.5f, 0.0f, 255.0f));
+    }
+    return noisy;
+}
+
+// Prints the gate verdict and returns whether it passed
+bool checkGate(const std::string& name, const CompareResult& result, const QualityThreshold& threshold) {
+    bool passed = ImageCompare::meets(result, threshold);
+    std::cout << name << ": écart max " << result.maxAbsDiff
+              << ", PSNR " << std::setprecision(2) << result.psnr << " dB → "
+              << (passed ? "OK" : "ÉCHEC") << "\n";
+    return passed;
+}
+
+CompareResult benchmarkDenoise(const std::string& name, Filter& filter, const Image& noisy, const Image& clean) {
+    Image result;
+    filter.apply(noisy, result);
+    CompareResult quality = ImageCompare::compare(clean, result);
+
+    std::cout << std::setw(30) << std::left << name
+              << ": " << std::setw(10) << std::right
+              << std::fixed << std::setprecision(2)
+              << filter.getLastExecutionTime() << " ms   PSNR "
+              << quality.psnr << " dB   SSIM " << std::setprecision(3) << quality.ssim << "\n";
+    return quality;
 }
 
-int main() {
+int main(int argc, char** argv) {
     printHeader();
+    const std::string testImagesDir = argc > 1 ? argv[1] : "../test_images";
     
     std::cout << "Création d'une image de test (2000x1500)...\n";
     Image testImg(2000, 1500, 3);
@@ -80,11 +159,14 @@ int main() {
     GrayscaleFilter gsCPU;
     GrayscaleFilterGPU gsGPU;
     
-    benchmark("CPU (séquentiel)", gsCPU, testImg);
-    benchmark("GPU (SYCL parallèle)", gsGPU, testImg);
+    Image gsCPUOut = benchmark("CPU (séquentiel)", gsCPU, testImg);
+    Image gsGPUOut = benchmark("GPU (SYCL parallèle)", gsGPU, testImg);
     
+    const QualityThreshold gpuGate{1};
     double speedup1 = gsCPU.getLastExecutionTime() / gsGPU.getLastExecutionTime();
-    std::cout << "Speedup GPU: " << std::setprecision(2) << speedup1 << "x\n\n";
+    std::cout << "Speedup GPU: " << std::setprecision(2) << speedup1 << "x\n";
+    bool gates = checkGate("GPU vs CPU", ImageCompare::difference(gsCPUOut, gsGPUOut), gpuGate);
+    std::cout << "\n";
     
     std::cout << " Test 2: BOX BLUR (radius=3)\n";
     std::cout << std::string(50, '-') << "\n";
@@ -92,12 +174,143 @@ int main() {
     BoxBlurFilter blurCPU(3);
     BoxBlurFilterGPU blurGPU(3);
     
-    benchmark("CPU (OpenMP)", blurCPU, testImg);
-    benchmark("GPU (SYCL parallèle)", blurGPU, testImg);
+    Image blurDirectOut = benchmark("CPU (OpenMP)", blurCPU, testImg);
+    Image blurGPUOut = benchmark("GPU (SYCL parallèle)", blurGPU, testImg);
     
     double speedup2 = blurCPU.getLastExecutionTime() / blurGPU.getLastExecutionTime();
-    std::cout << " Speedup GPU: " << std::setprecision(2) << speedup2 << "x\n\n";
+    std::cout << " Speedup GPU: " << std::setprecision(2) << speedup2 << "x\n";
+    gates = checkGate("GPU vs CPU", ImageCompare::difference(blurDirectOut, blurGPUOut), gpuGate) && gates;
+    
+    BoxBlurFilter blurSAT(3, BoxBlurMode::SummedArea);
+    Image blurSATOut;
+    blurSAT.apply(testImg, blurSATOut);
+    bool satIdentical = ImageCompare::difference(blurDirectOut, blurSATOut).maxAbsDiff == 0;
+    
+    std::cout << std::setw(30) << std::left << "CPU (summed-area table)" << ": " << std::setw(10) << std::right
+              << blurSAT.getLastExecutionTime() << " ms\n";
+    std::cout << "Speedup SAT: " << blurCPU.getLastExecutionTime() / blurSAT.getLastExecutionTime()
+              << "x, sorties identiques: " << (satIdentical ? "OUI" : "NON") << "\n\n";
+    
+    std::cout << " Test 3: PIPELINE IN-PLACE vs OUT-OF-PLACE\n";
+    std::cout << std::string(50, '-') << "\n";
+    
+    FilterPipeline pointwise;
+    pointwise.addFilter(std::make_unique<SepiaFilter>());
+    pointwise.addFilter(std::make_unique<BrightnessFilter>(1.3f));
+    pointwise.addFilter(std::make_unique<InvertFilter>());
+    pointwise.addFilter(std::make_unique<BoxBlurFilter>(1));
+    pointwise.addFilter(std::make_unique<InvertFilter>());
+    
+    pointwise.setInPlaceEnabled(false);
+    auto startOut = std::chrono::high_resolution_clock::now();
+    Image outOfPlace = pointwise.apply(Image(testImg));
+    auto endOut = std::chrono::high_resolution_clock::now();
+    
+    pointwise.setInPlaceEnabled(true);
+    auto startIn = std::chrono::high_resolution_clock::now();
+    Image inPlace = pointwise.apply(Image(testImg));
+    auto endIn = std::chrono::high_resolution_clock::now();
+    
+    bool identical = outOfPlace.getWidth() == inPlace.getWidth() &&
+                     outOfPlace.getHeight() == inPlace.getHeight() &&
+                     outOfPlace.getChannels() == inPlace.getChannels() &&
+                     ImageCompare::difference(outOfPlace, inPlace).maxAbsDiff == 0;
     
+    std::cout << std::setw(30) << std::left << "Out-of-place" << ": " << std::setw(10) << std::right
+              << std::chrono::duration<double, std::milli>(endOut - startOut).count() << " ms\n";
+    std::cout << std::setw(30) << std::left << "In-place" << ": " << std::setw(10) << std::right
+              << std::chrono::duration<double, std::milli>(endIn - startIn).count() << " ms\n";
+    std::cout << "Mémoire économisée: " << pointwise.getLastBytesSavedInPlace() / 1024 / 1024 << " MB\n";
+    std::cout << "Sorties identiques: " << (identical ? "OUI" : "NON") << "\n\n";
+    
+    std::cout << " Test 4: EXPRESSIONS LAZY (brighten → invert → blend)\n";
+    std::cout << std::string(50, '-') << "\n";
+    
+    Image overlay = testImg.createEmptyLike();
+    std::fill(overlay.data(), overlay.data() + overlay.size(), 200);
+    
+    auto startSteps = std::chrono::high_resolution_clock::now();
+    Image brightened;
+    Image inverted;
+    BrightnessFilter(1.2f).apply(testImg, brightened);
+    InvertFilter().apply(brightened, inverted);
+    Image stepped = imgexpr::blend(imgexpr::lazy(inverted), imgexpr::lazy(overlay), 0.3f);
+    auto endSteps = std::chrono::high_resolution_clock::now();
+    
+    auto startFused = std::chrono::high_resolution_clock::now();
+    Image fused = imgexpr::blend(
+        imgexpr::invert(imgexpr::clamp(imgexpr::brighten(imgexpr::lazy(testImg), 1.2f))),
+        imgexpr::lazy(overlay), 0.3f);
+    auto endFused = std::chrono::high_resolution_clock::now();
+    
+    std::cout << std::setw(30) << std::left << "Étapes matérialisées" << ": " << std::setw(10) << std::right
+              << std::chrono::duration<double, std::milli>(endSteps - startSteps).count() << " ms\n";
+    std::cout << std::setw(30) << std::left << "Expression fusionnée" << ": " << std::setw(10) << std::right
+              << std::chrono::duration<double, std::milli>(endFused - startFused).count() << " ms\n";
+    gates = checkGate("Fusionnée vs étapes", ImageCompare::difference(stepped, fused), gpuGate) && gates;
+    std::cout << "\n";
+    
+    std::cout << " Test 5: TRAMAGE FLOYD-STEINBERG (wavefront vs séquentiel)\n";
+    std::cout << std::string(50, '-') << "\n";
+    
+    DitherFilter dither(DitherMode::FloydSteinberg, 2);
+    Image ditherSequential;
+    Image ditherParallel;
+    dither.applySequential(testImg, ditherSequential);
+    double ditherSequentialTime = dither.getLastExecutionTime();
+    dither.apply(testImg, ditherParallel);
+    bool ditherIdentical = ImageCompare::difference(ditherSequential, ditherParallel).maxAbsDiff == 0;
+    
+    std::cout << std::setw(30) << std::left << "Séquentiel" << ": " << std::setw(10) << std::right
+              << ditherSequentialTime << " ms\n";
+    std::cout << std::setw(30) << std::left << "Wavefront (OpenMP)" << ": " << std::setw(10) << std::right
+              << dither.getLastExecutionTime() << " ms\n";
+    std::cout << "Sorties identiques: " << (ditherIdentical ? "OUI" : "NON") << "\n\n";
+    
+    std::cout << " Test 6: DÉBRUITAGE - QUALITÉ vs TEMPS (bruit gaussien σ=20)\n";
+    std::cout << std::string(50, '-') << "\n";
+
+    std::vector<fs::path> photos;
+    if (fs::is_directory(testImagesDir)) {
+        for (const auto& entry : fs::directory_iterator(testImagesDir)) {
+            std::string ext = entry.path().extension().string();
+            std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+            if (ext == ".jpg" || ext == ".jpeg" || ext == ".png") {
+                photos.push_back(entry.path());
+            }
+        }
+        std::sort(photos.begin(), photos.end());
+        if (photos.size() > 3) photos.resize(3);
+    }
+    if (photos.empty()) {
+        std::cout << "Aucune image dans " << testImagesDir << " (test ignoré)\n\n";
+    }
+
+    for (size_t i = 0; i < photos.size(); ++i) {
+        Image photo;
+        if (!photo.loadFromFile(photos[i].string())) continue;
+
+        Image clean = cropCenter(photo, 512);
+        Image noisy = addGaussianNoise(clean, 20.0f, static_cast<unsigned>(i + 1));
+        const double noisyPsnr = ImageCompare::psnr(clean, noisy);
+        std::cout << photos[i].filename().string() << " (" << clean.getWidth() << "x"
+                  << clean.getHeight() << "), bruité: " << std::setprecision(2)
+                  << noisyPsnr << " dB\n";
+
+        NLMeansFilter nlm(20.0f, 2, 7);
+        NLMeansFilter nlmFast(20.0f, 2, 7, true);
+        NLMeansFilterGPU nlmGPU(20.0f, 2, 7);
+        BoxBlurFilter box(1);
+
+        benchmarkDenoise("NL-Means CPU", nlm, noisy, clean);
+        CompareResult fastQuality = benchmarkDenoise("NL-Means CPU (rapide)", nlmFast, noisy, clean);
+        benchmarkDenoise("NL-Means GPU", nlmGPU, noisy, clean);
+        benchmarkDenoise("Box Blur (radius=1)", box, noisy, clean);
+        gates = checkGate("Mode rapide (≥ bruité + 3 dB)", fastQuality,
+                          QualityThreshold{255, noisyPsnr + 3.0}) && gates;
+        std::cout << "\n";
+    }
+
     std::cout << "╔═══════════════════════════════════════════════════════════════╗\n";
     std::cout << "║                       RÉSUMÉ                                  ║\n";
     std::cout << "╠═══════════════════════════════════════════════════════════════╣\n";
@@ -105,5 +318,5 @@ int main() {
     std::cout << "║ Blur Speedup GPU:      " << std::setw(10) << speedup2 << "x                     ║\n";
     std::cout << "╚═══════════════════════════════════════════════════════════════╝\n";
     
-    return 0;
+    return (identical && satIdentical && ditherIdentical && gates) ? 0 : 1;
 }
@@ -0,0 +1,109 @@
+/**
+ * @file BatchJournal.hpp
+ * @brief Append-only journal of completed batch items, for resuming a killed run
+ *
+ * Every image a batch finishes is appended here: a key of its input (hash
+ * of the absolute path, file size and modification time), its perceptual
+ * hash when duplicates are detected, its output path and size, and the
+ * pipeline time. A run restarted after a kill (preemption, OOM) opens the
+ * same journal and skips the images completed() confirms: input unchanged,
+ * output still there with the size it was written with.
+ *
+ * Journal: a header line "IFJ1 <run key>", then one line per item,
+ * "<input key> <pHash> <output size> <ms> <checksum> <output path>". The
+ * run key identifies the pipeline and options; a journal of another run
+ * is started over.
+ *
+ * @details
+ * - record() only queues the item; a writer thread appends the queued
+ *   lines with one write and one fsync per group (every syncEvery items or
+ *   syncIntervalMs, whichever comes first), so thousands of images a minute
+ *   cost a few syncs a second and never wait for the disk
+ * - Crash safety: a record is durable once its group is synced; a kill
+ *   loses at most the last group, whose images are simply redone. A line
+ *   torn by the kill fails its checksum and is cut off when reopening,
+ *   before anything is appended after it
+ *
+ * @author Rowan HOUPA
+ * @date January 2026
+ */
+
+#ifndef BATCH_JOURNAL_HPP
+#define BATCH_JOURNAL_HPP
+
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+class BatchJournal {
+public:
+    struct Entry {
+        uint64_t perceptualHash = 0;    // 0 when not computed
+        uint64_t outputSize = 0;
+        double ms = 0.0;
+        std::string outputPath;
+    };
+
+    // Opens (or starts) the journal at path for the run identified by runKey
+    BatchJournal(std::string path, const std::string& runKey,
+                 size_t syncEvery = 256, int syncIntervalMs = 500);
+    ~BatchJournal();
+
+    BatchJournal(const BatchJournal&) = delete;
+    BatchJournal& operator=(const BatchJournal&) = delete;
+
+    bool isOpen() const { return file != nullptr; }
+
+    // Entry of inputPath from a previous run, if its input is unchanged and
+    // its output intact
+    bool completed(const std::string& inputPath, Entry& entry) const;
+
+    // Queues a completed item (returns at once)
+    void record(const std::string& inputPath, const std::string& outputPath,
+                uint64_t perceptualHash, double ms);
+    // Writes and syncs everything recorded so far
+    void flush();
+
+    // Entries read back when opening
+    size_t getResumedCount() const { return resumed.size(); }
+    size_t getSyncCount() const;
+
+    // Hash of the absolute path, size and modification time; 0 if missing
+    static uint64_t inputKey(const std::string& path);
+
+private:
+    struct Pending {
+        std::string inputPath;
+        std::string outputPath;
+        uint64_t perceptualHash;
+        double ms;
+    };
+
+    void load(const std::string& runKey);
+    void writerLoop();
+    void writeGroup(std::vector<Pending>& group);
+
+    std::string path;
+    std::FILE* file = nullptr;
+    std::unordered_map<uint64_t, Entry> resumed;    // By input key
+
+    size_t syncEvery;
+    int syncIntervalMs;
+    mutable std::mutex mutex;                       // Guards queue, stop, syncs, written
+    std::condition_variable wake;                   // Writer: items queued or stop
+    std::condition_variable flushed;                // flush(): a group was synced
+    std::vector<Pending> queue;
+    bool stop = false;
+    bool flushRequested = false;
+    size_t recorded = 0;
+    size_t written = 0;
+    size_t syncs = 0;
+    std::thread writer;
+};
+
+#endif
@@ -0,0 +1,72 @@
+/**
+ * @file BinaryImage.hpp
+ * @brief Bit-packed 1-bit-per-pixel image (binarized documents, masks)
+ *
+ * Stores one bit per pixel, 8x less memory than a 1-channel Image. Produced
+ * by the threshold filters (ThresholdFilter::applyPacked) and consumed by
+ * downstream stages without unpacking.
+ *
+ * Memory Layout: rows padded to whole bytes, most significant bit first
+ * (the PBM P4 layout). A set bit is foreground / white (255 once unpacked).
+ *
+ * @details
+ * - saveToFile(): ".pbm" is written natively as binary PBM (1 bit/pixel);
+ *   other formats go through toImage() and Image::saveToFile()
+ * - countSet(): popcount over whole bytes, padding bits are always zero
+ *
+ * @see ThresholdFilter for the producers
+ * @author Rowan HOUPA
+ * @date January 2026
+ */
+
+#ifndef BINARY_IMAGE_HPP
+#define BINARY_IMAGE_HPP
+
+#include "Image.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class BinaryImage {
+public:
+    BinaryImage() = default;
+    BinaryImage(int width, int height);
+
+    // Pixels whose first channel is above threshold become set bits
+    static BinaryImage fromImage(const Image& image, int threshold = 127);
+    // 1-channel Image with 0 (clear) / 255 (set)
+    Image toImage() const;
+
+    bool saveToFile(const std::string& filepath) const;
+
+    int getWidth() const { return m_width; }
+    int getHeight() const { return m_height; }
+    int getRowBytes() const { return m_rowBytes; }
+    size_t size() const { return m_bits.size(); }
+    bool empty() const { return m_bits.empty(); }
+
+    uint8_t* data() { return m_bits.data(); }
+    const uint8_t* data() const { return m_bits.data(); }
+    uint8_t* row(int y) { return m_bits.data() + static_cast<size_t>(y) * m_rowBytes; }
+    const uint8_t* row(int y) const { return m_bits.data() + static_cast<size_t>(y) * m_rowBytes; }
+
+    bool get(int x, int y) const {
+        return (row(y)[x >> 3] >> (7 - (x & 7))) & 1;
+    }
+    void set(int x, int y, bool value) {
+        uint8_t mask = static_cast<uint8_t>(0x80 >> (x & 7));
+        uint8_t& byte = row(y)[x >> 3];
+        byte = value ? (byte | mask) : (byte & ~mask);
+    }
+
+    // Number of set (foreground) pixels
+    size_t countSet() const;
+
+private:
+    int m_width = 0;
+    int m_height = 0;
+    int m_rowBytes = 0;
+    std::vector<uint8_t> m_bits;
+};
+
+#endif
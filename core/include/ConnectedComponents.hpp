@@ -0,0 +1,95 @@
+/**
+ * @file ConnectedComponents.hpp
+ * @brief Parallel connected-component labeling with region statistics
+ *
+ * Labels the foreground regions of a binary image (typically the output of
+ * a threshold filter) and measures each region: bounding box, area and
+ * centroid. Used for QA and document layout analysis (characters, words,
+ * specks, stamps).
+ *
+ * Output:
+ * - Label image: one uint32 per pixel, 0 = background, 1..N = component
+ *   (components numbered in raster order of their first pixel)
+ * - getComponents()[label - 1]: statistics of each component
+ *
+ * @details
+ * Block-based union-find (the label image itself is the union-find forest,
+ * each entry holding parent index + 1, so no extra per-pixel memory):
+ * 1. Local pass: the image is cut into bands of 64 rows; each thread
+ *    labels its bands with plain union-find (roots are the smallest index)
+ * 2. Border merge: the first row of every band is united with the last row
+ *    of the band above using lock-free compare-and-swap unions
+ * 3. Flatten: every pixel points directly at its root; roots are counted
+ *    per band and numbered with a prefix sum (raster order)
+ * 4. Relabel + statistics in one pass: components rooted in a band are
+ *    accumulated straight into the global table (disjoint slots), those
+ *    entering from above go to small per-band maps merged at the end
+ *
+ * Parallelization: OpenMP over bands in every pass; std::atomic_ref for
+ * the border unions. Scales to 100 MP pages (memory: 4 bytes per pixel).
+ *
+ * @see BinaryImage, ThresholdFilter
+ * @author Rowan HOUPA
+ * @date January 2026
+ */
+
+#ifndef CONNECTED_COMPONENTS_HPP
+#define CONNECTED_COMPONENTS_HPP
+
+#include "BinaryImage.hpp"
+#include "Image.hpp"
+#include <cstdint>
+#include <vector>
+
+struct ComponentStats {
+    int minX = 0, minY = 0;      // Bounding box (inclusive)
+    int maxX = 0, maxY = 0;
+    uint64_t area = 0;           // Pixel count
+    double centroidX = 0.0;      // Mean pixel position
+    double centroidY = 0.0;
+
+    int getWidth() const { return maxX - minX + 1; }
+    int getHeight() const { return maxY - minY + 1; }
+};
+
+class ConnectedComponents {
+public:
+    enum class Connectivity { Four = 4, Eight = 8 };
+
+    explicit ConnectedComponents(Connectivity connectivity = Connectivity::Eight)
+        : connectivity(connectivity) {}
+
+    // Labels the set bits of a packed binary image
+    void label(const BinaryImage& image);
+    // Labels the pixels whose first channel is above threshold
+    void label(const Image& image, int threshold = 127);
+
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    size_t getComponentCount() const { return components.size(); }
+
+    // Label image (width × height, 0 = background)
+    const std::vector<uint32_t>& getLabels() const { return labels; }
+    uint32_t labelAt(int x, int y) const {
+        return labels[static_cast<size_t>(y) * width + x];
+    }
+    // Statistics, indexed by label - 1
+    const std::vector<ComponentStats>& getComponents() const { return components; }
+
+    // Colored visualization (background black, one color per label)
+    Image toColorImage() const;
+
+    Connectivity getConnectivity() const { return connectivity; }
+    void setConnectivity(Connectivity value) { connectivity = value; }
+    double getLastExecutionTime() const { return lastExecutionTime; }
+
+private:
+    Connectivity connectivity = Connectivity::Eight;
+    int width = 0;
+    int height = 0;
+    std::vector<uint32_t> labels;
+    std::vector<ComponentStats> components;
+    double lastExecutionTime = 0.0;
+};
+
+#endif
@@ -0,0 +1,61 @@
+/**
+ * @file ContactSheet.hpp
+ * @brief Contact sheets (thumbnail mosaics) built from in-memory results
+ *
+ * Collects a thumbnail of every image handed to add() into fixed-size grid
+ * sheets (columns × rows cells, new sheets opened as needed), for visual QA
+ * of a batch without reloading its outputs.
+ *
+ * Layout: each cell is thumbnailSize² pixels plus padding; the thumbnail is
+ * scaled to fit the cell (aspect ratio kept) and centered on a dark
+ * background. Sheets are always RGB: gray is replicated, alpha is blended
+ * over the background.
+ *
+ * @details
+ * - thumbnail(): area-averaging downscale. For each output row the source
+ *   rows it covers are summed into a uint32 row (`omp simd`, the bulk of
+ *   the work), then each output pixel averages its column span. OpenMP over
+ *   output rows.
+ * - add() is thread-safe: a cell is reserved under a mutex, the downscale
+ *   and the copy into the (disjoint) cell run without locking
+ *
+ * @author Rowan HOUPA
+ * @date January 2026
+ */
+
+#ifndef CONTACT_SHEET_HPP
+#define CONTACT_SHEET_HPP
+
+#include "Image.hpp"
+#include <deque>
+#include <mutex>
+#include <string>
+
+class ContactSheet {
+public:
+    explicit ContactSheet(int thumbnailSize = 160, int columns = 8, int rows = 6, int padding = 4);
+
+    // Adds a thumbnail of image to the next free cell
+    void add(const Image& image);
+
+    // Writes every sheet as <stem>_<n><ext> (e.g. sheet_1.jpg); returns the number written
+    int save(const std::string& basePath) const;
+
+    size_t getSheetCount() const { return sheets.size(); }
+    const Image& getSheet(size_t index) const { return sheets[index]; }
+    size_t getImageCount() const { return count; }
+
+    // Area-averaged copy fitting in maxWidth × maxHeight (never upscales)
+    static Image thumbnail(const Image& image, int maxWidth, int maxHeight);
+
+private:
+    int thumbnailSize;
+    int columns;
+    int rows;
+    int padding;
+    size_t count = 0;
+    std::deque<Image> sheets;   // Stable references while cells are filled
+    mutable std::mutex mutex;
+};
+
+#endif
@@ -0,0 +1,155 @@
+/**
+ * @file EditHistory.hpp
+ * @brief Memory-bounded undo/redo of pipeline edits with compressed snapshots
+ *
+ * A full Image per step would exhaust memory on large photos (a 24 MP RGB
+ * result is 72 MB). The history instead stores:
+ * - One diff per edit: the edit replaced filters [position, position + n)
+ *   by m others (a parameter change replaces one filter by a modified
+ *   clone, add/remove/move/clear are the other splices). Undo and redo
+ *   splice the clones back into the history's copy of the pipeline.
+ * - Occasional pixel snapshots, taken when a full result exists anyway
+ *   (Apply): the output of the first k filters of the pipeline at some
+ *   step, LZ-compressed on a background thread
+ *
+ * Restoring pixels replays: a snapshot still describes the pipeline at
+ * another step when no diff between the two steps touches its first k
+ * filters; the one with the largest k (then the closest step) is decoded
+ * and only the remaining filters are applied (replayBase()). The original
+ * image is the fallback with k = 0.
+ *
+ * Memory: snapshots (raw size while queued, compressed size afterwards)
+ * plus an estimate per diff never exceed the cap. Over the cap, snapshots
+ * are thinned (the one closest to its predecessor goes first, leaving them
+ * spread over the history), then the oldest steps are forgotten.
+ *
+ * @details
+ * - Consecutive edits with the same merge key (one slider drag) extend one
+ *   step instead of adding one per value
+ * - Snapshot pixels are delta-coded against the pixel to the left before
+ *   LZCodec, which turns smooth areas into runs of small values
+ * - Thread-safe; the compression thread only touches its own snapshot and
+ *   the byte accounting
+ *
+ * @see LZCodec for the compression
+ * @author Rowan HOUPA
+ * @date January 2026
+ */
+
+#ifndef EDIT_HISTORY_HPP
+#define EDIT_HISTORY_HPP
+
+#include "Filter.hpp"
+#include "FilterPipeline.hpp"
+#include "Image.hpp"
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+class EditHistory {
+public:
+    explicit EditHistory(size_t maxBytes = size_t(256) << 20);
+    ~EditHistory();
+    EditHistory(const EditHistory&) = delete;
+    EditHistory& operator=(const EditHistory&) = delete;
+
+    // New image: forgets every step and snapshot
+    void reset(std::shared_ptr<const Image> original, const FilterPipeline& pipeline);
+
+    // Edit just made: filters [position, position + removed) of the previous
+    // pipeline became [position, position + inserted) of pipeline. Drops the
+    // redo steps. A non-empty mergeKey equal to the last step's extends it.
+    void record(const FilterPipeline& pipeline, size_t position, size_t removed, size_t inserted,
+                const std::string& label, const std::string& mergeKey = "");
+
+    bool canUndo() const;
+    bool canRedo() const;
+    std::string undoLabel() const;
+    std::string redoLabel() const;
+    // One step back / forward; the pipeline of the new step is getPipeline()
+    bool undo();
+    bool redo();
+    FilterPipeline getPipeline() const;
+
+    // Changes with every edit, undo, redo and reset, so a caller can tell
+    // whether the pipeline it ran is still the current one
+    uint64_t getRevision() const;
+
+    // Full result of the pipeline at revision; compressed in the background.
+    // False when it alone exceeds the cap, or when the history moved since
+    // revision (the result belongs to no step any more).
+    bool addSnapshot(const Image& result, uint64_t revision);
+
+    // Best starting point for the current pipeline: image is the output of
+    // its filters [0, first) (the original image when first is 0)
+    struct ReplayBase {
+        std::shared_ptr<const Image> image;
+        size_t first = 0;
+    };
+    ReplayBase replayBase() const;
+
+    struct Stats {
+        size_t steps = 0;
+        size_t position = 0;        // Steps currently applied
+        size_t snapshots = 0;
+        size_t pendingSnapshots = 0;    // Not compressed yet
+        size_t snapshotBytes = 0;       // As stored
+        size_t snapshotRawBytes = 0;    // Uncompressed size of the same snapshots
+        size_t diffBytes = 0;           // Estimate
+    };
+    Stats getStats() const;
+    size_t getMaxBytes() const { return maxBytes; }
+
+private:
+    struct Step {
+        size_t position;
+        std::vector<std::unique_ptr<Filter>> before;
+        std::vector<std::unique_ptr<Filter>> after;
+        std::string label;
+        std::string mergeKey;
+    };
+
+    struct Snapshot {
+        size_t step;                        // History position it was taken at
+        size_t prefix;                      // Filters applied
+        int width;
+        int height;
+        int channels;
+        std::shared_ptr<const Image> raw;   // Until compressed
+        std::vector<uint8_t> packed;
+    };
+
+    static void splice(FilterPipeline& pipeline, size_t position, size_t count,
+                       const std::vector<std::unique_ptr<Filter>>& filters);
+    static std::vector<uint8_t> pack(const Image& image);
+    static Image unpack(const Snapshot& snapshot);
+
+    bool usableLocked(const Snapshot& snapshot) const;
+    size_t bytesLocked() const;
+    size_t diffBytesLocked() const;
+    void enforceCapLocked();
+    void dropStepLocked();
+    void compressionLoop();
+
+    size_t maxBytes;
+    std::shared_ptr<const Image> original;
+    FilterPipeline head;                    // Pipeline at the current position
+    std::vector<Step> steps;
+    size_t current = 0;                     // Steps applied
+    uint64_t revision = 0;                  // See getRevision()
+    bool mergeOpen = false;                 // The last step may still be extended
+    std::vector<std::shared_ptr<Snapshot>> snapshots;
+    mutable std::mutex mutex;
+
+    std::deque<std::shared_ptr<Snapshot>> compressionQueue;
+    std::condition_variable compressionReady;
+    bool stopping = false;
+    std::thread compressionThread;
+};
+
+#endif
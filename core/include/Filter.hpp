@@ -13,6 +13,12 @@
  * - getName(): Returns filter display name for UI
  * - clone(): Prototype pattern for filter duplication
  * - supportsGPU(): Query GPU acceleration availability
+ * - takeReportedDevice(): Device the calling thread's last filter call ran on
+ *   (profiling)
+ * - supportsInPlace()/applyInPlace(): Optional in-place execution for filters
+ *   that keep the image shape (saves one full buffer per pipeline step)
+ * - getHaloRadius(): Neighbourhood each output pixel reads, so regions of an
+ *   image can be filtered on their own (tiles, viewports)
  *
  * @see FilterFactory for dynamic filter creation
  * @see FilterPipeline for chaining multiple filters
@@ -27,6 +33,7 @@
 #include "Image.hpp"
 #include <memory>
 #include <string>
+#include <utility>
 
 class Filter {
 public:
@@ -51,6 +58,41 @@ public:
     }
 
      virtual double getLastExecutionTime() const { return 0.0; }
+
+    // Where the last filter call on the calling thread ran: "CPU", or the
+    // SYCL device name (GPU filters, "CPU" again after a fallback); resets
+    // it to "CPU". Kept per thread rather than in the filter, since one
+    // filter may be running on several threads.
+    static std::string takeReportedDevice() {
+        std::string device = std::move(reportedDevice);
+        reportedDevice = "CPU";
+        return device;
+    }
+
+    // In-place capability query: true when the filter keeps width, height and
+    // channel count, and each output pixel only depends on the same input pixel
+    virtual bool supportsInPlace() const { return false; }
+
+    // Optional in-place implementation (image is both input and output)
+    virtual void applyInPlace(Image& image) {
+        // Default fallback to out-of-place processing
+        Image result;
+        apply(image, result);
+        image = std::move(result);
+    }
+
+    // Radius of the input neighbourhood each output pixel depends on, or -1
+    // when the result also depends on the pixel position, the whole image or
+    // previous frames (the filter cannot run on a crop). Default: point-wise
+    // for in-place filters, unknown (-1) otherwise.
+    virtual int getHaloRadius() const { return supportsInPlace() ? 0 : -1; }
+
+protected:
+    // GPU filters: device the current call runs on
+    static void reportDevice(std::string device) { reportedDevice = std::move(device); }
+
+private:
+    static inline thread_local std::string reportedDevice = "CPU";
 };
 
 #endif
@@ -9,9 +9,13 @@
  * Key Features:
  * - Add/remove/reorder filters dynamically
  * - Apply all filters sequentially with progress tracking
+ * - In-place execution of shape-preserving filters (no second buffer)
+ * - Region-of-interest execution: only a rectangle plus the filters' halo
+ *   is processed (viewports, tiles)
  * - Support for CPU/GPU processing mode selection
  * - Pipeline serialization (save/load to JSON)
- * - Performance metrics collection
+ * - Performance metrics collection, and continuous per-filter profiling
+ *   shared by every copy of the pipeline (PipelineProfile)
  *
  * @see Filter.hpp for the base filter interface
  * @see FilterFactory.hpp for filter creation
@@ -25,6 +29,7 @@
 
 #include "Filter.hpp"
 #include "Image.hpp"
+#include "PipelineProfile.hpp"
 #include <vector>
 #include <memory>
 #include <string>
@@ -59,8 +64,16 @@ public:
     Image apply(const Image& input) const;
     Image apply(Image&& input) const;
     
+    // Filtered pixels of the width × height region at (x, y) of input. Only
+    // the region widened by getHaloRadius() is processed; pipelines with a
+    // whole-image filter (halo -1) process everything and crop. The region
+    // must lie inside the image and the pipeline must keep the image size.
+    Image applyRegion(const Image& input, int x, int y, int width, int height) const;
+    
+    // first > 0 resumes from an intermediate result: input is the output of
+    // filters [0, first) and only the remaining ones are applied
     template<typename ProgressCallback>
-    Image applyWithProgress(const Image& input, ProgressCallback callback) const;
+    Image applyWithProgress(const Image& input, ProgressCallback callback, size_t first = 0) const;
     
     size_t size() const { return filters.size(); }
     bool empty() const { return filters.empty(); }
@@ -68,6 +81,9 @@ public:
     const Filter* getFilter(size_t index) const;
     Filter* getFilter(size_t index);
     
+    // Sum of the filters' halo radii, -1 if any filter needs the whole image
+    int getHaloRadius() const;
+    
     std::string toString() const;
     bool fromString(const std::string& config);
     
@@ -81,36 +97,58 @@ public:
         std::vector<double> filterTimes;
         std::vector<std::string> filterNames;
         bool gpuUsed;
+        size_t bytesSavedInPlace = 0; // Output allocations avoided by in-place steps
     };
     
     PipelineMetrics applyWithMetrics(const Image& input);
     
     enum class ProcessingMode { AUTO, CPU_ONLY, GPU_PREFERRED };
     void setProcessingMode(ProcessingMode mode) { processingMode = mode; }
+    ProcessingMode getProcessingMode() const { return processingMode; }
+    
+    // In-place execution for filters declaring supportsInPlace() (default: on)
+    void setInPlaceEnabled(bool enabled) { inPlaceEnabled = enabled; }
+    bool isInPlaceEnabled() const { return inPlaceEnabled; }
+    size_t getLastBytesSavedInPlace() const { return lastBytesSavedInPlace; }
+
+    // Every step and run is timed into profile (nullptr: off). Copies of the
+    // pipeline keep the same profile.
+    void setProfile(std::shared_ptr<PipelineProfile> newProfile) { profile = std::move(newProfile); }
+    const std::shared_ptr<PipelineProfile>& getProfile() const { return profile; }
     
 private:
     std::vector<std::unique_ptr<Filter>> filters;
     
     std::unique_ptr<Filter> cloneFilter(const Filter* filter) const;
+    using Clock = std::chrono::steady_clock;
+    // Applies filter index to image; returns the bytes saved by running in place
+    size_t applyStep(size_t index, Image& image) const;
+    void recordStep(size_t index, Clock::time_point start, const Image& output) const;
+    void recordRun(Clock::time_point start, const Image& output) const;
     ProcessingMode processingMode = ProcessingMode::AUTO;
+    bool inPlaceEnabled = true;
+    mutable size_t lastBytesSavedInPlace = 0;
+    std::shared_ptr<PipelineProfile> profile;
 };
 
 template<typename ProgressCallback>
-Image FilterPipeline::applyWithProgress(const Image& input, ProgressCallback callback) const {
-    if (filters.empty()) {
+Image FilterPipeline::applyWithProgress(const Image& input, ProgressCallback callback, size_t first) const {
+    if (first >= filters.size()) {
         return input;
     }
     
+    const Clock::time_point start = Clock::now();
     Image result = input;
-    float progressStep = 100.0f / filters.size();
+    float progressStep = 100.0f / (filters.size() - first);
+    lastBytesSavedInPlace = 0;
     
-    for (size_t i = 0; i < filters.size(); ++i) {
-        Image temp = std::move(result);
-        filters[i]->apply(temp, result);
+    for (size_t i = first; i < filters.size(); ++i) {
+        lastBytesSavedInPlace += applyStep(i, result);
         
-        callback((i + 1) * progressStep, filters[i]->getName());
+        callback((i - first + 1) * progressStep, filters[i]->getName());
     }
     
+    recordRun(start, result);
     return result;
 }
 
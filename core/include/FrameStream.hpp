@@ -0,0 +1,119 @@
+/**
+ * @file FrameStream.hpp
+ * @brief Raw RGB/RGBA and Y4M frame streaming through a filter pipeline
+ *
+ * Processes video frame sequences without per-frame image files: frames are
+ * read from a pipe or file (stdin by default), filtered, and written to
+ * another pipe or file (stdout by default).
+ * - FrameFormat::RawRGB / RawRGBA: headerless packed frames of a size
+ *   given by the caller (width × height × 3 or 4 bytes each)
+ * - FrameFormat::Y4M: YUV4MPEG2 stream (4:2:0, 4:4:4 or mono, 8-bit),
+ *   converted to RGB with BT.601 limited-range coefficients; the output
+ *   keeps the input's chroma layout, frame rate and aspect tokens
+ *
+ * @details
+ * - FrameStream::run() is a three-stage pipeline on three threads:
+ *   decode (frame N + 1) || filter (frame N) || encode (frame N - 1).
+ *   Stages are connected by FIFO queues, so frames keep their order.
+ * - Buffers: a fixed pool of Images circulates between the stages (moved,
+ *   never copied), and readers/writers keep their plane buffers across
+ *   frames. With in-place filters (see Filter::supportsInPlace) the steady
+ *   state performs no allocation at all; out-of-place filters swap in
+ *   their own output buffer, which then joins the pool.
+ * - YUV <-> RGB conversions are OpenMP loops over rows
+ *
+ * @see FilterPipeline::apply(Image&&) for the in-place execution path
+ * @author Rowan HOUPA
+ * @date January 2026
+ */
+
+#ifndef FRAME_STREAM_HPP
+#define FRAME_STREAM_HPP
+
+#include "FilterPipeline.hpp"
+#include "Image.hpp"
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <vector>
+
+enum class FrameFormat { RawRGB, RawRGBA, Y4M };
+
+class FrameReader {
+public:
+    enum class Chroma { C420, C444, Mono };
+
+    // Raw formats need width and height; Y4M reads them from its header
+    FrameReader(std::FILE* file, FrameFormat format, int width = 0, int height = 0);
+
+    // Validates the size (raw) or parses the stream header (Y4M)
+    bool open();
+    // Fills frame (reallocated only when its size differs); false at end of stream or on error
+    bool readFrame(Image& frame);
+
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    FrameFormat getFormat() const { return format; }
+    Chroma getChroma() const { return chroma; }
+    // Y4M header tokens other than W, H and C (e.g. "F25:1 Ip A1:1")
+    const std::string& getStreamParameters() const { return parameters; }
+    const std::string& getError() const { return error; }
+
+private:
+    bool readY4MFrame(Image& frame);
+
+    std::FILE* file;
+    FrameFormat format;
+    int width;
+    int height;
+    Chroma chroma = Chroma::C420;
+    std::string parameters;
+    std::string error;
+    std::vector<uint8_t> planes;    // Y, U, V (reused across frames)
+};
+
+class FrameWriter {
+public:
+    // Y4M output uses the reader's chroma layout and stream parameters
+    FrameWriter(std::FILE* file, FrameFormat format,
+                FrameReader::Chroma chroma = FrameReader::Chroma::C420,
+                const std::string& parameters = "F25:1 Ip A1:1");
+
+    // Converts to the output layout if needed; all frames must share one size
+    bool writeFrame(const Image& frame);
+    void flush() { std::fflush(file); }
+
+    const std::string& getError() const { return error; }
+
+private:
+    std::FILE* file;
+    FrameFormat format;
+    FrameReader::Chroma chroma;
+    std::string parameters;
+    std::string error;
+    int width = 0;                  // Set by the first frame
+    int height = 0;
+    std::vector<uint8_t> scratch;   // Converted frame (reused across frames)
+};
+
+struct StreamStats {
+    size_t frames = 0;
+    double totalMs = 0.0;           // Wall time of the whole stream
+    double filterMs = 0.0;          // Time spent in the pipeline
+    std::string error;              // Empty when the whole stream was processed
+};
+
+class FrameStream {
+public:
+    // Decodes, filters and encodes every frame in order, the three stages
+    // overlapping on separate threads. slots = frames in flight (>= 2).
+    static StreamStats run(FrameReader& reader, FrameWriter& writer, const FilterPipeline& pipeline,
+                           int slots = 3);
+    // Same with any per-frame processing (e.g. TemporalProcessor::process),
+    // always called from the caller's thread, in frame order
+    static StreamStats run(FrameReader& reader, FrameWriter& writer,
+                           const std::function<Image(Image&&)>& process, int slots = 3);
+};
+
+#endif
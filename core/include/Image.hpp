@@ -5,9 +5,12 @@
  * This file defines the Image class which serves as the fundamental data
  * structure for all image processing operations. It provides:
  * - Pixel storage using std::vector<uint8_t> (STL container)
- * - File I/O via STB library (PNG, JPG, BMP, TGA)
+ * - File I/O via STB library (PNG, JPG, BMP, TGA), optionally reporting
+ *   the share of the file the decoder has consumed (background loading)
  * - Bounds-checked pixel access via at(x, y, channel)
+ * - Rectangular copies via crop() (tiles, regions of interest)
  * - SYCL buffer creation for GPU processing
+ * - Construction/assignment from lazy expressions (see ImageExpr.hpp)
  *
  * Memory Layout: Pixels are stored in row-major order as [R,G,B,R,G,B,...]
  * for RGB images, or [Y,Y,Y,...] for grayscale.
@@ -23,17 +26,27 @@
 #define IMAGE_HPP
 
 #include <cstdint>
+#include <functional>
 #include <vector>
 #include <string>
 #include <stdexcept>
 #include <sycl/sycl.hpp> // For SYCL buffer compatibility
 
+namespace imgexpr { template<typename Derived> class ImageExpr; }
+
 class Image {
 public:
     Image() = default;
     Image(int width, int height, int channels = 3);
     
+    // Fused evaluation of a lazy expression (defined in ImageExpr.hpp)
+    template<typename E> Image(const imgexpr::ImageExpr<E>& expression);
+    template<typename E> Image& operator=(const imgexpr::ImageExpr<E>& expression);
+    
     bool loadFromFile(const std::string& filepath);
+    // progress(percent) is called from the decoding thread each time one
+    // more percent of the file has been read (PNG reads all, then inflates)
+    bool loadFromFile(const std::string& filepath, const std::function<void(int)>& progress);
     bool saveToFile(const std::string& filepath) const;
     
     int getWidth() const { return m_width; }
@@ -47,6 +60,9 @@ public:
     uint8_t& at(int x, int y, int channel);
     const uint8_t& at(int x, int y, int channel) const;
     
+    // Copy of the width × height rectangle at (x, y); must lie inside the image
+    Image crop(int x, int y, int width, int height) const;
+    
     sycl::buffer<uint8_t, 1> createSyclBuffer() {
         return sycl::buffer<uint8_t, 1>(m_pixels.data(), sycl::range<1>(m_pixels.size()));
     }
@@ -0,0 +1,72 @@
+/**
+ * @file ImageCompare.hpp
+ * @brief Image comparison metrics: max/mean absolute difference, PSNR, SSIM
+ *
+ * Measures how far a result is from a reference, to check that CPU and GPU
+ * paths agree and that approximate or fast modes (NL-Means fast mode,
+ * quantization, summed-area blur...) stay above a quality threshold:
+ * - difference(): max and mean absolute difference, MSE, PSNR and the
+ *   number of values differing by more than a tolerance, in one pass
+ * - ssim(): mean structural similarity (Wang et al. 2004) over 11x11
+ *   Gaussian windows (σ = 1.5), averaged over the color channels
+ * - compare() + QualityThreshold: all metrics and a pass/fail verdict
+ *
+ * @details
+ * - Difference metrics: a single OpenMP `parallel for simd` loop with
+ *   integer max/sum reductions (exact, vectorized)
+ * - SSIM: bands of 32 rows per thread; each source row is blurred
+ *   horizontally into five planes (x, y, x², y², xy), then the vertical
+ *   pass and the SSIM formula run as `omp simd` loops over the band.
+ *   Borders are clamped; alpha channels are ignored
+ * - Both images must have the same dimensions (std::invalid_argument)
+ *
+ * @see benchmark.cpp for the quality gates on fast modes
+ * @author Rowan HOUPA
+ * @date January 2026
+ */
+
+#ifndef IMAGE_COMPARE_HPP
+#define IMAGE_COMPARE_HPP
+
+#include "Image.hpp"
+#include <cstddef>
+
+struct CompareResult {
+    int maxAbsDiff = 0;          // Largest |reference - test| over all values
+    double meanAbsDiff = 0.0;
+    double mse = 0.0;
+    double psnr = 0.0;           // dB, ImageCompare::PSNR_IDENTICAL when mse == 0
+    double ssim = 1.0;           // Mean SSIM (only filled by compare(..., true))
+    size_t mismatches = 0;       // Values differing by more than the tolerance
+};
+
+// Minimum quality required from a result (defaults accept anything)
+struct QualityThreshold {
+    int maxAbsDiff = 255;
+    double minPsnr = 0.0;
+    double minSsim = -1.0;
+};
+
+class ImageCompare {
+public:
+    // Reported for identical images (infinite PSNR)
+    static constexpr double PSNR_IDENTICAL = 99.0;
+
+    // Difference metrics and PSNR (SSIM left at 1.0)
+    static CompareResult difference(const Image& reference, const Image& test, int tolerance = 0);
+    // All metrics; SSIM is skipped when withSsim is false
+    static CompareResult compare(const Image& reference, const Image& test, bool withSsim = true);
+
+    static double psnr(const Image& reference, const Image& test) {
+        return difference(reference, test).psnr;
+    }
+    static double ssim(const Image& reference, const Image& test);
+
+    static bool meets(const CompareResult& result, const QualityThreshold& threshold) {
+        return result.maxAbsDiff <= threshold.maxAbsDiff &&
+               result.psnr >= threshold.minPsnr &&
+               result.ssim >= threshold.minSsim;
+    }
+};
+
+#endif
@@ -0,0 +1,337 @@
+/**
+ * @file ImageExpr.hpp
+ * @brief Lazy image expressions (expression templates) with fused evaluation
+ *
+ * This file defines a small expression-template layer on top of Image.
+ * Operations such as brightening, inverting or blending two images return
+ * lightweight expression nodes instead of materializing a temporary Image.
+ * The whole expression is evaluated once, on assignment to an Image, in a
+ * single fused loop (OpenMP parallel + SIMD).
+ *
+ * @details
+ * Usage:
+ * @code
+ *   using namespace imgexpr;
+ *   Image out = clamp(invert(brighten(lazy(photo), 1.2f)), 16.0f, 240.0f);
+ *   out = blend(lazy(photo), lazy(watermark), 0.25f);   // reuses out's buffer
+ * @endcode
+ *
+ * Semantics:
+ * - Nodes compute in float; intermediate values are NOT saturated
+ * - The final store clamps to [0, 255] and truncates (same as BrightnessFilter)
+ * - clamp() and lut() saturate explicitly where 8-bit steps are wanted
+ * - All image operands must share width, height and channel count
+ *   (std::invalid_argument otherwise)
+ *
+ * Memory:
+ * - Nodes hold pointers to the source pixels, not copies: source images
+ *   must outlive the expression
+ * - Assigning to an Image of the same shape writes into its buffer directly,
+ *   which is safe even when that Image is also an operand (point-wise only)
+ *
+ * @see Image.hpp for the assignment/constructor entry points
+ * @see BrightnessFilter, InvertFilter for the Filter-based equivalents
+ * @author Rowan HOUPA
+ * @date January 2026
+ */
+
+#ifndef IMAGE_EXPR_HPP
+#define IMAGE_EXPR_HPP
+
+#include "Image.hpp"
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace imgexpr {
+
+/**
+ * @class ImageExpr
+ * @brief CRTP base of every expression node.
+ *
+ * A node provides eval(i) for the flat index i (same layout as Image::data())
+ * and the shape of the image it produces.
+ */
+template<typename Derived>
+class ImageExpr {
+public:
+    const Derived& derived() const { return static_cast<const Derived&>(*this); }
+
+    float eval(size_t i) const { return derived().eval(i); }
+    int getWidth() const { return derived().getWidth(); }
+    int getHeight() const { return derived().getHeight(); }
+    int getChannels() const { return derived().getChannels(); }
+};
+
+// ==================== NODES ====================
+
+/// Leaf node reading an existing Image
+class ImageTerm : public ImageExpr<ImageTerm> {
+public:
+    explicit ImageTerm(const Image& image)
+        : pixels(image.data()), width(image.getWidth()),
+          height(image.getHeight()), channels(image.getChannels()) {}
+
+    float eval(size_t i) const { return static_cast<float>(pixels[i]); }
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    int getChannels() const { return channels; }
+
+private:
+    const uint8_t* pixels;
+    int width;
+    int height;
+    int channels;
+};
+
+/// Point-wise unary operation: Op(value)
+template<typename E, typename Op>
+class UnaryExpr : public ImageExpr<UnaryExpr<E, Op>> {
+public:
+    UnaryExpr(const E& operand, Op op) : operand(operand), op(op) {}
+
+    float eval(size_t i) const { return op(operand.eval(i)); }
+    int getWidth() const { return operand.getWidth(); }
+    int getHeight() const { return operand.getHeight(); }
+    int getChannels() const { return operand.getChannels(); }
+
+private:
+    E operand;
+    Op op;
+};
+
+/// Point-wise binary operation between two images of the same shape
+template<typename L, typename R, typename Op>
+class BinaryExpr : public ImageExpr<BinaryExpr<L, R, Op>> {
+public:
+    BinaryExpr(const L& lhs, const R& rhs, Op op) : lhs(lhs), rhs(rhs), op(op) {
+        if (lhs.getWidth() != rhs.getWidth() || lhs.getHeight() != rhs.getHeight() ||
+            lhs.getChannels() != rhs.getChannels()) {
+            throw std::invalid_argument("imgexpr: operand shapes do not match");
+        }
+    }
+
+    float eval(size_t i) const { return op(lhs.eval(i), rhs.eval(i)); }
+    int getWidth() const { return lhs.getWidth(); }
+    int getHeight() const { return lhs.getHeight(); }
+    int getChannels() const { return lhs.getChannels(); }
+
+private:
+    L lhs;
+    R rhs;
+    Op op;
+};
+
+/// Per-pixel blend driven by a mask expression: a + (b - a) * mask / 255
+template<typename A, typename B, typename M>
+class MaskBlendExpr : public ImageExpr<MaskBlendExpr<A, B, M>> {
+public:
+    MaskBlendExpr(const A& a, const B& b, const M& mask) : a(a), b(b), mask(mask) {
+        if (a.getWidth() != b.getWidth() || a.getHeight() != b.getHeight() ||
+            a.getChannels() != b.getChannels() ||
+            a.getWidth() != mask.getWidth() || a.getHeight() != mask.getHeight() ||
+            a.getChannels() != mask.getChannels()) {
+            throw std::invalid_argument("imgexpr: blend operand shapes do not match");
+        }
+    }
+
+    float eval(size_t i) const {
+        float va = a.eval(i);
+        return va + (b.eval(i) - va) * (mask.eval(i) * (1.0f / 255.0f));
+    }
+    int getWidth() const { return a.getWidth(); }
+    int getHeight() const { return a.getHeight(); }
+    int getChannels() const { return a.getChannels(); }
+
+private:
+    A a;
+    B b;
+    M mask;
+};
+
+/// Per-channel lookup table; the operand is saturated to [0, 255] first
+template<typename E>
+class LutExpr : public ImageExpr<LutExpr<E>> {
+public:
+    LutExpr(const E& operand, std::shared_ptr<const std::vector<uint8_t>> table, int tableChannels)
+        : operand(operand), table(std::move(table)), tableChannels(tableChannels) {
+        if (tableChannels != 1 && tableChannels != operand.getChannels()) {
+            throw std::invalid_argument("imgexpr: LUT channel count does not match image");
+        }
+        lut = this->table->data();
+    }
+
+    float eval(size_t i) const {
+        float v = std::clamp(operand.eval(i), 0.0f, 255.0f);
+        size_t c = (tableChannels == 1) ? 0 : i % static_cast<size_t>(tableChannels);
+        return static_cast<float>(lut[c * 256 + static_cast<uint8_t>(v)]);
+    }
+    int getWidth() const { return operand.getWidth(); }
+    int getHeight() const { return operand.getHeight(); }
+    int getChannels() const { return operand.getChannels(); }
+
+private:
+    E operand;
+    std::shared_ptr<const std::vector<uint8_t>> table; // Keeps the LUT alive
+    const uint8_t* lut = nullptr;
+    int tableChannels;
+};
+
+// ==================== FUNCTORS ====================
+
+struct AddOp { float operator()(float a, float b) const { return a + b; } };
+struct SubOp { float operator()(float a, float b) const { return a - b; } };
+struct MulOp { float operator()(float a, float b) const { return a * b; } };
+struct DivOp { float operator()(float a, float b) const { return b != 0.0f ? a / b : 0.0f; } };
+
+struct AddScalar { float k; float operator()(float v) const { return v + k; } };
+struct MulScalar { float k; float operator()(float v) const { return v * k; } };
+struct DivScalar { float k; float operator()(float v) const { return v / k; } };
+struct SubFromScalar { float k; float operator()(float v) const { return k - v; } };
+struct ClampOp { float lo, hi; float operator()(float v) const { return std::clamp(v, lo, hi); } };
+
+struct MixOp {
+    float alpha;
+    float operator()(float a, float b) const { return a + (b - a) * alpha; }
+};
+
+// ==================== BUILDERS ====================
+
+/// Wraps an Image as the leaf of an expression (no copy)
+inline ImageTerm lazy(const Image& image) { return ImageTerm(image); }
+
+template<typename L, typename R>
+BinaryExpr<L, R, AddOp> operator+(const ImageExpr<L>& lhs, const ImageExpr<R>& rhs) {
+    return {lhs.derived(), rhs.derived(), AddOp{}};
+}
+
+template<typename L, typename R>
+BinaryExpr<L, R, SubOp> operator-(const ImageExpr<L>& lhs, const ImageExpr<R>& rhs) {
+    return {lhs.derived(), rhs.derived(), SubOp{}};
+}
+
+template<typename L, typename R>
+BinaryExpr<L, R, MulOp> operator*(const ImageExpr<L>& lhs, const ImageExpr<R>& rhs) {
+    return {lhs.derived(), rhs.derived(), MulOp{}};
+}
+
+template<typename L, typename R>
+BinaryExpr<L, R, DivOp> operator/(const ImageExpr<L>& lhs, const ImageExpr<R>& rhs) {
+    return {lhs.derived(), rhs.derived(), DivOp{}};
+}
+
+template<typename E>
+UnaryExpr<E, AddScalar> operator+(const ImageExpr<E>& e, float k) { return {e.derived(), AddScalar{k}}; }
+
+template<typename E>
+UnaryExpr<E, AddScalar> operator+(float k, const ImageExpr<E>& e) { return {e.derived(), AddScalar{k}}; }
+
+template<typename E>
+UnaryExpr<E, AddScalar> operator-(const ImageExpr<E>& e, float k) { return {e.derived(), AddScalar{-k}}; }
+
+template<typename E>
+UnaryExpr<E, SubFromScalar> operator-(float k, const ImageExpr<E>& e) { return {e.derived(), SubFromScalar{k}}; }
+
+template<typename E>
+UnaryExpr<E, MulScalar> operator*(const ImageExpr<E>& e, float k) { return {e.derived(), MulScalar{k}}; }
+
+template<typename E>
+UnaryExpr<E, MulScalar> operator*(float k, const ImageExpr<E>& e) { return {e.derived(), MulScalar{k}}; }
+
+template<typename E>
+UnaryExpr<E, DivScalar> operator/(const ImageExpr<E>& e, float k) {
+    if (k == 0.0f) {
+        throw std::invalid_argument("imgexpr: division by zero");
+    }
+    return {e.derived(), DivScalar{k}};
+}
+
+/// 255 - value (same as InvertFilter)
+template<typename E>
+UnaryExpr<E, SubFromScalar> invert(const ImageExpr<E>& e) { return {e.derived(), SubFromScalar{255.0f}}; }
+
+/// value * factor (same as BrightnessFilter)
+template<typename E>
+UnaryExpr<E, MulScalar> brighten(const ImageExpr<E>& e, float factor) { return {e.derived(), MulScalar{factor}}; }
+
+/// Saturates intermediate values to [lo, hi]
+template<typename E>
+UnaryExpr<E, ClampOp> clamp(const ImageExpr<E>& e, float lo = 0.0f, float hi = 255.0f) {
+    return {e.derived(), ClampOp{lo, hi}};
+}
+
+/// Linear blend with a constant weight: a * (1 - alpha) + b * alpha
+template<typename A, typename B>
+BinaryExpr<A, B, MixOp> blend(const ImageExpr<A>& a, const ImageExpr<B>& b, float alpha) {
+    return {a.derived(), b.derived(), MixOp{alpha}};
+}
+
+/// Linear blend with a per-value weight (mask in [0, 255])
+template<typename A, typename B, typename M>
+MaskBlendExpr<A, B, M> blend(const ImageExpr<A>& a, const ImageExpr<B>& b, const ImageExpr<M>& mask) {
+    return {a.derived(), b.derived(), mask.derived()};
+}
+
+/// Same 256-entry table for every channel
+template<typename E>
+LutExpr<E> lut(const ImageExpr<E>& e, const std::array<uint8_t, 256>& table) {
+    auto data = std::make_shared<const std::vector<uint8_t>>(table.begin(), table.end());
+    return {e.derived(), std::move(data), 1};
+}
+
+/// One 256-entry table per channel (tables.size() must equal the channel count)
+template<typename E>
+LutExpr<E> lut(const ImageExpr<E>& e, const std::vector<std::array<uint8_t, 256>>& tables) {
+    auto data = std::make_shared<std::vector<uint8_t>>();
+    data->reserve(tables.size() * 256);
+    for (const auto& table : tables) {
+        data->insert(data->end(), table.begin(), table.end());
+    }
+    return {e.derived(), std::move(data), static_cast<int>(tables.size())};
+}
+
+// ==================== EVALUATION ====================
+
+/**
+ * @brief Evaluates an expression into target in one fused parallel loop.
+ *
+ * The target buffer is reused when its shape already matches; since every
+ * node is point-wise, the target may also appear as an operand.
+ */
+template<typename E>
+void evaluate(const ImageExpr<E>& expression, Image& target) {
+    const E& e = expression.derived();
+
+    if (target.getWidth() != e.getWidth() || target.getHeight() != e.getHeight() ||
+        target.getChannels() != e.getChannels()) {
+        target = Image(e.getWidth(), e.getHeight(), e.getChannels());
+    }
+
+    uint8_t* out = target.data();
+    const long long total = static_cast<long long>(target.size());
+
+    #pragma omp parallel for simd schedule(static)
+    for (long long i = 0; i < total; ++i) {
+        float v = std::clamp(e.eval(static_cast<size_t>(i)), 0.0f, 255.0f);
+        out[i] = static_cast<uint8_t>(v);
+    }
+}
+
+} // namespace imgexpr
+
+// ==================== IMAGE ENTRY POINTS ====================
+
+template<typename E>
+Image::Image(const imgexpr::ImageExpr<E>& expression) {
+    imgexpr::evaluate(expression, *this);
+}
+
+template<typename E>
+Image& Image::operator=(const imgexpr::ImageExpr<E>& expression) {
+    imgexpr::evaluate(expression, *this);
+    return *this;
+}
+
+#endif
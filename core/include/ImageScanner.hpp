@@ -0,0 +1,113 @@
+/**
+ * @file ImageScanner.hpp
+ * @brief Parallel recursive search for images, with a persistent scan index
+ *
+ * Planning a batch over an archive of millions of files in nested folders
+ * used to mean listing every folder, one after the other, at every run.
+ * ImageScanner walks the tree on several threads and keeps an index of
+ * what it found (per folder: its modification time, its subfolders and its
+ * images with size, modification time, dimensions and content hash). The
+ * next scan reuses it:
+ * - A folder whose modification time is unchanged is not listed again:
+ *   its subfolders and images come from the index (adding, removing or
+ *   renaming an entry changes the folder's time, so this catches them)
+ * - In a folder that changed, only new images, or images whose size or
+ *   time changed, are read again to probe their dimensions and hash them
+ *
+ * Rewriting an image in place (whatever its new size) does not change its
+ * folder's time, so it goes unnoticed in an unchanged folder;
+ * setVerifyFiles(true) lists every folder and stats every image (still
+ * without reading unchanged ones).
+ *
+ * Index file: "IFSX", version, folder count, then per folder its path
+ * relative to the root, time, subfolder names and image records; integers
+ * little endian. By default it is kept outside the tree, in
+ * $XDG_CACHE_HOME/imageflow (or ~/.cache/imageflow), named after a hash of
+ * the root's absolute path: an index saved inside the tree would change
+ * its folder's time at every scan, and that folder would never be reused.
+ *
+ * @details
+ * - Traversal: a queue of folders shared by the threads; each thread takes
+ *   a folder, lists it (or takes it from the index) and queues its
+ *   subfolders. Many threads help on NFS, where each listing waits on
+ *   the server
+ * - Probing runs after the traversal, on the OpenMP threads, over the
+ *   images of all folders at once (a single folder of 100 000 new images
+ *   is then split like any other work)
+ * - Symbolic links to folders are not followed (no cycles)
+ * - The content hash is a fast 64-bit hash of the file bytes, to spot
+ *   identical copies; it is not cryptographic
+ *
+ * @author Rowan HOUPA
+ * @date January 2026
+ */
+
+#ifndef IMAGE_SCANNER_HPP
+#define IMAGE_SCANNER_HPP
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct ScannedImage {
+    std::string path;               // Under the scanned root
+    uint64_t size = 0;
+    int64_t modified = 0;           // File time ticks
+    int width = 0;                  // 0: not decodable
+    int height = 0;
+    int channels = 0;
+    uint64_t contentHash = 0;       // 0: not hashed
+};
+
+class ImageScanner {
+public:
+    struct Stats {
+        size_t directories = 0;
+        size_t directoriesListed = 0;   // The others came from the index
+        size_t images = 0;
+        size_t imagesProbed = 0;        // The others came from the index
+        uint64_t bytesRead = 0;
+        double ms = 0.0;
+    };
+
+    // Scans root; the index is read from and saved to indexPath
+    // ("" = per-root file in the user's cache folder)
+    explicit ImageScanner(std::string root, std::string indexPath = "");
+
+    // Traversal threads (0 = 2 per hardware thread, at least 4)
+    void setThreads(int threads) { this->threads = threads; }
+    // Read whole files to hash them (default); otherwise only probe headers
+    void setHashContents(bool hash) { hashContents = hash; }
+    // List every folder and stat every image, even in unchanged folders
+    void setVerifyFiles(bool verify) { verifyFiles = verify; }
+
+    // All images under root, sorted by path; saves the updated index
+    std::vector<ScannedImage> scan();
+
+    const Stats& getStats() const { return stats; }
+    const std::string& getIndexPath() const { return indexPath; }
+
+    // Extension is one of the formats Image loads (case-insensitive)
+    static bool isImagePath(const std::string& path);
+
+private:
+    struct Directory {
+        int64_t modified = 0;
+        std::vector<std::string> subdirectories;
+        std::vector<ScannedImage> images;       // path holds the file name
+    };
+
+    bool loadIndex();
+    bool saveIndex() const;
+
+    std::string root;
+    std::string indexPath;
+    int threads = 0;
+    bool hashContents = true;
+    bool verifyFiles = false;
+    std::unordered_map<std::string, Directory> index;   // By path relative to root ("" = root)
+    Stats stats;
+};
+
+#endif
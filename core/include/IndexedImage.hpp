@@ -0,0 +1,73 @@
+/**
+ * @file IndexedImage.hpp
+ * @brief Palettized image: up to 256 RGBA colors and one 8-bit index per pixel
+ *
+ * Produced by QuantizeFilter::quantize() (or exactly by fromImage() when the
+ * image already has few colors) and written as an indexed PNG, typically
+ * 3-4x smaller than the RGB PNG of the same picture.
+ *
+ * Memory Layout: indices in row-major order, one byte per pixel; the
+ * palette holds RGBA entries (alpha 255 = opaque).
+ *
+ * @details
+ * - saveToFile(): ".png" is written natively as an indexed PNG (color type
+ *   3, bit depth 1/2/4/8 from the palette size, tRNS chunk when an entry is
+ *   not opaque); other formats go through toImage() and Image::saveToFile()
+ * - PNG rows use filter type 0 (recommended for palette images) and are
+ *   deflated with the stb_image_write compressor
+ *
+ * @see QuantizeFilter for the palette construction
+ * @author Rowan HOUPA
+ * @date January 2026
+ */
+
+#ifndef INDEXED_IMAGE_HPP
+#define INDEXED_IMAGE_HPP
+
+#include "Image.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct PaletteColor {
+    uint8_t r = 0, g = 0, b = 0;
+    uint8_t a = 255;
+};
+
+class IndexedImage {
+public:
+    IndexedImage() = default;
+    IndexedImage(int width, int height);
+
+    // Exact conversion of a 1-4 channel image; returns an empty image when
+    // it has more than maxColors distinct colors
+    static IndexedImage fromImage(const Image& image, int maxColors = 256);
+    // Expands the palette: 1 = gray (red entry), 2 = gray + alpha, 3 = RGB, 4 = RGBA
+    Image toImage(int channels = 3) const;
+
+    bool saveToFile(const std::string& filepath) const;
+
+    int getWidth() const { return m_width; }
+    int getHeight() const { return m_height; }
+    size_t size() const { return m_indices.size(); }
+    bool empty() const { return m_indices.empty(); }
+
+    uint8_t* data() { return m_indices.data(); }
+    const uint8_t* data() const { return m_indices.data(); }
+    uint8_t* row(int y) { return m_indices.data() + static_cast<size_t>(y) * m_width; }
+    const uint8_t* row(int y) const { return m_indices.data() + static_cast<size_t>(y) * m_width; }
+
+    std::vector<PaletteColor>& palette() { return m_palette; }
+    const std::vector<PaletteColor>& palette() const { return m_palette; }
+
+    // Smallest PNG bit depth (1, 2, 4 or 8) able to address the palette
+    int getBitDepth() const;
+
+private:
+    int m_width = 0;
+    int m_height = 0;
+    std::vector<PaletteColor> m_palette;
+    std::vector<uint8_t> m_indices;
+};
+
+#endif
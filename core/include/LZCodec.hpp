@@ -0,0 +1,43 @@
+/**
+ * @file LZCodec.hpp
+ * @brief Fast LZ77 byte compression (LZ4-style sequences) for in-memory buffers
+ *
+ * Meant for data kept in RAM and decoded again soon (undo snapshots), where
+ * encode/decode speed matters more than ratio. No entropy coding.
+ *
+ * Stream: the input is cut into independent 1 MiB blocks, each stored as
+ * its compressed size (uint32, little endian) followed by its sequences:
+ * - token: literal count (high nibble) and match length - 4 (low nibble),
+ *   15 meaning "continued by bytes added until one is < 255"
+ * - the literals, then the match offset (uint16, 1 to 65535 bytes back)
+ * - the last sequence of a block has literals only
+ *
+ * @details
+ * - Greedy parser with a 2^16 entry hash table of 4-byte sequences; runs of
+ *   unmatched bytes are skipped faster the longer they get, so incompressible
+ *   data costs little (and grows by at most ~0.5 %)
+ * - Blocks are compressed and decompressed in parallel (OpenMP)
+ * - decompress() checks every length and offset against the buffers and
+ *   returns false on corrupt or truncated input
+ *
+ * @author Rowan HOUPA
+ * @date January 2026
+ */
+
+#ifndef LZ_CODEC_HPP
+#define LZ_CODEC_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class LZCodec {
+public:
+    static std::vector<uint8_t> compress(const uint8_t* data, size_t size);
+    // output must hold exactly the original size
+    static bool decompress(const std::vector<uint8_t>& packed, uint8_t* output, size_t size);
+
+    static constexpr size_t BLOCK_SIZE = size_t(1) << 20;
+};
+
+#endif
@@ -0,0 +1,82 @@
+/**
+ * @file PerceptualHash.hpp
+ * @brief 64-bit perceptual hashes (dHash, pHash) and a BK-tree for near-duplicate search
+ *
+ * Perceptual hashes stay (almost) identical when a photo is recompressed,
+ * resized or slightly retouched, so the Hamming distance between two hashes
+ * measures how similar the pictures look. The batch mode uses them to skip
+ * or alias near-duplicates before running the pipeline.
+ * - dHash: 9x8 luma thumbnail, one bit per horizontal neighbour comparison
+ *   (cheapest, sensitive to gradients)
+ * - pHash: 32x32 luma thumbnail, 8x8 lowest DCT-II frequencies compared to
+ *   their median (robust to contrast and gamma changes)
+ *
+ * BKTree: metric tree over Hamming distance. A query with radius r only
+ * visits children whose edge distance lies in [d - r, d + r] (triangle
+ * inequality), so lookups stay far below a linear scan for small radii.
+ *
+ * @details
+ * - Thumbnails are area averages of the full image (every pixel counts,
+ *   no aliasing); OpenMP over thumbnail rows, one pass over the pixels
+ * - Luma: (77 R + 150 G + 29 B + 128) >> 8, as in ThresholdFilter
+ * - The DCT only evaluates the 8x8 coefficients that are kept
+ *
+ * @author Rowan HOUPA
+ * @date January 2026
+ */
+
+#ifndef PERCEPTUAL_HASH_HPP
+#define PERCEPTUAL_HASH_HPP
+
+#include "Image.hpp"
+#include <bit>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+enum class HashMethod { Difference, DCT };
+
+class PerceptualHash {
+public:
+    static uint64_t dHash(const Image& image);
+    static uint64_t pHash(const Image& image);
+    static uint64_t compute(const Image& image, HashMethod method = HashMethod::DCT) {
+        return method == HashMethod::DCT ? pHash(image) : dHash(image);
+    }
+
+    // Number of differing bits (0 = same picture, 64 = opposite)
+    static int distance(uint64_t a, uint64_t b) {
+        return std::popcount(a ^ b);
+    }
+
+    // Area-averaged luma thumbnail, row-major (width × height floats)
+    static std::vector<float> lumaThumbnail(const Image& image, int width, int height);
+};
+
+class BKTree {
+public:
+    void insert(uint64_t hash, size_t id);
+
+    // Closest entry within maxDistance (ties: lowest id); false if none
+    bool findNearest(uint64_t hash, int maxDistance, size_t& id, int& distance) const;
+    // Every entry within maxDistance as (id, distance)
+    std::vector<std::pair<size_t, int>> findWithin(uint64_t hash, int maxDistance) const;
+
+    size_t size() const { return nodes.size(); }
+    bool empty() const { return nodes.empty(); }
+    void clear() { nodes.clear(); }
+
+private:
+    struct Node {
+        uint64_t hash;
+        size_t id;
+        std::vector<std::pair<int, uint32_t>> children; // (edge distance, node index)
+    };
+
+    template<typename Visit>
+    void search(uint64_t hash, int maxDistance, Visit&& visit) const;
+
+    std::vector<Node> nodes;
+};
+
+#endif
@@ -0,0 +1,72 @@
+/**
+ * @file PipelineProfile.hpp
+ * @brief Per-filter timing and device statistics collected while a pipeline runs
+ *
+ * A FilterPipeline with a profile (setProfile) times every step it runs and
+ * reports it here, with the filter's name and the device that call ran on
+ * (Filter::takeReportedDevice, read on the thread that ran it). Copies of the pipeline share the profile, so the
+ * preview tiles filtered on background threads, the full-resolution Apply
+ * and any other copy all add to the same figures.
+ *
+ * Tiles and full images mix: time is also kept per megapixel processed,
+ * the figure that compares filters whatever the size they ran on.
+ *
+ * @details
+ * - Thread-safe; the lock only guards a few additions, and getStats()
+ *   copies them out, so a reader never waits for a filter
+ * - Entries are by pipeline position; a different filter name at a
+ *   position (the pipeline was edited) restarts that entry
+ *
+ * @see FilterPipeline::setProfile
+ * @author Rowan HOUPA
+ * @date January 2026
+ */
+
+#ifndef PIPELINE_PROFILE_HPP
+#define PIPELINE_PROFILE_HPP
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class PipelineProfile {
+public:
+    struct FilterStats {
+        std::string name;
+        std::string device;         // Of the last call
+        size_t calls = 0;
+        double totalMs = 0.0;
+        double lastMs = 0.0;
+        uint64_t pixels = 0;
+
+        double msPerMegapixel() const { return pixels ? totalMs * 1e6 / pixels : 0.0; }
+    };
+
+    struct Stats {
+        std::vector<FilterStats> filters;   // By pipeline position
+        size_t runs = 0;
+        double totalMs = 0.0;
+        uint64_t pixels = 0;
+        double lastRunMs = 0.0;
+        uint64_t lastRunPixels = 0;
+
+        double msPerMegapixel() const { return pixels ? totalMs * 1e6 / pixels : 0.0; }
+    };
+
+    // Step index of the pipeline (filter name) ran on device, took ms and
+    // produced pixels output pixels
+    void recordFilter(size_t index, std::string name, std::string device, double ms, uint64_t pixels);
+    // One pipeline run of a filterCount-filter pipeline (entries past it
+    // belong to removed filters and are dropped)
+    void recordRun(double ms, uint64_t pixels, size_t filterCount);
+
+    Stats getStats() const;
+    void reset();
+
+private:
+    mutable std::mutex mutex;
+    Stats stats;
+};
+
+#endif
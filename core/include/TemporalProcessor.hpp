@@ -0,0 +1,97 @@
+/**
+ * @file TemporalProcessor.hpp
+ * @brief Temporal mode for frame sequences: optional denoising and tile reuse
+ *
+ * Consecutive video frames are mostly identical, so filtering each one from
+ * scratch repeats most of the work. TemporalProcessor::process() runs a
+ * pipeline on a sequence of same-sized frames and only recomputes what
+ * changed:
+ * 1. Optional recursive temporal denoising (TemporalDenoiseFilter) of the
+ *    whole frame; besides cleaning the output it keeps sensor noise from
+ *    marking static tiles as changed
+ * 2. Change detection: the frame is cut into tiles; a tile is dirty when
+ *    its largest per-value difference from the input its cached output was
+ *    computed from exceeds the threshold
+ * 3. Dirty tiles are widened by the pipeline halo (a blur near a changed
+ *    tile changes too), merged into horizontal runs, and each run is
+ *    filtered on a crop with halo margins; every other tile keeps the
+ *    previous output
+ *
+ * Tile reuse needs a pipeline whose filters all report a halo radius
+ * (Filter::getHaloRadius()) and keep the image size; otherwise every frame
+ * is processed in full (only the denoising step remains temporal).
+ *
+ * @details
+ * - Comparing against the input a tile was last computed from (not the
+ *   previous frame) bounds the drift: slow changes accumulate until they
+ *   cross the threshold
+ * - Crops with a full halo give the same pixels as whole-frame filtering,
+ *   up to the change threshold in the halo of skipped tiles
+ * - Change detection: OpenMP over tiles, `omp simd` max reduction per row
+ *
+ * @see FrameStream for the streaming loop
+ * @author Rowan HOUPA
+ * @date January 2026
+ */
+
+#ifndef TEMPORAL_PROCESSOR_HPP
+#define TEMPORAL_PROCESSOR_HPP
+
+#include "FilterPipeline.hpp"
+#include "Image.hpp"
+#include "filters/TemporalDenoiseFilter.hpp"
+#include <cstdint>
+#include <vector>
+
+struct TemporalOptions {
+    int tileSize = 64;
+    int changeThreshold = 4;        // Largest |Δ| per value still treated as unchanged
+    float denoiseStrength = 0.0f;   // History weight of the temporal denoiser (0 = off)
+    int motionThreshold = 24;       // Denoiser history reset threshold
+};
+
+struct TemporalStats {
+    size_t frames = 0;
+    size_t tiles = 0;               // Tiles seen over all frames
+    size_t tilesSkipped = 0;        // Tiles whose previous output was reused
+
+    double skippedFraction() const {
+        return tiles > 0 ? static_cast<double>(tilesSkipped) / tiles : 0.0;
+    }
+};
+
+class TemporalProcessor {
+public:
+    explicit TemporalProcessor(const FilterPipeline& pipeline, const TemporalOptions& options = {});
+
+    // Filters the next frame of the sequence
+    Image process(Image&& frame);
+    Image process(const Image& frame) { return process(Image(frame)); }
+
+    // Forgets the previous frames (next frame is processed in full)
+    void reset();
+
+    const TemporalStats& getStats() const { return stats; }
+    const TemporalOptions& getOptions() const { return options; }
+    // False when the pipeline cannot run on tiles
+    bool isTileReuseEnabled() const { return halo >= 0; }
+
+private:
+    Image processFull(Image&& frame);
+    void markDirtyTiles(const Image& frame);
+    void processRun(const Image& frame, int tileY, int firstTile, int lastTile);
+
+    FilterPipeline pipeline;
+    TemporalOptions options;
+    TemporalDenoiseFilter denoiser;
+    int halo;
+    int tilesX = 0;
+    int tilesY = 0;
+    Image reference;                // Input each cached tile was computed from
+    Image output;                   // Previous output
+    std::vector<uint8_t> dirty;     // Per tile: changed since last computed
+    std::vector<uint8_t> recompute; // Per tile: dirty tiles widened by the halo
+    TemporalStats stats;
+};
+
+#endif
@@ -0,0 +1,61 @@
+/**
+ * @file ThumbnailCache.hpp
+ * @brief On-disk cache of reduced images for browsing folders
+ *
+ * Decoding a 24 MP JPEG to show it at 160 pixels costs far more than
+ * reading back a 160-pixel copy, and a folder is browsed again and again.
+ * Each thumbnail is stored in its own file of the cache directory, named
+ * after a hash of the image's absolute path, its file size, its
+ * modification time and the thumbnail size: an edited image gets a new
+ * entry, the stale one is simply never read again.
+ *
+ * Entry: "IFTN", version, width, height, channels (uint32, little endian),
+ * then the pixels compressed with LZCodec.
+ *
+ * @details
+ * - load()/store() are thread-safe: entries are written to a temporary
+ *   file then renamed, so concurrent readers never see half an entry
+ * - Decoding the image is left to the caller (the GUI decodes JPEG at a
+ *   reduced size directly); makeThumbnail() is the generic fallback
+ * - prune() bounds the directory size, oldest entries first
+ *
+ * @see ContactSheet::thumbnail for the downscale
+ * @author Rowan HOUPA
+ * @date January 2026
+ */
+
+#ifndef THUMBNAIL_CACHE_HPP
+#define THUMBNAIL_CACHE_HPP
+
+#include "Image.hpp"
+#include <string>
+
+class ThumbnailCache {
+public:
+    explicit ThumbnailCache(std::string directory, int thumbnailSize = 160);
+
+    // Cached thumbnail of the image file at path, if it is still up to date
+    bool load(const std::string& path, Image& thumbnail) const;
+    bool store(const std::string& path, const Image& thumbnail) const;
+
+    // Decodes path and fits it in thumbnailSize² (never upscales)
+    Image makeThumbnail(const std::string& path) const;
+    // load(), or makeThumbnail() then store(); empty Image on decode failure
+    Image get(const std::string& path) const;
+
+    // Removes the least recently written entries until the directory holds
+    // at most maxBytes; returns the number removed
+    size_t prune(size_t maxBytes) const;
+
+    const std::string& getDirectory() const { return directory; }
+    int getThumbnailSize() const { return thumbnailSize; }
+
+private:
+    // Entry file for path, empty when path does not exist
+    std::string entryPath(const std::string& path) const;
+
+    std::string directory;
+    int thumbnailSize;
+};
+
+#endif
@@ -0,0 +1,139 @@
+/**
+ * @file TileCache.hpp
+ * @brief Multi-resolution cache of pipeline output tiles for zoomable viewports
+ *
+ * A viewport only shows part of an image, at some zoom. Rather than filter
+ * the whole picture on every parameter change, the viewer asks the cache for
+ * the tiles it can see, at the pyramid level matching its zoom:
+ * - Level L is the source downscaled by 2^L (2x2 box average per step);
+ *   a viewer at zoom z uses the largest L with 2^L <= 1 / z
+ * - Tile (tx, ty) of level L covers level pixels [tx T, (tx + 1) T) ×
+ *   [ty T, (ty + 1) T), clipped to the level size
+ * - A missing tile is computed with FilterPipeline::applyRegion() on the
+ *   level image (tile plus the pipeline halo), then kept; panning back over
+ *   it costs nothing
+ * - Pipelines containing a whole-image filter (halo -1) are run once on the
+ *   full-resolution source and the result is downscaled into the levels,
+ *   so positions (overlays, warps) stay correct
+ *
+ * setPipeline() takes a copy of the pipeline and drops every tile (the
+ * generation counter changes); the pyramid is kept until setSource().
+ * shareSource() and adoptTiles() let side caches (speculative previews of
+ * other parameter values) reuse the pyramid and hand their tiles over.
+ *
+ * @details
+ * - Tiles are shared_ptr<const Image>: a caller may keep drawing a tile
+ *   after it has been evicted
+ * - LRU eviction once the tiles exceed the byte budget (pyramid excluded)
+ * - Thread-safe: the cache state is guarded by a mutex, tiles are computed
+ *   outside it; a tile finished for an older generation is discarded.
+ *   Threads computing at the same time each run their own copy of the
+ *   pipeline, since filters keep per-call state
+ * - The full-resolution run of a whole-image pipeline happens once per
+ *   generation, however many threads miss at the same time
+ * - Neighbourhood filters at L > 0 see radii in level pixels, so zoomed-out
+ *   previews of blurs look stronger than the final result; full resolution
+ *   (L = 0) is exact
+ *
+ * @see FilterPipeline::applyRegion for the halo handling
+ * @author Rowan HOUPA
+ * @date January 2026
+ */
+
+#ifndef TILE_CACHE_HPP
+#define TILE_CACHE_HPP
+
+#include "FilterPipeline.hpp"
+#include "Image.hpp"
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+struct TileIndex {
+    int level;
+    int tx;
+    int ty;
+};
+
+class TileCache {
+public:
+    explicit TileCache(int tileSize = 256, size_t maxBytes = size_t(256) << 20);
+
+    // New image: drops the pyramid and every tile
+    void setSource(std::shared_ptr<const Image> source);
+    // New pipeline (copied): drops every tile, keeps the pyramid
+    void setPipeline(const FilterPipeline& pipeline);
+    void clear();
+    // Same source and already built pyramid levels as other (no pixels copied)
+    void shareSource(const TileCache& other);
+    // Takes other's tiles as results of the current pipeline; the caller
+    // guarantees both pipelines are equal. Returns the number adopted.
+    size_t adoptTiles(const TileCache& other);
+
+    bool hasSource() const;
+    int getTileSize() const { return tileSize; }
+    uint64_t getGeneration() const;
+
+    // Levels down to one tile; 0 without a source
+    int getLevelCount() const;
+    int getLevelWidth(int level) const;
+    int getLevelHeight(int level) const;
+    // Pyramid level for a zoom factor (screen pixels per source pixel)
+    static int levelForZoom(double zoom);
+
+    // Processed tile, computed on a miss (throws what the pipeline throws).
+    // With runFullImage false, a whole-image pipeline whose full-resolution
+    // result is not built yet returns nullptr rather than running it (UI
+    // thread: leave that run to a background thread)
+    std::shared_ptr<const Image> tile(int level, int tx, int ty, bool runFullImage = true);
+    // Unfiltered tile of the source pyramid (not cached)
+    std::shared_ptr<const Image> sourceTile(int level, int tx, int ty);
+    // Processed tile if cached, nullptr otherwise
+    std::shared_ptr<const Image> find(int level, int tx, int ty) const;
+
+    struct Stats {
+        size_t hits = 0;
+        size_t misses = 0;
+        size_t tiles = 0;
+        size_t bytes = 0;
+    };
+    Stats getStats() const;
+
+    // 2x2 box-average downscale to ((w + 1) / 2) × ((h + 1) / 2)
+    static Image halve(const Image& image);
+
+private:
+    struct Entry {
+        std::shared_ptr<const Image> image;
+        std::list<uint64_t>::iterator position;
+    };
+
+    static uint64_t key(int level, int tx, int ty) {
+        return (static_cast<uint64_t>(level) << 56) | (static_cast<uint64_t>(tx) << 28) |
+               static_cast<uint64_t>(ty);
+    }
+    std::shared_ptr<const Image> levelLocked(int level);
+    // Level of the whole-image pipeline output, built at most once per generation
+    std::shared_ptr<const Image> processedChain(int level, uint64_t chainGeneration, const Image& fullImage,
+                                                FilterPipeline& instance);
+    void insertLocked(uint64_t tileKey, std::shared_ptr<const Image> image);
+
+    int tileSize;
+    size_t maxBytes;
+    std::shared_ptr<const Image> source;
+    std::shared_ptr<const FilterPipeline> pipeline;                 // Template, never run
+    std::vector<std::unique_ptr<FilterPipeline>> idlePipelines;     // Copies free to compute with
+    std::vector<std::shared_ptr<const Image>> levels;               // Source pyramid, built lazily
+    std::vector<std::shared_ptr<const Image>> processed;            // Whole-image pipelines only
+    std::unordered_map<uint64_t, Entry> tiles;
+    std::list<uint64_t> recent;                                     // Most recently used first
+    uint64_t generation = 0;
+    Stats stats;
+    mutable std::mutex mutex;
+    std::mutex chainMutex;                                          // Serializes building processed
+};
+
+#endif
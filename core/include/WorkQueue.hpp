@@ -0,0 +1,147 @@
+/**
+ * @file WorkQueue.hpp
+ * @brief Batch work shared by several processes through a directory
+ *
+ * Several imageflow_cli processes, on one machine or on several machines
+ * mounting the same filesystem (local disk, NFS), split a batch without any
+ * service: the queue is a directory and every state change is a rename,
+ * which the filesystem performs atomically.
+ *
+ * Layout of the queue directory:
+ * - manifest.txt: the inputs, one per line, as given to create()
+ * - pending/<item>: one file per item left to do, holding its input path
+ * - claimed/<item>@<worker>: claimed by a worker. Claiming renames
+ *   pending/<item> there, then appends a line to it so its modification
+ *   time is the claim time; when two workers race for an item, exactly one
+ *   rename succeeds and the other moves on to the next item
+ * - done/<item>, failed/<item>: finished items, with who did them and how long
+ * - workers/<worker>.stats: throughput of each worker, rewritten with
+ *   every heartbeat (report() adds them up)
+ *
+ * @details
+ * - Heartbeat: a background thread appends a line to the worker's claims
+ *   (their modification time is then the file server's clock) and rewrites
+ *   its stats. A claim not touched for the stale timeout belongs to a dead
+ *   or stuck worker; requeueStale() renames it back to pending/. Its age is
+ *   measured against a file written just before, so the machines' clocks
+ *   never need to agree
+ * - A worker whose claim was requeued while it still ran loses it:
+ *   complete() returns false and the item counts as lost for it. The item
+ *   may then be done twice at once, so callers write each output under a
+ *   name of their own and rename it onto the final name (the CLI writes
+ *   <output>.<worker>.tmp.<ext>): the last rename wins, whole
+ * - create() is idempotent across racing processes: the first one to make
+ *   the directory init.lock lists the inputs, fills pending.tmp/, then
+ *   renames it to pending/; the others neither list nor write anything and
+ *   wait for pending/ to appear
+ * - Each worker lists pending/ once, starts at a position derived from its
+ *   id and relists only when its list is used up, so workers rarely race
+ *   for the same item and claiming costs one rename
+ *
+ * @author Rowan HOUPA
+ * @date January 2026
+ */
+
+#ifndef WORK_QUEUE_HPP
+#define WORK_QUEUE_HPP
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+class WorkQueue {
+public:
+    struct Item {
+        std::string id;             // Zero-padded manifest position
+        std::string path;           // Input file
+    };
+
+    struct WorkerStats {
+        std::string worker;
+        size_t done = 0;
+        size_t failed = 0;
+        size_t lost = 0;            // Requeued by others while being processed
+        uint64_t pixels = 0;
+        double busyMs = 0.0;        // Between claim and completion
+        double firstClaim = 0.0;    // Seconds since the epoch (worker's clock)
+        double lastUpdate = 0.0;
+
+        double elapsedSeconds() const { return lastUpdate > firstClaim ? lastUpdate - firstClaim : 0.0; }
+        double itemsPerSecond() const;
+        double megapixelsPerSecond() const;
+    };
+
+    struct Report {
+        size_t pending = 0;
+        size_t claimed = 0;
+        size_t done = 0;
+        size_t failed = 0;
+        std::vector<WorkerStats> workers;   // Sorted by id
+        WorkerStats total;                  // Sums; elapsed from first claim to last update of any worker
+    };
+
+    // Queue in directory worked by workerId (letters, digits, '-', '_', '.';
+    // anything else is replaced by '_')
+    WorkQueue(std::string directory, std::string workerId);
+    ~WorkQueue();
+
+    WorkQueue(const WorkQueue&) = delete;
+    WorkQueue& operator=(const WorkQueue&) = delete;
+
+    // Enqueues the inputs listInputs() returns unless the queue already has
+    // items; returns true when this call created them. Only the process
+    // that wins init.lock calls listInputs() (a scan of the input tree is
+    // done once); the others wait up to waitSeconds for its queue
+    bool create(const std::function<std::vector<std::string>()>& listInputs, double waitSeconds = 60.0);
+    bool exists() const;
+
+    // Claims a pending item; false when none is left
+    bool claim(Item& item);
+    // Moves the claim to done/ or failed/; false when it was requeued meanwhile
+    bool complete(const Item& item, bool success, double ms, uint64_t pixels);
+    // Renames claims older than timeoutSeconds back to pending/
+    size_t requeueStale(double timeoutSeconds);
+    // No item pending nor claimed
+    bool isFinished() const;
+
+    // Heartbeat every intervalSeconds; also requeues claims older than
+    // staleSeconds (0: never)
+    void startHeartbeat(double intervalSeconds, double staleSeconds);
+    void stopHeartbeat();
+
+    WorkerStats getStats() const;
+    const std::string& getWorkerId() const { return workerId; }
+
+    // Item counts and per-worker throughput of the queue in directory
+    static Report report(const std::string& directory);
+
+private:
+    void heartbeat();
+    void writeStats() const;
+
+    std::string directory;
+    std::string workerId;
+
+    // Listing of pending/, consumed from the back (requeued items are seen
+    // at the next listing)
+    std::vector<std::string> candidates;
+
+    mutable std::mutex mutex;               // Guards claims and stats
+    std::set<std::string> claims;           // Claim file names held by this worker
+    WorkerStats stats;
+    std::mutex requeueMutex;                // Serializes requeueStale() (one clock probe file)
+
+    std::thread heartbeatThread;
+    std::mutex heartbeatMutex;
+    std::condition_variable heartbeatWake;
+    bool heartbeatStop = false;
+    double heartbeatInterval = 10.0;
+    double staleTimeout = 0.0;
+};
+
+#endif
@@ -0,0 +1,150 @@
+/**
+ * @file BlendFilter.hpp
+ * @brief Alpha compositing and blend modes with a second image (watermarks)
+ *
+ * Composites an overlay image (logo, watermark, texture) on top of the input
+ * using the Porter-Duff "over" operator or one of the common separable blend
+ * modes (multiply, screen, overlay), following the W3C compositing formulas.
+ *
+ * @details
+ * - Math: 8-bit premultiplied alpha, every product divided by 255 with the
+ *   exact rounding trick div255(x) = (x + 128 + ((x + 128) >> 8)) >> 8
+ * - Parallelization: OpenMP over rows, `omp simd` over each row's values
+ * - Placement: overlay top-left corner at (offsetX, offsetY); pixels outside
+ *   the overlay are left untouched
+ * - Alpha: taken from the overlay's last channel (2 or 4 channels), scaled
+ *   by the filter opacity; the input's own alpha (4 channels) is honoured
+ * - Runs in place (apply() copies the input then calls applyInPlace())
+ * - Overlays are shared between clones; loadOverlayCached() decodes a file
+ *   once per process so batch runs never decode the watermark twice
+ *
+ * @see BlendFilterGPU for the SYCL implementation
+ * @see Filter.hpp for the base class interface
+ * @author Rowan HOUPA
+ * @date January 2026
+ */
+
+#ifndef BLEND_FILTER_HPP
+#define BLEND_FILTER_HPP
+
+#include "../Filter.hpp"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <chrono>
+
+enum class BlendMode { Over, Multiply, Screen, Overlay };
+
+/**
+ * @brief Per-value blend arithmetic shared by the CPU and SYCL kernels.
+ *
+ * Plain inline functions without library calls so they can run in device code.
+ */
+namespace blendmath {
+
+// Exact round(x / 255) for x in [0, 65535]
+inline uint32_t div255(uint32_t x) {
+    x += 128;
+    return (x + (x >> 8)) >> 8;
+}
+
+// Separable blend function B(backdrop, source) on straight 8-bit colors
+inline uint32_t blendColor(BlendMode mode, uint32_t backdrop, uint32_t source) {
+    switch (mode) {
+        case BlendMode::Multiply:
+            return div255(backdrop * source);
+        case BlendMode::Screen:
+            return backdrop + source - div255(backdrop * source);
+        case BlendMode::Overlay:
+            return backdrop < 128
+                ? div255(2 * backdrop * source)
+                : 255 - div255(2 * (255 - backdrop) * (255 - source));
+        case BlendMode::Over:
+        default:
+            return source;
+    }
+}
+
+/**
+ * Composites one premultiplied color value.
+ * @param sp source color premultiplied by sa   @param sa source alpha
+ * @param dp backdrop color premultiplied by da @param da backdrop alpha
+ * @param d  straight backdrop color            @param s  straight source color
+ * @return premultiplied result color (alpha is sa + da - sa*da)
+ */
+inline uint32_t compositePremultiplied(BlendMode mode, uint32_t sp, uint32_t sa,
+                                       uint32_t dp, uint32_t da, uint32_t d, uint32_t s) {
+    uint32_t result = div255(dp * (255 - sa));
+    if (mode == BlendMode::Over) {
+        result += sp;
+    } else {
+        result += div255(sp * (255 - da)) + div255(div255(sa * da) * blendColor(mode, d, s));
+    }
+    return result > 255 ? 255 : result;
+}
+
+// Premultiplied color back to straight color for a given result alpha
+inline uint32_t unpremultiply(uint32_t premultiplied, uint32_t alpha) {
+    if (alpha == 0) return 0;
+    uint32_t value = (premultiplied * 255 + alpha / 2) / alpha;
+    return value > 255 ? 255 : value;
+}
+
+} // namespace blendmath
+
+class BlendFilter : public Filter {
+public:
+    BlendFilter(std::shared_ptr<const Image> overlayImage = nullptr,
+                BlendMode mode = BlendMode::Over, float opacity = 1.0f,
+                int offsetX = 0, int offsetY = 0)
+        : overlay(std::move(overlayImage)), blendMode(mode),
+          opacity(opacity), offsetX(offsetX), offsetY(offsetY) {}
+
+    void apply(const Image& input, Image& output) override;
+    void applyInPlace(Image& image) override;
+    std::string getName() const override {
+        return "Blend (" + modeToString(blendMode) + (overlay ? "" : ", aucune image") + ")";
+    }
+    std::unique_ptr<Filter> clone() const override {
+        return std::make_unique<BlendFilter>(*this);
+    }
+
+    bool supportsInPlace() const override { return true; }
+    int getHaloRadius() const override { return -1; }   // Overlay placed in image coordinates
+    bool supportsGPU() const override { return true; }
+    double getLastExecutionTime() const override { return lastExecutionTime; }
+
+    void setOverlay(std::shared_ptr<const Image> overlayImage) { overlay = std::move(overlayImage); }
+    const std::shared_ptr<const Image>& getOverlay() const { return overlay; }
+    void setMode(BlendMode mode) { blendMode = mode; }
+    BlendMode getMode() const { return blendMode; }
+    void setOpacity(float value) { opacity = value < 0.0f ? 0.0f : (value > 1.0f ? 1.0f : value); }
+    float getOpacity() const { return opacity; }
+    void setOffset(int x, int y) { offsetX = x; offsetY = y; }
+    int getOffsetX() const { return offsetX; }
+    int getOffsetY() const { return offsetY; }
+
+    // Decodes an overlay file once per process; later calls return the same image
+    static std::shared_ptr<const Image> loadOverlayCached(const std::string& filepath);
+    static void clearOverlayCache();
+
+    static std::string modeToString(BlendMode mode);
+    static bool modeFromString(const std::string& name, BlendMode& mode);
+
+protected:
+    // Overlay/image intersection in image coordinates ([x0, x1) x [y0, y1))
+    struct Placement {
+        int x0 = 0, y0 = 0, x1 = 0, y1 = 0;
+        uint32_t opacity8 = 255;
+    };
+    bool computePlacement(const Image& image, Placement& placement) const;
+
+    std::shared_ptr<const Image> overlay;
+    BlendMode blendMode = BlendMode::Over;
+    float opacity = 1.0f;
+    int offsetX = 0;
+    int offsetY = 0;
+    double lastExecutionTime = 0.0;
+};
+
+#endif
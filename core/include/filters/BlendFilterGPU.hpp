@@ -0,0 +1,41 @@
+/**
+ * @file BlendFilterGPU.hpp
+ * @brief GPU-accelerated alpha compositing / blend modes using SYCL
+ *
+ * SYCL version of BlendFilter: one work-item per pixel of the overlay/image
+ * intersection, using the same blendmath:: integer arithmetic as the CPU
+ * kernel so both paths produce identical results.
+ *
+ * @details
+ * - SYCL Features: sycl::queue, sycl::buffer, 2D parallel_for
+ * - The image buffer is read-write (in-place composite), the overlay read-only
+ * - Falls back to the CPU BlendFilter if no SYCL device is available
+ *
+ * Inherits BlendFilter so UIs can configure the overlay, mode and opacity
+ * through the same interface for both variants.
+ *
+ * @see BlendFilter for the CPU OpenMP implementation
+ * @author Rowan HOUPA
+ * @date January 2026
+ */
+
+#ifndef BLEND_FILTER_GPU_HPP
+#define BLEND_FILTER_GPU_HPP
+
+#include "BlendFilter.hpp"
+#include <sycl/sycl.hpp>
+
+class BlendFilterGPU : public BlendFilter {
+public:
+    using BlendFilter::BlendFilter;
+
+    void applyInPlace(Image& image) override;
+    std::string getName() const override {
+        return "Blend GPU (" + modeToString(blendMode) + (overlay ? "" : ", aucune image") + ")";
+    }
+    std::unique_ptr<Filter> clone() const override {
+        return std::make_unique<BlendFilterGPU>(*this);
+    }
+};
+
+#endif
@@ -8,6 +8,12 @@
  * Algorithm: For each pixel, compute average of (2*radius+1)^2 neighbors
  * Complexity: O(width * height * radius^2)
  *
+ * Modes:
+ * - BoxBlurMode::Direct:     sums every window from scratch (default)
+ * - BoxBlurMode::SummedArea: builds a SummedAreaTable once, then every
+ *   window is a 4-lookup rectangle sum: O(width * height), any radius.
+ *   Produces exactly the same output as Direct.
+ *
  * Implementation uses OpenMP with collapse(2) and dynamic scheduling for
  * efficient 2D parallelization across all CPU cores.
  *
@@ -24,31 +30,51 @@
 #define BOXBLUR_FILTER_HPP
 
 #include "../Filter.hpp"
+#include <algorithm>
 #include <memory>
 #include <chrono>
 
-class BoxBlurFilter : public Filter {
+enum class BoxBlurMode { Direct, SummedArea };
+
+// Radius of the CPU and GPU box blurs, so the UI drives both through one
+// pointer (BoxBlurFilterGPU.hpp pulls in SYCL, this header does not)
+class BoxBlurRadius {
+public:
+    virtual ~BoxBlurRadius() = default;
+    virtual int getRadius() const = 0;
+    virtual void setRadius(int radius) = 0;
+};
+
+class BoxBlurFilter : public Filter, public BoxBlurRadius {
 public:
-    BoxBlurFilter(int radius = 1) : kernelRadius(radius) {}
+    BoxBlurFilter(int radius = 1, BoxBlurMode mode = BoxBlurMode::Direct)
+        : kernelRadius(radius), blurMode(mode) {}
     
     void apply(const Image& input, Image& output) override;
     std::string getName() const override {
-        return "Box Blur (radius=" + std::to_string(kernelRadius) + ")";
+        return "Box Blur (radius=" + std::to_string(kernelRadius) +
+               (blurMode == BoxBlurMode::SummedArea ? ", SAT" : "") + ")";
     }
     std::unique_ptr<Filter> clone() const override {
         return std::make_unique<BoxBlurFilter>(*this);
     }
     
-    int getRadius() const { return kernelRadius; }
-    void setRadius(int radius) {
+    int getRadius() const override { return kernelRadius; }
+    void setRadius(int radius) override {
         kernelRadius = std::max(1, std::min(radius, 10));
     }
+    BoxBlurMode getMode() const { return blurMode; }
+    void setMode(BoxBlurMode mode) { blurMode = mode; }
     
     bool supportsGPU() const override { return true; }
+    int getHaloRadius() const override { return kernelRadius; }
     double getLastExecutionTime() const override { return lastExecutionTime; }
     
 private:
+    void applySummedArea(const Image& input, Image& output);
+
     int kernelRadius = 1;
+    BoxBlurMode blurMode = BoxBlurMode::Direct;
     double lastExecutionTime = 0.0;
 };
 
@@ -24,10 +24,11 @@
 #define BOX_BLUR_FILTER_GPU_HPP
 
 #include "../Filter.hpp"
+#include "BoxBlurFilter.hpp"
 #include <sycl/sycl.hpp>
 #include <chrono>
 
-class BoxBlurFilterGPU : public Filter {
+class BoxBlurFilterGPU : public Filter, public BoxBlurRadius {
 public:
     BoxBlurFilterGPU(int radius = 2) : blurRadius(radius) {}
     
@@ -39,9 +40,10 @@ public:
         return std::make_unique<BoxBlurFilterGPU>(*this);
     }
     bool supportsGPU() const override { return true; }
+    int getHaloRadius() const override { return blurRadius; }
     
-    int getRadius() const { return blurRadius; }
-    void setRadius(int r) { blurRadius = r; }
+    int getRadius() const override { return blurRadius; }
+    void setRadius(int r) override { blurRadius = r; }
     double getLastExecutionTime() const override { return lastExecutionTime; }  // ← override ajouté
     
 private:
@@ -13,6 +13,9 @@
  * This is a parameterized filter demonstrating constructor-based
  * configuration in the polymorphic architecture.
  *
+ * Supports in-place execution (each output value only depends on the
+ * same input value).
+ *
  * @see Filter.hpp for the base class interface
  *
  * @author Rowan HOUPA
@@ -30,6 +33,7 @@ public:
     BrightnessFilter(float factor = 1.0f) : brightnessFactor(factor) {}
     
     void apply(const Image& input, Image& output) override;
+    void applyInPlace(Image& image) override;
     std::string getName() const override { 
         return "Brightness (" + std::to_string(brightnessFactor) + ")"; 
     }
@@ -40,6 +44,8 @@ public:
     float getBrightness() const { return brightnessFactor; }
     void setBrightness(float factor) { brightnessFactor = factor; }
     
+    bool supportsInPlace() const override { return true; }
+    
 private:
     float brightnessFactor = 1.0f; // 1.0 = no change, <1.0 = darker, >1.0 = brighter
 };
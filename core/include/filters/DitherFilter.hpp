@@ -0,0 +1,72 @@
+/**
+ * @file DitherFilter.hpp
+ * @brief Ordered (Bayer) and Floyd-Steinberg dithering to few levels
+ *
+ * Reduces every color channel to `levels` evenly spaced values (2 levels =
+ * 1 bit per channel: pure black and white for grayscale images) while
+ * keeping the perceived tones:
+ * - DitherMode::Ordered: adds an 8x8 Bayer threshold pattern before
+ *   rounding; every pixel is independent
+ * - DitherMode::FloydSteinberg: error diffusion; each pixel's rounding
+ *   error is spread to its right (7/16) and lower (3/16, 5/16, 1/16)
+ *   neighbours
+ *
+ * @details
+ * - Ordered: OpenMP over rows, `omp simd` float arithmetic per row
+ * - Floyd-Steinberg wavefront: pixel (x, y) needs row y - 1 up to x + 1,
+ *   so rows are dealt round-robin to threads and row y trails row y - 1 by
+ *   at least two pixels (progress published every 64 pixels with
+ *   release/acquire atomics). Errors live in a ring of (threads + 2) rows.
+ * - Integer error arithmetic (1/16 units) in a fixed per-row order, so the
+ *   parallel result is bit-identical to applySequential()
+ * - Alpha (2 or 4 channels) is copied unchanged
+ *
+ * @see Filter.hpp for the base class interface
+ * @author Rowan HOUPA
+ * @date January 2026
+ */
+
+#ifndef DITHER_FILTER_HPP
+#define DITHER_FILTER_HPP
+
+#include "../Filter.hpp"
+#include <chrono>
+#include <memory>
+#include <string>
+
+enum class DitherMode { Ordered, FloydSteinberg };
+
+class DitherFilter : public Filter {
+public:
+    DitherFilter(DitherMode mode = DitherMode::FloydSteinberg, int levels = 2)
+        : ditherMode(mode), levels(levels < 2 ? 2 : (levels > 256 ? 256 : levels)) {}
+
+    void apply(const Image& input, Image& output) override;
+    // Single-threaded Floyd-Steinberg reference (same result as apply())
+    void applySequential(const Image& input, Image& output);
+
+    std::string getName() const override {
+        return std::string(ditherMode == DitherMode::Ordered ? "Tramage Bayer" : "Tramage Floyd-Steinberg") +
+               " (" + std::to_string(levels) + " niveaux)";
+    }
+    std::unique_ptr<Filter> clone() const override {
+        return std::make_unique<DitherFilter>(*this);
+    }
+
+    double getLastExecutionTime() const override { return lastExecutionTime; }
+
+    DitherMode getMode() const { return ditherMode; }
+    void setMode(DitherMode mode) { ditherMode = mode; }
+    int getLevels() const { return levels; }
+    void setLevels(int value) { levels = value < 2 ? 2 : (value > 256 ? 256 : value); }
+
+private:
+    void applyOrdered(const Image& input, Image& output) const;
+    void applyErrorDiffusion(const Image& input, Image& output, bool parallel) const;
+
+    DitherMode ditherMode = DitherMode::FloydSteinberg;
+    int levels = 2;
+    double lastExecutionTime = 0.0;
+};
+
+#endif
@@ -30,6 +30,7 @@ public:
         return std::make_unique<GrayscaleFilter>(*this);
     }
     double getLastExecutionTime() const override { return lastExecutionTime; }
+    int getHaloRadius() const override { return 0; }
     
 private:
     double lastExecutionTime = 0.0;
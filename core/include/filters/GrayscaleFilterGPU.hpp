@@ -36,6 +36,7 @@ public:
         return std::make_unique<GrayscaleFilterGPU>(*this);
     }
     bool supportsGPU() const override { return true; }
+    int getHaloRadius() const override { return 0; }
     
     double getLastExecutionTime() const override { return lastExecutionTime; } 
     
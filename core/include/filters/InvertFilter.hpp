@@ -8,6 +8,9 @@
  * Implementation uses OpenMP with chunk-based scheduling (256 pixels per chunk)
  * for optimal cache utilization on linear memory access patterns.
  *
+ * Supports in-place execution: the pipeline can invert a moved-in buffer
+ * directly instead of allocating a second image.
+ *
  * @see Filter.hpp for the base class interface
  *
  * @author Rowan HOUPA
@@ -22,12 +25,14 @@
 class InvertFilter : public Filter {
 public:
     void apply(const Image& input, Image& output) override;
+    void applyInPlace(Image& image) override;
     std::string getName() const override { return "Invert"; }
     std::unique_ptr<Filter> clone() const override {
         return std::make_unique<InvertFilter>(*this);
     }
     
     bool supportsGPU() const override { return true; }
+    bool supportsInPlace() const override { return true; }
 };
 
 #endif
@@ -0,0 +1,77 @@
+/**
+ * @file NLMeansFilter.hpp
+ * @brief Non-local means denoising with integral-image patch distances
+ *
+ * Each output pixel is a weighted average of the pixels in its search
+ * window, weighted by how similar their surrounding patches are:
+ *   w(p, q) = exp(-d²(P(p), P(q)) / h²)
+ * where d² is the mean squared difference between the two patches and h the
+ * filter strength. Preserves edges and texture far better than box blur.
+ *
+ * @details
+ * - Patch distances: for each search offset, the squared-difference image is
+ *   summed into an integral image, so every patch distance is an O(1)
+ *   rectangle sum (cost independent of the patch size)
+ * - Weights: exp() tabulated once per apply() on the normalized distance
+ * - Parallelization: OpenMP over 64x64 output tiles (dynamic scheduling),
+ *   each thread owning its tile's integral image and accumulators
+ * - Fast mode: halves the search radius (about 4x fewer offsets)
+ * - Complexity: O(width × height × (2*searchRadius+1)²)
+ *
+ * @see NLMeansFilterGPU for the SYCL implementation
+ * @see BoxBlurFilter for the simple averaging alternative
+ * @author Rowan HOUPA
+ * @date January 2026
+ */
+
+#ifndef NLMEANS_FILTER_HPP
+#define NLMEANS_FILTER_HPP
+
+#include "../Filter.hpp"
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <string>
+
+class NLMeansFilter : public Filter {
+public:
+    NLMeansFilter(float strength = 10.0f, int patchRadius = 2, int searchRadius = 7, bool fastMode = false)
+        : strength(strength), patchRadius(patchRadius), searchRadius(searchRadius), fastMode(fastMode) {}
+
+    void apply(const Image& input, Image& output) override;
+    std::string getName() const override {
+        return "NL-Means (h=" + std::to_string(static_cast<int>(strength)) +
+               ", search=" + std::to_string(getEffectiveSearchRadius()) +
+               (fastMode ? ", fast" : "") + ")";
+    }
+    std::unique_ptr<Filter> clone() const override {
+        return std::make_unique<NLMeansFilter>(*this);
+    }
+
+    bool supportsGPU() const override { return true; }
+    int getHaloRadius() const override { return getEffectiveSearchRadius() + patchRadius; }
+    double getLastExecutionTime() const override { return lastExecutionTime; }
+
+    float getStrength() const { return strength; }
+    void setStrength(float h) { strength = std::max(0.1f, h); }
+    int getPatchRadius() const { return patchRadius; }
+    void setPatchRadius(int radius) { patchRadius = std::clamp(radius, 0, 5); }
+    int getSearchRadius() const { return searchRadius; }
+    void setSearchRadius(int radius) { searchRadius = std::clamp(radius, 1, 15); }
+    bool isFastMode() const { return fastMode; }
+    void setFastMode(bool enabled) { fastMode = enabled; }
+
+    // Search radius actually used (reduced in fast mode)
+    int getEffectiveSearchRadius() const {
+        return fastMode ? std::max(1, searchRadius / 2) : searchRadius;
+    }
+
+protected:
+    float strength = 10.0f;
+    int patchRadius = 2;
+    int searchRadius = 7;
+    bool fastMode = false;
+    double lastExecutionTime = 0.0;
+};
+
+#endif
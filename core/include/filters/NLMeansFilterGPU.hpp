@@ -0,0 +1,41 @@
+/**
+ * @file NLMeansFilterGPU.hpp
+ * @brief GPU-accelerated non-local means denoising using SYCL
+ *
+ * SYCL version of NLMeansFilter: one work-item per output pixel, with each
+ * 16x16 work-group staging its search neighbourhood (block + search radius +
+ * patch radius on every side) in local memory before computing distances.
+ *
+ * @details
+ * - SYCL Features: sycl::nd_range, sycl::local_accessor, group_barrier
+ * - Patch distances are computed directly from local memory (GPUs favour
+ *   recomputation over the per-offset integral images used on the CPU)
+ * - Falls back to the CPU NLMeansFilter if no SYCL device is available
+ *
+ * @see NLMeansFilter for the CPU OpenMP implementation
+ * @author Rowan HOUPA
+ * @date January 2026
+ */
+
+#ifndef NLMEANS_FILTER_GPU_HPP
+#define NLMEANS_FILTER_GPU_HPP
+
+#include "NLMeansFilter.hpp"
+#include <sycl/sycl.hpp>
+
+class NLMeansFilterGPU : public NLMeansFilter {
+public:
+    using NLMeansFilter::NLMeansFilter;
+
+    void apply(const Image& input, Image& output) override;
+    std::string getName() const override {
+        return "NL-Means GPU (h=" + std::to_string(static_cast<int>(strength)) +
+               ", search=" + std::to_string(getEffectiveSearchRadius()) +
+               (fastMode ? ", fast" : "") + ")";
+    }
+    std::unique_ptr<Filter> clone() const override {
+        return std::make_unique<NLMeansFilterGPU>(*this);
+    }
+};
+
+#endif
@@ -0,0 +1,72 @@
+/**
+ * @file QuantizeFilter.hpp
+ * @brief Palette quantization (median cut or k-means) to at most 256 colors
+ *
+ * Reduces the image to a palette of N colors so it can be stored as an
+ * indexed PNG (one byte or less per pixel instead of three):
+ * - QuantizeMethod::MedianCut: recursively splits the color box with the
+ *   largest weighted extent at the weighted median of its longest axis
+ * - QuantizeMethod::KMeans: median-cut palette refined by weighted Lloyd
+ *   iterations (lower error, slightly slower)
+ *
+ * @details
+ * - Histogram: 32³ cells (5 bits per channel) holding pixel counts and
+ *   color sums, built from a subsampled grid (at most ~1M pixels) with
+ *   per-thread histograms merged in parallel
+ * - Palette search works on the non-empty cells only (a few thousand
+ *   weighted points instead of millions of pixels); k-means assignment is
+ *   an OpenMP loop over those cells
+ * - Mapping: a 32³ cube cache stores the nearest palette entry of every
+ *   cell, so each pixel costs one table lookup
+ * - Images that already have at most N colors are converted exactly
+ * - Alpha (2 or 4 channels): pixels with alpha < 128 share one transparent
+ *   palette entry, the others become opaque
+ *
+ * @see IndexedImage for the indexed PNG output
+ * @author Rowan HOUPA
+ * @date January 2026
+ */
+
+#ifndef QUANTIZE_FILTER_HPP
+#define QUANTIZE_FILTER_HPP
+
+#include "../Filter.hpp"
+#include "../IndexedImage.hpp"
+#include <chrono>
+#include <memory>
+#include <string>
+
+enum class QuantizeMethod { MedianCut, KMeans };
+
+class QuantizeFilter : public Filter {
+public:
+    explicit QuantizeFilter(QuantizeMethod method = QuantizeMethod::KMeans, int colors = 256)
+        : method(method), colors(colors < 2 ? 2 : (colors > 256 ? 256 : colors)) {}
+
+    // Palette colors written back with the input's channel count
+    void apply(const Image& input, Image& output) override;
+    // Palette + indices, ready for IndexedImage::saveToFile()
+    IndexedImage quantize(const Image& input);
+
+    std::string getName() const override {
+        return std::string("Quantification ") + (method == QuantizeMethod::KMeans ? "k-means" : "median cut") +
+               " (" + std::to_string(colors) + " couleurs)";
+    }
+    std::unique_ptr<Filter> clone() const override {
+        return std::make_unique<QuantizeFilter>(*this);
+    }
+
+    double getLastExecutionTime() const override { return lastExecutionTime; }
+
+    QuantizeMethod getMethod() const { return method; }
+    void setMethod(QuantizeMethod value) { method = value; }
+    int getColors() const { return colors; }
+    void setColors(int value) { colors = value < 2 ? 2 : (value > 256 ? 256 : value); }
+
+private:
+    QuantizeMethod method = QuantizeMethod::KMeans;
+    int colors = 256;
+    double lastExecutionTime = 0.0;
+};
+
+#endif
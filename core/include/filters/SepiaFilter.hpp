@@ -14,6 +14,8 @@
  *     newB = 0.272*R + 0.534*G + 0.131*B
  * - Values are clamped to [0, 255] to prevent overflow
  * - Grayscale images are passed through unchanged
+ * - Alpha and extra channels are preserved
+ * - Runs in place (apply() copies the input then calls applyInPlace())
  *
  * @note This is also a DEMONSTRATION filter showing the plugin architecture:
  *       just create the file, register it in FilterRegistration.cpp, rebuild!
@@ -26,6 +28,7 @@
 #define SEPIA_FILTER_HPP
 
 #include "../Filter.hpp"
+#include <algorithm>
 
 /**
  * @class SepiaFilter
@@ -34,36 +37,45 @@
 class SepiaFilter : public Filter {
 public:
     void apply(const Image& input, Image& output) override {
+        // Copy first so alpha (and any extra channel) passes through unchanged
+        output = input;
+        applyInPlace(output);
+    }
+
+    void applyInPlace(Image& image) override {
+        int width = image.getWidth();
+        int height = image.getHeight();
+        int channels = image.getChannels();
 
-        output = Image(input.getWidth(), input.getHeight(), input.getChannels());
+        // Grayscale images are passed through unchanged
+        if (channels < 3) {
+            return;
+        }
 
-        int width = input.getWidth();
-        int height = input.getHeight();
-        int channels = input.getChannels();
+        uint8_t* pixels = image.data();
 
         #pragma omp parallel for schedule(dynamic)
         for (int y = 0; y < height; ++y) {
+            uint8_t* row = pixels + static_cast<size_t>(y) * width * channels;
             for (int x = 0; x < width; ++x) {
-                if (channels >= 3) {
-                    int r = input.at(x, y, 0);
-                    int g = input.at(x, y, 1);
-                    int b = input.at(x, y, 2);
+                uint8_t* px = row + x * channels;
+                int r = px[0];
+                int g = px[1];
+                int b = px[2];
 
-                    int newR = static_cast<int>(0.393 * r + 0.769 * g + 0.189 * b);
-                    int newG = static_cast<int>(0.349 * r + 0.686 * g + 0.168 * b);
-                    int newB = static_cast<int>(0.272 * r + 0.534 * g + 0.131 * b);
+                int newR = static_cast<int>(0.393 * r + 0.769 * g + 0.189 * b);
+                int newG = static_cast<int>(0.349 * r + 0.686 * g + 0.168 * b);
+                int newB = static_cast<int>(0.272 * r + 0.534 * g + 0.131 * b);
 
-                    output.at(x, y, 0) = std::min(255, newR);
-                    output.at(x, y, 1) = std::min(255, newG);
-                    output.at(x, y, 2) = std::min(255, newB);
-                } else {
-                    // For grayscale images, just copy the value                    
-                    output.at(x, y, 0) = input.at(x, y, 0);
-                }
+                px[0] = static_cast<uint8_t>(std::min(255, newR));
+                px[1] = static_cast<uint8_t>(std::min(255, newG));
+                px[2] = static_cast<uint8_t>(std::min(255, newB));
             }
         }
     }
 
+    bool supportsInPlace() const override { return true; }
+
     std::string getName() const override {
         return "Sepia Tone";
     }
@@ -0,0 +1,73 @@
+/**
+ * @file TemporalDenoiseFilter.hpp
+ * @brief Recursive temporal denoising (exponential moving average over frames)
+ *
+ * Meant for frame sequences: each output value is a running average of the
+ * same value in the previous frames,
+ *   history = strength × history + (1 - strength) × input
+ * so static areas lose their sensor noise while a single frame costs one
+ * pass. Where the input moves away from the history by more than the motion
+ * threshold (a moving edge, a scene cut) the history restarts from the
+ * input instead of leaving a ghost trail.
+ *
+ * The filter is stateful: the first frame (and any frame whose size differs
+ * from the previous one) passes through unchanged; reset() forgets the
+ * history. For that reason it is not registered in FilterFactory: a batch
+ * or the GUI would blend unrelated images of the same size. Only
+ * TemporalProcessor builds one (CLI stream --ema), for a single stream.
+ *
+ * @details
+ * - History in 8.8 fixed point (uint16), one value per channel, so slow
+ *   fades converge instead of sticking at a rounding step
+ * - One flat OpenMP `parallel for simd` loop; all channels (alpha included)
+ * - In place: the pipeline hands over the frame buffer itself
+ *
+ * @see TemporalProcessor for tile reuse between frames
+ * @author Rowan HOUPA
+ * @date January 2026
+ */
+
+#ifndef TEMPORAL_DENOISE_FILTER_HPP
+#define TEMPORAL_DENOISE_FILTER_HPP
+
+#include "../Filter.hpp"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+class TemporalDenoiseFilter : public Filter {
+public:
+    explicit TemporalDenoiseFilter(float strength = 0.6f, int motionThreshold = 24) {
+        setStrength(strength);
+        setMotionThreshold(motionThreshold);
+    }
+
+    void apply(const Image& input, Image& output) override;
+    void applyInPlace(Image& image) override;
+    std::string getName() const override;
+    std::unique_ptr<Filter> clone() const override {
+        return std::make_unique<TemporalDenoiseFilter>(*this);
+    }
+
+    bool supportsInPlace() const override { return true; }
+    int getHaloRadius() const override { return -1; }   // Depends on previous frames
+
+    // Weight of the history (0 = off, 0.95 max)
+    float getStrength() const { return strength; }
+    void setStrength(float value) { strength = value < 0.0f ? 0.0f : (value > 0.95f ? 0.95f : value); }
+    int getMotionThreshold() const { return motionThreshold; }
+    void setMotionThreshold(int value) { motionThreshold = value < 0 ? 0 : (value > 255 ? 255 : value); }
+
+    void reset() { history.clear(); }
+
+private:
+    float strength = 0.6f;
+    int motionThreshold = 24;
+    std::vector<uint16_t> history;  // 8.8 fixed point
+    int width = 0;
+    int height = 0;
+    int channels = 0;
+};
+
+#endif
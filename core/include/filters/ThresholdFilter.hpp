@@ -0,0 +1,181 @@
+/**
+ * @file ThresholdFilter.hpp
+ * @brief Binarization filters: fixed, Otsu (global) and adaptive (local)
+ *
+ * All three filters turn the image into black and white for scanned
+ * documents. A pixel becomes foreground (255, or a set bit) when its luma is
+ * above the threshold; setInverted() swaps the two classes.
+ * - ThresholdFilter:         one fixed threshold
+ * - OtsuThresholdFilter:     global threshold maximizing the between-class
+ *                            variance of the luma histogram
+ * - AdaptiveThresholdFilter: per-pixel threshold from the local mean
+ *                            (Bradley) or mean and deviation (Sauvola) over
+ *                            a square window, both read from summed-area
+ *                            tables in O(1) per pixel
+ *
+ * @details
+ * - Output: apply() gives a 1-channel 0/255 Image (pipeline friendly);
+ *   applyPacked() writes the same decisions as a 1-bit BinaryImage
+ *   without materializing the 8-bit image (8x less memory)
+ * - Luma: (77 R + 150 G + 29 B + 128) >> 8 for color input
+ * - Parallelization: OpenMP over rows, `omp simd` compare per row; Otsu's
+ *   histogram is an OpenMP array reduction
+ * - Subclasses only provide prepare() (per image) and rowThresholds()
+ *   (per row); the binarization loops are shared
+ *
+ * @see ThresholdFilterGPU.hpp for the SYCL implementations
+ * @see BinaryImage for the packed output format
+ * @author Rowan HOUPA
+ * @date January 2026
+ */
+
+#ifndef THRESHOLD_FILTER_HPP
+#define THRESHOLD_FILTER_HPP
+
+#include "../Filter.hpp"
+#include "../BinaryImage.hpp"
+#include "../SummedAreaTable.hpp"
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+enum class AdaptiveMethod { Sauvola, Bradley };
+
+/**
+ * @brief Threshold formulas shared by the CPU and SYCL paths.
+ *
+ * Results are floor(threshold) clamped to [-1, 255], so that the integer
+ * test `luma > threshold` matches the real-valued comparison.
+ */
+namespace thresholdmath {
+
+inline int16_t toIntegerThreshold(float t) {
+    if (t < 0.0f) return -1;
+    if (t >= 255.0f) return 255;
+    return static_cast<int16_t>(t);
+}
+
+// Sauvola: T = m * (1 + k * (s / R - 1)), R = 128 for 8-bit data
+inline int16_t sauvola(float mean, float stddev, float k) {
+    return toIntegerThreshold(mean * (1.0f + k * (stddev / 128.0f - 1.0f)));
+}
+
+// Bradley: T = m * (1 - t)
+inline int16_t bradley(float mean, float t) {
+    return toIntegerThreshold(mean * (1.0f - t));
+}
+
+} // namespace thresholdmath
+
+class ThresholdFilter : public Filter {
+public:
+    explicit ThresholdFilter(int threshold = 128, bool inverted = false)
+        : threshold(threshold), inverted(inverted) {}
+
+    void apply(const Image& input, Image& output) override;
+    // Same result as apply(), one bit per pixel
+    void applyPacked(const Image& input, BinaryImage& output);
+
+    std::string getName() const override {
+        return "Seuil (" + std::to_string(threshold) + ")";
+    }
+    std::unique_ptr<Filter> clone() const override {
+        return std::make_unique<ThresholdFilter>(*this);
+    }
+
+    bool supportsGPU() const override { return true; }
+    double getLastExecutionTime() const override { return lastExecutionTime; }
+    int getHaloRadius() const override { return 0; }
+
+    int getThreshold() const { return threshold; }
+    void setThreshold(int value) { threshold = value < 0 ? 0 : (value > 255 ? 255 : value); }
+    bool isInverted() const { return inverted; }
+    void setInverted(bool value) { inverted = value; }
+
+    // Luma plane of any 1-4 channel image (1-channel input is copied)
+    static void computeLuma(const Image& input, Image& luma);
+
+protected:
+    // Shared driver: luma, prepare(), per-row thresholds, 8-bit and/or packed output
+    virtual void binarize(const Image& input, Image* unpacked, BinaryImage* packed);
+
+    // Called once per image with its luma plane
+    virtual void prepare(const Image& luma) { (void)luma; }
+    // Thresholds of row y (foreground when luma > threshold)
+    virtual void rowThresholds(int y, int width, int16_t* thresholds) const;
+    // Drops per-image state once binarization is done
+    virtual void release() {}
+
+    int threshold = 128;
+    bool inverted = false;
+    double lastExecutionTime = 0.0;
+};
+
+class OtsuThresholdFilter : public ThresholdFilter {
+public:
+    explicit OtsuThresholdFilter(bool inverted = false) : ThresholdFilter(128, inverted) {}
+
+    std::string getName() const override {
+        return "Seuil Otsu";
+    }
+    std::unique_ptr<Filter> clone() const override {
+        return std::make_unique<OtsuThresholdFilter>(*this);
+    }
+
+    // Threshold picked for the last image
+    int getLastThreshold() const { return threshold; }
+    int getHaloRadius() const override { return -1; }   // Histogram of the whole image
+
+    // Threshold maximizing the between-class variance of a 256-bin histogram
+    static int otsuThreshold(const std::array<uint64_t, 256>& histogram);
+
+protected:
+    void prepare(const Image& luma) override;
+};
+
+class AdaptiveThresholdFilter : public ThresholdFilter {
+public:
+    AdaptiveThresholdFilter(AdaptiveMethod method = AdaptiveMethod::Sauvola,
+                            int windowRadius = 15, float k = -1.0f, bool inverted = false)
+        : ThresholdFilter(128, inverted), method(method), windowRadius(windowRadius),
+          k(k < 0.0f ? defaultK(method) : k) {}
+
+    std::string getName() const override {
+        return std::string("Seuil adaptatif (") +
+               (method == AdaptiveMethod::Sauvola ? "Sauvola" : "Bradley") +
+               ", fenêtre=" + std::to_string(2 * windowRadius + 1) + ")";
+    }
+    std::unique_ptr<Filter> clone() const override {
+        return std::make_unique<AdaptiveThresholdFilter>(*this);
+    }
+    int getHaloRadius() const override { return windowRadius; }
+
+    AdaptiveMethod getMethod() const { return method; }
+    void setMethod(AdaptiveMethod value) { method = value; }
+    int getWindowRadius() const { return windowRadius; }
+    void setWindowRadius(int radius) { windowRadius = radius < 1 ? 1 : (radius > 50 ? 50 : radius); }
+    // Sauvola k (default 0.2) or Bradley t (default 0.15)
+    float getK() const { return k; }
+    void setK(float value) { k = value; }
+
+    static float defaultK(AdaptiveMethod method) {
+        return method == AdaptiveMethod::Sauvola ? 0.2f : 0.15f;
+    }
+
+protected:
+    void prepare(const Image& luma) override;
+    void rowThresholds(int y, int width, int16_t* thresholds) const override;
+    void release() override;
+
+    AdaptiveMethod method = AdaptiveMethod::Sauvola;
+    int windowRadius = 15;
+    float k = 0.2f;
+
+    // Window sums are at most 101² × 255² < 2^32, so 32-bit tables are exact
+    SummedAreaTable<uint32_t> sumTable;
+    SummedAreaTable<uint32_t> squareTable;
+};
+
+#endif
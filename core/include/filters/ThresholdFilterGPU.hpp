@@ -0,0 +1,77 @@
+/**
+ * @file ThresholdFilterGPU.hpp
+ * @brief GPU-accelerated fixed, Otsu and adaptive thresholding using SYCL
+ *
+ * SYCL versions of the three threshold filters. They share one
+ * binarization kernel (8-bit output, or one work-item per packed byte for
+ * BinaryImage output) and differ in where the threshold comes from:
+ * - ThresholdFilterGPU:         constant
+ * - OtsuThresholdFilterGPU:     luma histogram built on the device with
+ *                               work-group local histograms and atomics
+ * - AdaptiveThresholdFilterGPU: window statistics from summed-area tables
+ *                               built with SummedAreaTable::buildGPU()
+ *
+ * @details
+ * - SYCL Features: nd_range, local_accessor, atomic_ref, 2D parallel_for
+ * - Uses the thresholdmath:: formulas, so results match the CPU filters
+ * - Falls back to the CPU implementation if no SYCL device is available
+ *
+ * @see ThresholdFilter.hpp for the CPU OpenMP implementations
+ * @author Rowan HOUPA
+ * @date January 2026
+ */
+
+#ifndef THRESHOLD_FILTER_GPU_HPP
+#define THRESHOLD_FILTER_GPU_HPP
+
+#include "ThresholdFilter.hpp"
+#include <sycl/sycl.hpp>
+
+class ThresholdFilterGPU : public ThresholdFilter {
+public:
+    using ThresholdFilter::ThresholdFilter;
+
+    std::string getName() const override {
+        return "Seuil GPU (" + std::to_string(threshold) + ")";
+    }
+    std::unique_ptr<Filter> clone() const override {
+        return std::make_unique<ThresholdFilterGPU>(*this);
+    }
+
+protected:
+    void binarize(const Image& input, Image* unpacked, BinaryImage* packed) override;
+};
+
+class OtsuThresholdFilterGPU : public OtsuThresholdFilter {
+public:
+    using OtsuThresholdFilter::OtsuThresholdFilter;
+
+    std::string getName() const override {
+        return "Seuil Otsu GPU";
+    }
+    std::unique_ptr<Filter> clone() const override {
+        return std::make_unique<OtsuThresholdFilterGPU>(*this);
+    }
+
+protected:
+    void binarize(const Image& input, Image* unpacked, BinaryImage* packed) override;
+};
+
+class AdaptiveThresholdFilterGPU : public AdaptiveThresholdFilter {
+public:
+    using AdaptiveThresholdFilter::AdaptiveThresholdFilter;
+
+    std::string getName() const override {
+        return std::string("Seuil adaptatif GPU (") +
+               (method == AdaptiveMethod::Sauvola ? "Sauvola" : "Bradley") +
+               ", fenêtre=" + std::to_string(2 * windowRadius + 1) + ")";
+    }
+    std::unique_ptr<Filter> clone() const override {
+        return std::make_unique<AdaptiveThresholdFilterGPU>(*this);
+    }
+
+protected:
+    void binarize(const Image& input, Image* unpacked, BinaryImage* packed) override;
+};
+
+#endif
@@ -0,0 +1,40 @@
+/**
+ * @file WarpFilterGPU.hpp
+ * @brief GPU-accelerated geometric warps using SYCL
+ *
+ * SYCL version of WarpFilter: one work-item per output pixel computes its
+ * source position (matrix in single precision, or a RemapTable lookup) and
+ * samples it with the shared warpmath:: bilinear/bicubic helpers.
+ *
+ * @details
+ * - SYCL Features: sycl::queue, sycl::buffer, 2D parallel_for
+ * - Lens tables come from the same cache as the CPU filter, so a batch
+ *   uploads a table built once per (camera, size)
+ * - Matrix warps compute coordinates directly per pixel (no incremental
+ *   stepping), so results may differ from the CPU path by one level
+ * - Falls back to the CPU WarpFilter if no SYCL device is available
+ *
+ * @see WarpFilter for the CPU OpenMP implementation
+ * @author Rowan HOUPA
+ * @date January 2026
+ */
+
+#ifndef WARP_FILTER_GPU_HPP
+#define WARP_FILTER_GPU_HPP
+
+#include "WarpFilter.hpp"
+#include <sycl/sycl.hpp>
+
+class WarpFilterGPU : public WarpFilter {
+public:
+    WarpFilterGPU() = default;
+    explicit WarpFilterGPU(const WarpFilter& configuration) : WarpFilter(configuration) {}
+
+    void apply(const Image& input, Image& output) override;
+    std::string getName() const override { return WarpFilter::getName() + " GPU"; }
+    std::unique_ptr<Filter> clone() const override {
+        return std::make_unique<WarpFilterGPU>(*this);
+    }
+};
+
+#endif
@@ -0,0 +1,207 @@
+/**
+ * @file BatchJournal.cpp
+ * @brief Reading back, validating and group-committing the batch journal
+ *
+ * @details
+ * The checksum of a line is the FNV-1a hash of its other fields, so a
+ * torn or half-synced line is told apart from a complete one without
+ * any framing. Input keys and output sizes are computed on the writer
+ * thread, leaving record() a push under a lock.
+ *
+ * @see BatchJournal.hpp for the line layout
+ * @author Rowan HOUPA
+ * @date January 2026
+ */
+
+#include "BatchJournal.hpp"
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+
+#ifdef __unix__
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace {
+    constexpr const char* MAGIC = "IFJ1";
+
+    uint64_t fnv1a(const std::string& text) {
+        uint64_t hash = 14695981039346656037ull;
+        for (unsigned char c : text) {
+            hash ^= c;
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    std::string hex(uint64_t value) {
+        char text[17];
+        std::snprintf(text, sizeof(text), "%016llx", static_cast<unsigned long long>(value));
+        return text;
+    }
+
+    // Fields covered by the checksum: everything but the checksum itself
+    std::string fields(uint64_t key, uint64_t perceptualHash, uint64_t size, double ms, const std::string& output) {
+        char text[96];
+        std::snprintf(text, sizeof(text), "%016llx %016llx %llu %.3f",
+                      static_cast<unsigned long long>(key), static_cast<unsigned long long>(perceptualHash),
+                      static_cast<unsigned long long>(size), ms);
+        return std::string(text) + " " + output;
+    }
+
+    bool syncFile(std::FILE* file) {
+        if (std::fflush(file) != 0) return false;
+#ifdef __unix__
+        return fsync(fileno(file)) == 0;
+#else
+        return true;
+#endif
+    }
+}
+
+BatchJournal::BatchJournal(std::string path, const std::string& runKey, size_t syncEvery, int syncIntervalMs)
+    : path(std::move(path)), syncEvery(std::max<size_t>(1, syncEvery)), syncIntervalMs(std::max(1, syncIntervalMs)) {
+    load(runKey);
+    writer = std::thread(&BatchJournal::writerLoop, this);
+}
+
+BatchJournal::~BatchJournal() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stop = true;
+    }
+    wake.notify_all();
+    writer.join();
+    if (file) std::fclose(file);
+}
+
+void BatchJournal::load(const std::string& runKey) {
+    const std::string header = std::string(MAGIC) + " " + hex(fnv1a(runKey));
+
+    std::ifstream in(path, std::ios::binary);
+    std::string line;
+    bool sameRun = in && std::getline(in, line) && line == header;
+    if (sameRun) {
+        std::streamoff validEnd = in.tellg();
+        while (std::getline(in, line) && !in.eof()) {
+            unsigned long long key, perceptualHash, size, checksum;
+            double ms;
+            int outputStart = 0;
+            if (std::sscanf(line.c_str(), "%llx %llx %llu %lf %llx %n",
+                            &key, &perceptualHash, &size, &ms, &checksum, &outputStart) != 5 ||
+                outputStart <= 0) {
+                break;
+            }
+            Entry entry{perceptualHash, size, ms, line.substr(static_cast<size_t>(outputStart))};
+            if (fnv1a(fields(key, perceptualHash, size, ms, entry.outputPath)) != checksum) break;
+            resumed[key] = std::move(entry);
+            validEnd = in.tellg();
+        }
+        in.close();
+
+        // Cut a torn last line off before appending after it
+        std::error_code error;
+        if (fs::file_size(path, error) != static_cast<uintmax_t>(validEnd) && !error) {
+            fs::resize_file(path, static_cast<uintmax_t>(validEnd), error);
+        }
+        file = std::fopen(path.c_str(), "ab");
+    } else {
+        in.close();
+        file = std::fopen(path.c_str(), "wb");
+        if (file) {
+            std::fputs((header + "\n").c_str(), file);
+            syncFile(file);
+        }
+    }
+}
+
+bool BatchJournal::completed(const std::string& inputPath, Entry& entry) const {
+    auto it = resumed.find(inputKey(inputPath));
+    if (it == resumed.end()) return false;
+    std::error_code error;
+    const uintmax_t size = fs::file_size(it->second.outputPath, error);
+    if (error || size != it->second.outputSize) return false;
+    entry = it->second;
+    return true;
+}
+
+void BatchJournal::record(const std::string& inputPath, const std::string& outputPath,
+                          uint64_t perceptualHash, double ms) {
+    bool full;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        queue.push_back({inputPath, outputPath, perceptualHash, ms});
+        ++recorded;
+        full = queue.size() >= syncEvery;
+    }
+    if (full) wake.notify_one();
+}
+
+void BatchJournal::flush() {
+    std::unique_lock<std::mutex> lock(mutex);
+    const size_t target = recorded;
+    flushRequested = true;
+    wake.notify_one();
+    flushed.wait(lock, [&] { return written >= target; });
+}
+
+size_t BatchJournal::getSyncCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return syncs;
+}
+
+uint64_t BatchJournal::inputKey(const std::string& path) {
+    std::error_code error;
+    const fs::path absolute = fs::absolute(path, error);
+    if (error) return 0;
+    const auto size = fs::file_size(absolute, error);
+    if (error) return 0;
+    const auto modified = fs::last_write_time(absolute, error);
+    if (error) return 0;
+    return fnv1a(absolute.string() + "|" + std::to_string(size) + "|" +
+                 std::to_string(modified.time_since_epoch().count()));
+}
+
+void BatchJournal::writerLoop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        wake.wait_for(lock, std::chrono::milliseconds(syncIntervalMs),
+                      [this] { return stop || flushRequested || queue.size() >= syncEvery; });
+        flushRequested = false;
+        if (queue.empty()) {
+            if (stop) break;
+            flushed.notify_all();
+            continue;
+        }
+
+        std::vector<Pending> group;
+        group.swap(queue);
+        lock.unlock();
+        writeGroup(group);
+        lock.lock();
+        written += group.size();
+        ++syncs;
+        flushed.notify_all();
+    }
+}
+
+void BatchJournal::writeGroup(std::vector<Pending>& group) {
+    if (!file) return;
+    std::string lines;
+    for (const Pending& item : group) {
+        std::error_code error;
+        const std::string output = fs::absolute(item.outputPath, error).string();
+        const uintmax_t size = fs::file_size(output, error);
+        const uint64_t key = inputKey(item.inputPath);
+        if (error || key == 0) continue;
+        const std::string covered = fields(key, item.perceptualHash, size, item.ms, output);
+        // Checksum goes before the path, which may contain spaces
+        const size_t pathStart = covered.size() - output.size();
+        lines += covered.substr(0, pathStart) + hex(fnv1a(covered)) + " " + output + "\n";
+    }
+    std::fwrite(lines.data(), 1, lines.size(), file);
+    syncFile(file);
+}
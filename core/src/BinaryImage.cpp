@@ -0,0 +1,96 @@
+/**
+ * @file BinaryImage.cpp
+ * @brief Packing, unpacking and PBM output for 1-bit images
+ *
+ * @details
+ * - fromImage()/toImage(): OpenMP over rows, 8 pixels per output byte
+ * - saveToFile(".pbm"): binary PBM (P4) header followed by the packed rows;
+ *   PBM uses 1 for black, so bytes are complemented on the way out
+ *
+ * @see BinaryImage.hpp for the layout
+ * @author Rowan HOUPA
+ * @date January 2026
+ */
+
+#include "BinaryImage.hpp"
+#include <algorithm>
+#include <bit>
+#include <fstream>
+
+BinaryImage::BinaryImage(int width, int height)
+    : m_width(width), m_height(height), m_rowBytes((width + 7) / 8) {
+    if (width <= 0 || height <= 0) {
+        throw std::invalid_argument("BinaryImage dimensions must be positive");
+    }
+    m_bits.assign(static_cast<size_t>(m_rowBytes) * height, 0);
+}
+
+BinaryImage BinaryImage::fromImage(const Image& image, int threshold) {
+    BinaryImage result(image.getWidth(), image.getHeight());
+    const int width = image.getWidth();
+    const int channels = image.getChannels();
+    const uint8_t* src = image.data();
+
+    #pragma omp parallel for schedule(static)
+    for (int y = 0; y < result.m_height; ++y) {
+        const uint8_t* in = src + static_cast<size_t>(y) * width * channels;
+        uint8_t* out = result.row(y);
+        for (int bx = 0; bx < result.m_rowBytes; ++bx) {
+            const int x0 = bx * 8;
+            const int n = std::min(8, width - x0);
+            uint8_t bits = 0;
+            for (int i = 0; i < n; ++i) {
+                bits |= static_cast<uint8_t>((in[(x0 + i) * channels] > threshold) << (7 - i));
+            }
+            out[bx] = bits;
+        }
+    }
+    return result;
+}
+
+Image BinaryImage::toImage() const {
+    Image result(m_width, m_height, 1);
+    uint8_t* dst = result.data();
+
+    #pragma omp parallel for schedule(static)
+    for (int y = 0; y < m_height; ++y) {
+        const uint8_t* in = row(y);
+        uint8_t* out = dst + static_cast<size_t>(y) * m_width;
+        #pragma omp simd
+        for (int x = 0; x < m_width; ++x) {
+            out[x] = ((in[x >> 3] >> (7 - (x & 7))) & 1) ? 255 : 0;
+        }
+    }
+    return result;
+}
+
+bool BinaryImage::saveToFile(const std::string& filepath) const {
+    std::string ext = filepath.substr(filepath.find_last_of(".") + 1);
+
+    if (ext != "pbm") {
+        return toImage().saveToFile(filepath);
+    }
+
+    std::ofstream file(filepath, std::ios::binary);
+    if (!file) return false;
+
+    file << "P4\n" << m_width << " " << m_height << "\n";
+    std::vector<uint8_t> line(m_rowBytes);
+    for (int y = 0; y < m_height; ++y) {
+        const uint8_t* in = row(y);
+        for (int bx = 0; bx < m_rowBytes; ++bx) {
+            line[bx] = static_cast<uint8_t>(~in[bx]);
+        }
+        file.write(reinterpret_cast<const char*>(line.data()), m_rowBytes);
+    }
+    return static_cast<bool>(file);
+}
+
+size_t BinaryImage::countSet() const {
+    size_t count = 0;
+    #pragma omp parallel for reduction(+:count) schedule(static)
+    for (size_t i = 0; i < m_bits.size(); ++i) {
+        count += static_cast<size_t>(std::popcount(m_bits[i]));
+    }
+    return count;
+}
@@ -0,0 +1,339 @@
+/**
+ * @file ConnectedComponents.cpp
+ * @brief Block-based parallel union-find labeling using OpenMP
+ *
+ * @details
+ * Union-find representation:
+ * - labels[p] == p + 1      : p is a root
+ * - labels[p] == q + 1      : parent of p is q (always q < p)
+ * - Roots are linked from the larger to the smaller index, so the root of
+ *   a component is its first pixel in raster order
+ *
+ * Border unions run concurrently: roots are linked with compare-and-swap
+ * (std::atomic_ref) and retried when another thread linked them first.
+ * Path reads in later passes use relaxed atomic loads for the same reason.
+ *
+ * During relabeling, roots temporarily hold (final label | ROOT_FLAG) so
+ * that other bands can resolve their pixels without a second lookup table;
+ * non-root pixels are overwritten with their final label as they are read.
+ *
+ * @see ConnectedComponents.hpp for the algorithm outline
+ * @author Rowan HOUPA
+ * @date January 2026
+ */
+
+#include "ConnectedComponents.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace {
+
+constexpr int BAND_HEIGHT = 64;
+constexpr uint32_t ROOT_FLAG = 0x80000000u;
+
+struct Accumulator {
+    int minX = 0, minY = 0, maxX = -1, maxY = -1;
+    uint64_t area = 0;
+    uint64_t sumX = 0;
+    uint64_t sumY = 0;
+
+    // Adds the horizontal run [x0, x1] of row y
+    void addRun(int x0, int x1, int y) {
+        if (area == 0) {
+            minX = x0; maxX = x1; minY = y; maxY = y;
+        } else {
+            minX = std::min(minX, x0); maxX = std::max(maxX, x1);
+            minY = std::min(minY, y); maxY = std::max(maxY, y);
+        }
+        const uint64_t n = static_cast<uint64_t>(x1 - x0 + 1);
+        area += n;
+        sumX += n * static_cast<uint64_t>(x0 + x1) / 2;
+        sumY += n * static_cast<uint64_t>(y);
+    }
+
+    void merge(const Accumulator& other) {
+        if (other.area == 0) return;
+        if (area == 0) { *this = other; return; }
+        minX = std::min(minX, other.minX); maxX = std::max(maxX, other.maxX);
+        minY = std::min(minY, other.minY); maxY = std::max(maxY, other.maxY);
+        area += other.area;
+        sumX += other.sumX;
+        sumY += other.sumY;
+    }
+};
+
+inline uint32_t loadRelaxed(uint32_t& value) {
+    return std::atomic_ref<uint32_t>(value).load(std::memory_order_relaxed);
+}
+
+// Root of p (band-local pass: no concurrent writers)
+inline uint32_t findLocal(const uint32_t* labels, uint32_t p) {
+    while (labels[p] - 1 != p) p = labels[p] - 1;
+    return p;
+}
+
+inline void uniteLocal(uint32_t* labels, uint32_t a, uint32_t b) {
+    a = findLocal(labels, a);
+    b = findLocal(labels, b);
+    if (a == b) return;
+    if (a < b) std::swap(a, b);
+    labels[a] = b + 1;
+}
+
+inline uint32_t findShared(uint32_t* labels, uint32_t p) {
+    uint32_t parent = loadRelaxed(labels[p]) - 1;
+    while (parent != p) {
+        p = parent;
+        parent = loadRelaxed(labels[p]) - 1;
+    }
+    return p;
+}
+
+// Lock-free union: links the larger root under the smaller one with CAS
+inline void uniteShared(uint32_t* labels, uint32_t a, uint32_t b) {
+    while (true) {
+        a = findShared(labels, a);
+        b = findShared(labels, b);
+        if (a == b) return;
+        if (a < b) std::swap(a, b);
+        uint32_t expected = a + 1;
+        if (std::atomic_ref<uint32_t>(labels[a]).compare_exchange_strong(
+                expected, b + 1, std::memory_order_relaxed)) {
+            return;
+        }
+    }
+}
+
+inline void unpackRow(const BinaryImage& image, int y, uint8_t* out) {
+    const uint8_t* bits = image.row(y);
+    const int width = image.getWidth();
+    #pragma omp simd
+    for (int x = 0; x < width; ++x) {
+        out[x] = (bits[x >> 3] >> (7 - (x & 7))) & 1;
+    }
+}
+
+} // namespace
+
+void ConnectedComponents::label(const Image& image, int threshold) {
+    label(BinaryImage::fromImage(image, threshold));
+}
+
+void ConnectedComponents::label(const BinaryImage& image) {
+    auto start = std::chrono::high_resolution_clock::now();
+
+    width = image.getWidth();
+    height = image.getHeight();
+    if (static_cast<uint64_t>(width) * height >= ROOT_FLAG) {
+        throw std::invalid_argument("ConnectedComponents: image too large (max 2^31 pixels)");
+    }
+
+    const size_t pixelCount = static_cast<size_t>(width) * height;
+    labels.assign(pixelCount, 0);
+    uint32_t* lab = labels.data();
+    const bool eight = (connectivity == Connectivity::Eight);
+    const int bands = (height + BAND_HEIGHT - 1) / BAND_HEIGHT;
+
+    // 1. Band-local labeling
+    #pragma omp parallel
+    {
+        std::vector<uint8_t> previous(width);
+        std::vector<uint8_t> current(width);
+
+        #pragma omp for schedule(dynamic)
+        for (int b = 0; b < bands; ++b) {
+            const int y0 = b * BAND_HEIGHT;
+            const int y1 = std::min(height, y0 + BAND_HEIGHT);
+
+            for (int y = y0; y < y1; ++y) {
+                unpackRow(image, y, current.data());
+                const bool hasAbove = y > y0;
+                const uint32_t rowStart = static_cast<uint32_t>(static_cast<size_t>(y) * width);
+
+                for (int x = 0; x < width; ++x) {
+                    if (!current[x]) continue;
+                    const uint32_t p = rowStart + x;
+                    lab[p] = p + 1;
+
+                    if (x > 0 && current[x - 1]) {
+                        uniteLocal(lab, p, p - 1);
+                    }
+                    if (hasAbove) {
+                        const uint32_t up = p - width;
+                        if (previous[x]) {
+                            uniteLocal(lab, p, up);
+                        } else if (eight) {
+                            // N is background: NW and NE may belong to different regions
+                            if (x > 0 && previous[x - 1]) uniteLocal(lab, p, up - 1);
+                            if (x + 1 < width && previous[x + 1]) uniteLocal(lab, p, up + 1);
+                        }
+                    }
+                }
+                std::swap(previous, current);
+            }
+        }
+    }
+
+    // 2. Merge labels across band borders
+    #pragma omp parallel
+    {
+        std::vector<uint8_t> above(width);
+        std::vector<uint8_t> row(width);
+
+        #pragma omp for schedule(static)
+        for (int b = 1; b < bands; ++b) {
+            const int y = b * BAND_HEIGHT;
+            unpackRow(image, y - 1, above.data());
+            unpackRow(image, y, row.data());
+            const uint32_t rowStart = static_cast<uint32_t>(static_cast<size_t>(y) * width);
+
+            for (int x = 0; x < width; ++x) {
+                if (!row[x]) continue;
+                const uint32_t p = rowStart + x;
+                const uint32_t up = p - width;
+                if (above[x]) {
+                    uniteShared(lab, p, up);
+                } else if (eight) {
+                    if (x > 0 && above[x - 1]) uniteShared(lab, p, up - 1);
+                    if (x + 1 < width && above[x + 1]) uniteShared(lab, p, up + 1);
+                }
+            }
+        }
+    }
+
+    // 3. Flatten to roots and count roots per band
+    std::vector<uint32_t> bandOffsets(bands + 1, 0);
+
+    #pragma omp parallel for schedule(static)
+    for (int b = 0; b < bands; ++b) {
+        const size_t begin = static_cast<size_t>(b) * BAND_HEIGHT * width;
+        const size_t end = std::min(pixelCount, begin + static_cast<size_t>(BAND_HEIGHT) * width);
+        uint32_t roots = 0;
+        for (size_t p = begin; p < end; ++p) {
+            if (!lab[p]) continue;
+            const uint32_t root = findShared(lab, static_cast<uint32_t>(p));
+            if (root == p) {
+                ++roots;
+            } else {
+                std::atomic_ref<uint32_t>(lab[p]).store(root + 1, std::memory_order_relaxed);
+            }
+        }
+        bandOffsets[b + 1] = roots;
+    }
+
+    for (int b = 0; b < bands; ++b) {
+        bandOffsets[b + 1] += bandOffsets[b];
+    }
+    const uint32_t componentCount = bandOffsets[bands];
+
+    // Final label of every root, stored in place (raster order)
+    #pragma omp parallel for schedule(static)
+    for (int b = 0; b < bands; ++b) {
+        const size_t begin = static_cast<size_t>(b) * BAND_HEIGHT * width;
+        const size_t end = std::min(pixelCount, begin + static_cast<size_t>(BAND_HEIGHT) * width);
+        uint32_t next = bandOffsets[b] + 1;
+        for (size_t p = begin; p < end; ++p) {
+            if (lab[p] == p + 1) {
+                lab[p] = ROOT_FLAG | next++;
+            }
+        }
+    }
+
+    // 4. Relabel and accumulate statistics (one run at a time)
+    std::vector<Accumulator> accumulators(componentCount);
+    std::vector<std::unordered_map<uint32_t, Accumulator>> foreign(bands);
+
+    #pragma omp parallel for schedule(dynamic)
+    for (int b = 0; b < bands; ++b) {
+        const int y0 = b * BAND_HEIGHT;
+        const int y1 = std::min(height, y0 + BAND_HEIGHT);
+        const uint32_t firstOwned = bandOffsets[b] + 1;
+        auto& foreignStats = foreign[b];
+
+        auto flush = [&](uint32_t id, int runStart, int runEnd, int y) {
+            if (id >= firstOwned) {
+                accumulators[id - 1].addRun(runStart, runEnd, y);
+            } else {
+                foreignStats[id].addRun(runStart, runEnd, y);
+            }
+        };
+
+        for (int y = y0; y < y1; ++y) {
+            uint32_t* row = lab + static_cast<size_t>(y) * width;
+            uint32_t runId = 0;
+            int runStart = 0;
+
+            for (int x = 0; x < width; ++x) {
+                uint32_t id = row[x];
+                if (id & ROOT_FLAG) {
+                    id &= ~ROOT_FLAG;
+                } else if (id) {
+                    // Other bands only ever read root entries: safe to overwrite
+                    id = lab[id - 1] & ~ROOT_FLAG;
+                    row[x] = id;
+                }
+                if (id != runId) {
+                    if (runId) flush(runId, runStart, x - 1, y);
+                    runId = id;
+                    runStart = x;
+                }
+            }
+            if (runId) flush(runId, runStart, width - 1, y);
+        }
+    }
+
+    // Roots keep their flag until every band has resolved its pixels
+    #pragma omp parallel for schedule(static)
+    for (size_t p = 0; p < pixelCount; ++p) {
+        lab[p] &= ~ROOT_FLAG;
+    }
+
+    for (int b = 0; b < bands; ++b) {
+        for (const auto& [id, partial] : foreign[b]) {
+            accumulators[id - 1].merge(partial);
+        }
+    }
+
+    components.assign(componentCount, ComponentStats());
+    #pragma omp parallel for schedule(static)
+    for (size_t i = 0; i < componentCount; ++i) {
+        const Accumulator& a = accumulators[i];
+        ComponentStats& s = components[i];
+        s.minX = a.minX; s.minY = a.minY;
+        s.maxX = a.maxX; s.maxY = a.maxY;
+        s.area = a.area;
+        s.centroidX = static_cast<double>(a.sumX) / a.area;
+        s.centroidY = static_cast<double>(a.sumY) / a.area;
+    }
+
+    auto end = std::chrono::high_resolution_clock::now();
+    lastExecutionTime = std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+Image ConnectedComponents::toColorImage() const {
+    if (labels.empty()) return Image();
+
+    Image result(width, height, 3);
+    uint8_t* dst = result.data();
+    const size_t pixelCount = labels.size();
+
+    #pragma omp parallel for schedule(static)
+    for (size_t p = 0; p < pixelCount; ++p) {
+        const uint32_t id = labels[p];
+        uint8_t* out = dst + p * 3;
+        if (!id) {
+            out[0] = out[1] = out[2] = 0;
+            continue;
+        }
+        // Integer hash spreads neighbouring labels over distinct colors
+        uint32_t h = id * 2654435761u;
+        h ^= h >> 15;
+        out[0] = static_cast<uint8_t>(64 + (h & 0xBF));
+        out[1] = static_cast<uint8_t>(64 + ((h >> 8) & 0xBF));
+        out[2] = static_cast<uint8_t>(64 + ((h >> 16) & 0xBF));
+    }
+    return result;
+}
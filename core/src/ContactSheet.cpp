@@ -0,0 +1,145 @@
+/**
+ * @file ContactSheet.cpp
+ * @brief Area-averaging thumbnails and thread-safe sheet compositing
+ *
+ * @details
+ * Output pixel (tx, ty) of a thumbnail averages the source box
+ * [tx W / w, (tx + 1) W / w) × [ty H / h, (ty + 1) H / h); boxes tile the
+ * source exactly since w <= W and h <= H. Sums are uint32 (a box would need
+ * more than 16M pixels to overflow).
+ *
+ * @see ContactSheet.hpp for the sheet layout
+ * @author Rowan HOUPA
+ * @date January 2026
+ */
+
+#include "ContactSheet.hpp"
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <vector>
+
+namespace {
+    constexpr uint8_t BACKGROUND = 32;
+}
+
+ContactSheet::ContactSheet(int thumbnailSize, int columns, int rows, int padding)
+    : thumbnailSize(std::max(8, thumbnailSize)), columns(std::max(1, columns)),
+      rows(std::max(1, rows)), padding(std::max(0, padding)) {}
+
+Image ContactSheet::thumbnail(const Image& image, int maxWidth, int maxHeight) {
+    const int width = image.getWidth();
+    const int height = image.getHeight();
+    const int channels = image.getChannels();
+    if (width == 0 || height == 0) return Image();
+
+    const double scale = std::min({1.0, static_cast<double>(maxWidth) / width,
+                                   static_cast<double>(maxHeight) / height});
+    if (scale >= 1.0) return image;
+
+    const int outWidth = std::max(1, static_cast<int>(std::lround(width * scale)));
+    const int outHeight = std::max(1, static_cast<int>(std::lround(height * scale)));
+    const int rowValues = width * channels;
+    Image result(outWidth, outHeight, channels);
+    const uint8_t* src = image.data();
+    uint8_t* dst = result.data();
+
+    #pragma omp parallel
+    {
+        std::vector<uint32_t> columnSums(rowValues);
+
+        #pragma omp for schedule(static)
+        for (int ty = 0; ty < outHeight; ++ty) {
+            const int y0 = static_cast<int>(static_cast<int64_t>(ty) * height / outHeight);
+            const int y1 = static_cast<int>(static_cast<int64_t>(ty + 1) * height / outHeight);
+
+            // Vertical sums of the covered rows
+            uint32_t* sums = columnSums.data();
+            std::fill(sums, sums + rowValues, 0u);
+            for (int y = y0; y < y1; ++y) {
+                const uint8_t* in = src + static_cast<size_t>(y) * rowValues;
+                #pragma omp simd
+                for (int i = 0; i < rowValues; ++i) {
+                    sums[i] += in[i];
+                }
+            }
+
+            // Horizontal spans
+            uint8_t* out = dst + static_cast<size_t>(ty) * outWidth * channels;
+            for (int tx = 0; tx < outWidth; ++tx) {
+                const int x0 = static_cast<int>(static_cast<int64_t>(tx) * width / outWidth);
+                const int x1 = static_cast<int>(static_cast<int64_t>(tx + 1) * width / outWidth);
+                const uint32_t area = static_cast<uint32_t>((x1 - x0) * (y1 - y0));
+                for (int c = 0; c < channels; ++c) {
+                    uint32_t sum = 0;
+                    for (int x = x0; x < x1; ++x) {
+                        sum += sums[x * channels + c];
+                    }
+                    out[tx * channels + c] = static_cast<uint8_t>((sum + area / 2) / area);
+                }
+            }
+        }
+    }
+    return result;
+}
+
+void ContactSheet::add(const Image& image) {
+    const int cell = thumbnailSize + padding;
+    Image* sheet = nullptr;
+    int slot = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        slot = static_cast<int>(count % static_cast<size_t>(columns * rows));
+        if (slot == 0) {
+            Image blank(columns * cell + padding, rows * cell + padding, 3);
+            std::fill(blank.data(), blank.data() + blank.size(), BACKGROUND);
+            sheets.push_back(std::move(blank));
+        }
+        sheet = &sheets.back();
+        ++count;
+    }
+
+    const Image thumb = thumbnail(image, thumbnailSize, thumbnailSize);
+    if (thumb.size() == 0) return;
+
+    const int channels = thumb.getChannels();
+    const int left = padding + (slot % columns) * cell + (thumbnailSize - thumb.getWidth()) / 2;
+    const int top = padding + (slot / columns) * cell + (thumbnailSize - thumb.getHeight()) / 2;
+    const int sheetWidth = sheet->getWidth();
+
+    for (int y = 0; y < thumb.getHeight(); ++y) {
+        const uint8_t* in = thumb.data() + static_cast<size_t>(y) * thumb.getWidth() * channels;
+        uint8_t* out = sheet->data() + (static_cast<size_t>(top + y) * sheetWidth + left) * 3;
+        for (int x = 0; x < thumb.getWidth(); ++x) {
+            const uint8_t* p = in + x * channels;
+            uint8_t* q = out + x * 3;
+            const int r = p[0];
+            const int g = channels >= 3 ? p[1] : p[0];
+            const int b = channels >= 3 ? p[2] : p[0];
+            if (channels == 2 || channels == 4) {
+                const int a = p[channels - 1];
+                q[0] = static_cast<uint8_t>((r * a + BACKGROUND * (255 - a) + 127) / 255);
+                q[1] = static_cast<uint8_t>((g * a + BACKGROUND * (255 - a) + 127) / 255);
+                q[2] = static_cast<uint8_t>((b * a + BACKGROUND * (255 - a) + 127) / 255);
+            } else {
+                q[0] = static_cast<uint8_t>(r);
+                q[1] = static_cast<uint8_t>(g);
+                q[2] = static_cast<uint8_t>(b);
+            }
+        }
+    }
+}
+
+int ContactSheet::save(const std::string& basePath) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    const std::filesystem::path base(basePath);
+    int written = 0;
+    for (size_t i = 0; i < sheets.size(); ++i) {
+        const std::filesystem::path path = base.parent_path() /
+            (base.stem().string() + "_" + std::to_string(i + 1) + base.extension().string());
+        if (sheets[i].saveToFile(path.string())) {
+            ++written;
+        }
+    }
+    return written;
+}
@@ -0,0 +1,371 @@
+/**
+ * @file EditHistory.cpp
+ * @brief Step diffs, snapshot validity, thinning and background compression
+ *
+ * @details
+ * Steps are numbered by the history position they lead to: steps[i] turns
+ * position i into position i + 1. A snapshot of k filters taken at position
+ * a is valid at position b when every step between them edits at index
+ * >= k (the first k filters are then the same at a and b).
+ *
+ * Thinning keeps snapshots spread out: sorted by position, the one with
+ * the smallest gap to its predecessor (the original image counts as one
+ * at position -1) is dropped first, oldest first on ties.
+ *
+ * Delta coding is per row, so rows are independent (OpenMP over rows in
+ * both directions).
+ *
+ * @see EditHistory.hpp for the model
+ * @author Rowan HOUPA
+ * @date January 2026
+ */
+
+#include "EditHistory.hpp"
+#include "LZCodec.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+    constexpr size_t MAX_STEPS = 500;
+    constexpr size_t FILTER_BYTES = 256;    // Estimate per filter clone (overlays are shared)
+}
+
+EditHistory::EditHistory(size_t maxBytes) : maxBytes(maxBytes) {
+    compressionThread = std::thread(&EditHistory::compressionLoop, this);
+}
+
+EditHistory::~EditHistory() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    compressionReady.notify_all();
+    compressionThread.join();
+}
+
+void EditHistory::reset(std::shared_ptr<const Image> newOriginal, const FilterPipeline& pipeline) {
+    std::lock_guard<std::mutex> lock(mutex);
+    original = std::move(newOriginal);
+    head = pipeline;
+    steps.clear();
+    snapshots.clear();
+    compressionQueue.clear();
+    current = 0;
+    mergeOpen = false;
+    ++revision;
+}
+
+void EditHistory::splice(FilterPipeline& pipeline, size_t position, size_t count,
+                         const std::vector<std::unique_ptr<Filter>>& filters) {
+    for (size_t i = 0; i < count; ++i) {
+        pipeline.removeFilter(position);
+    }
+    for (size_t i = 0; i < filters.size(); ++i) {
+        pipeline.insertFilter(position + i, filters[i]->clone());
+    }
+}
+
+void EditHistory::record(const FilterPipeline& pipeline, size_t position, size_t removed, size_t inserted,
+                         const std::string& label, const std::string& mergeKey) {
+    std::lock_guard<std::mutex> lock(mutex);
+    ++revision;
+
+    // A new edit after undo: the redo branch is gone
+    if (current < steps.size()) {
+        steps.erase(steps.begin() + current, steps.end());
+        std::erase_if(snapshots, [this](const auto& snapshot) { return snapshot->step > current; });
+    }
+
+    std::vector<std::unique_ptr<Filter>> after;
+    for (size_t i = position; i < position + inserted; ++i) {
+        after.push_back(pipeline.getFilter(i)->clone());
+    }
+
+    if (!mergeKey.empty() && mergeOpen && current > 0) {
+        Step& last = steps[current - 1];
+        if (last.mergeKey == mergeKey && last.position == position && last.after.size() == removed) {
+            splice(head, position, removed, after);
+            last.after = std::move(after);
+            // Snapshots of this position saw the previous value
+            std::erase_if(snapshots, [this, position](const auto& snapshot) {
+                return snapshot->step == current && snapshot->prefix > position;
+            });
+            return;
+        }
+    }
+
+    Step step{position, {}, std::move(after), label, mergeKey};
+    for (size_t i = position; i < position + removed; ++i) {
+        step.before.push_back(head.getFilter(i)->clone());
+    }
+    splice(head, position, removed, step.after);
+    steps.push_back(std::move(step));
+    ++current;
+    mergeOpen = true;
+
+    if (steps.size() > MAX_STEPS) {
+        dropStepLocked();
+    }
+    enforceCapLocked();
+}
+
+bool EditHistory::canUndo() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return current > 0;
+}
+
+bool EditHistory::canRedo() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return current < steps.size();
+}
+
+std::string EditHistory::undoLabel() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return current > 0 ? steps[current - 1].label : std::string();
+}
+
+std::string EditHistory::redoLabel() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return current < steps.size() ? steps[current].label : std::string();
+}
+
+bool EditHistory::undo() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (current == 0) return false;
+    const Step& step = steps[current - 1];
+    splice(head, step.position, step.after.size(), step.before);
+    --current;
+    mergeOpen = false;
+    ++revision;
+    return true;
+}
+
+bool EditHistory::redo() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (current >= steps.size()) return false;
+    const Step& step = steps[current];
+    splice(head, step.position, step.before.size(), step.after);
+    ++current;
+    mergeOpen = false;
+    ++revision;
+    return true;
+}
+
+FilterPipeline EditHistory::getPipeline() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return head;
+}
+
+uint64_t EditHistory::getRevision() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return revision;
+}
+
+bool EditHistory::addSnapshot(const Image& result, uint64_t resultRevision) {
+    if (result.size() == 0 || result.size() > maxBytes) {
+        return false;
+    }
+    auto snapshot = std::make_shared<Snapshot>();
+    snapshot->width = result.getWidth();
+    snapshot->height = result.getHeight();
+    snapshot->channels = result.getChannels();
+    snapshot->raw = std::make_shared<const Image>(result);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (resultRevision != revision) {
+            return false;
+        }
+        snapshot->step = current;
+        snapshot->prefix = head.size();
+        std::erase_if(snapshots, [&](const auto& other) {
+            return other->step == current && other->prefix == snapshot->prefix;
+        });
+        snapshots.push_back(snapshot);
+        compressionQueue.push_back(snapshot);
+        enforceCapLocked();
+    }
+    compressionReady.notify_one();
+    return true;
+}
+
+bool EditHistory::usableLocked(const Snapshot& snapshot) const {
+    if (snapshot.prefix > head.size()) return false;
+    const size_t from = std::min(snapshot.step, current);
+    const size_t to = std::max(snapshot.step, current);
+    for (size_t i = from; i < to; ++i) {
+        if (steps[i].position < snapshot.prefix) return false;
+    }
+    return true;
+}
+
+EditHistory::ReplayBase EditHistory::replayBase() const {
+    std::shared_ptr<Snapshot> best;
+    std::shared_ptr<const Image> raw;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        size_t bestDistance = 0;
+        for (const auto& snapshot : snapshots) {
+            if (snapshot->prefix == 0 || !usableLocked(*snapshot)) continue;
+            const size_t distance = snapshot->step > current ? snapshot->step - current
+                                                              : current - snapshot->step;
+            if (!best || snapshot->prefix > best->prefix ||
+                (snapshot->prefix == best->prefix && distance < bestDistance)) {
+                best = snapshot;
+                bestDistance = distance;
+            }
+        }
+        if (!best) {
+            return {original, 0};
+        }
+        raw = best->raw;
+    }
+    // Once raw is gone, packed is final: decode without the lock
+    if (raw) {
+        return {raw, best->prefix};
+    }
+    return {std::make_shared<const Image>(unpack(*best)), best->prefix};
+}
+
+EditHistory::Stats EditHistory::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    Stats stats;
+    stats.steps = steps.size();
+    stats.position = current;
+    stats.snapshots = snapshots.size();
+    for (const auto& snapshot : snapshots) {
+        if (snapshot->raw) {
+            ++stats.pendingSnapshots;
+            stats.snapshotBytes += snapshot->raw->size();
+        } else {
+            stats.snapshotBytes += snapshot->packed.size();
+        }
+        stats.snapshotRawBytes += static_cast<size_t>(snapshot->width) * snapshot->height * snapshot->channels;
+    }
+    stats.diffBytes = diffBytesLocked();
+    return stats;
+}
+
+size_t EditHistory::diffBytesLocked() const {
+    size_t bytes = 0;
+    for (const Step& step : steps) {
+        bytes += sizeof(Step) + (step.before.size() + step.after.size()) * FILTER_BYTES +
+                 step.label.size() + step.mergeKey.size();
+    }
+    return bytes;
+}
+
+size_t EditHistory::bytesLocked() const {
+    size_t bytes = diffBytesLocked();
+    for (const auto& snapshot : snapshots) {
+        bytes += snapshot->raw ? snapshot->raw->size() : snapshot->packed.size();
+    }
+    return bytes;
+}
+
+void EditHistory::dropStepLocked() {
+    if (steps.empty()) return;
+    if (current == 0) {
+        // Everything is redo: the farthest step goes
+        steps.pop_back();
+        std::erase_if(snapshots, [this](const auto& snapshot) { return snapshot->step > steps.size(); });
+        return;
+    }
+    // Position 0 disappears; the original image stays the k = 0 fallback
+    steps.erase(steps.begin());
+    std::erase_if(snapshots, [](const auto& snapshot) { return snapshot->step == 0; });
+    for (auto& snapshot : snapshots) {
+        --snapshot->step;
+    }
+    --current;
+}
+
+void EditHistory::enforceCapLocked() {
+    while (bytesLocked() > maxBytes) {
+        if (!snapshots.empty() && diffBytesLocked() <= maxBytes) {
+            std::stable_sort(snapshots.begin(), snapshots.end(),
+                             [](const auto& a, const auto& b) { return a->step < b->step; });
+            size_t victim = 0;
+            size_t smallestGap = SIZE_MAX;
+            for (size_t i = 0; i < snapshots.size(); ++i) {
+                const size_t gap = i == 0 ? snapshots[i]->step + 1 : snapshots[i]->step - snapshots[i - 1]->step;
+                if (gap < smallestGap) {
+                    smallestGap = gap;
+                    victim = i;
+                }
+            }
+            snapshots.erase(snapshots.begin() + victim);
+        } else if (!steps.empty()) {
+            dropStepLocked();
+        } else {
+            break;
+        }
+    }
+}
+
+std::vector<uint8_t> EditHistory::pack(const Image& image) {
+    const int height = image.getHeight();
+    const int channels = image.getChannels();
+    const int rowValues = image.getWidth() * channels;
+    const uint8_t* src = image.data();
+    std::vector<uint8_t> delta(image.size());
+    uint8_t* dst = delta.data();
+
+    #pragma omp parallel for schedule(static)
+    for (int y = 0; y < height; ++y) {
+        const uint8_t* in = src + static_cast<size_t>(y) * rowValues;
+        uint8_t* out = dst + static_cast<size_t>(y) * rowValues;
+        for (int i = 0; i < std::min(channels, rowValues); ++i) {
+            out[i] = in[i];
+        }
+        #pragma omp simd
+        for (int i = channels; i < rowValues; ++i) {
+            out[i] = static_cast<uint8_t>(in[i] - in[i - channels]);
+        }
+    }
+    return LZCodec::compress(delta.data(), delta.size());
+}
+
+Image EditHistory::unpack(const Snapshot& snapshot) {
+    Image image(snapshot.width, snapshot.height, snapshot.channels);
+    if (!LZCodec::decompress(snapshot.packed, image.data(), image.size())) {
+        throw std::runtime_error("EditHistory: corrupt snapshot");
+    }
+    const int channels = snapshot.channels;
+    const int rowValues = snapshot.width * channels;
+    uint8_t* data = image.data();
+
+    #pragma omp parallel for schedule(static)
+    for (int y = 0; y < snapshot.height; ++y) {
+        uint8_t* row = data + static_cast<size_t>(y) * rowValues;
+        for (int i = channels; i < rowValues; ++i) {
+            row[i] = static_cast<uint8_t>(row[i] + row[i - channels]);
+        }
+    }
+    return image;
+}
+
+void EditHistory::compressionLoop() {
+    for (;;) {
+        std::shared_ptr<Snapshot> snapshot;
+        std::shared_ptr<const Image> raw;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            compressionReady.wait(lock, [this] { return stopping || !compressionQueue.empty(); });
+            if (stopping) return;
+            snapshot = std::move(compressionQueue.front());
+            compressionQueue.pop_front();
+            if (std::find(snapshots.begin(), snapshots.end(), snapshot) == snapshots.end()) {
+                continue;   // Thinned or reset before its turn
+            }
+            raw = snapshot->raw;
+        }
+
+        std::vector<uint8_t> packed = pack(*raw);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        snapshot->packed = std::move(packed);
+        snapshot->raw.reset();
+        enforceCapLocked();
+    }
+}
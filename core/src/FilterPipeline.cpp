@@ -18,6 +18,10 @@
  * - Uses two-buffer technique: result and temp images
  * - Minimizes allocations by reusing buffers between filter steps
  * - Move semantics prevent unnecessary copies
+ * - Filters declaring supportsInPlace() mutate the current buffer directly,
+ *   so apply(Image&&) runs point-wise chains without any allocation
+ * - applyRegion(): crop with halo margins (clipped to the image, so image
+ *   borders behave as in a full pass), filter, crop the margins away
  *
  * @see FilterPipeline.hpp for class declaration
  * @author Rowan HOUPA
@@ -35,7 +39,8 @@
 #include <algorithm>
 #include <memory>
 
-FilterPipeline::FilterPipeline(const FilterPipeline& other) {
+FilterPipeline::FilterPipeline(const FilterPipeline& other)
+    : processingMode(other.processingMode), inPlaceEnabled(other.inPlaceEnabled), profile(other.profile) {
     for (const auto& filter : other.filters) {
         filters.push_back(filter->clone());
     }
@@ -43,6 +48,9 @@ FilterPipeline::FilterPipeline(const FilterPipeline& other) {
 
 FilterPipeline& FilterPipeline::operator=(const FilterPipeline& other) {
     if (this != &other) {
+        processingMode = other.processingMode;
+        inPlaceEnabled = other.inPlaceEnabled;
+        profile = other.profile;
         filters.clear();
         for (const auto& filter : other.filters) {
             filters.push_back(filter->clone());
@@ -91,19 +99,63 @@ void FilterPipeline::clear() {
     filters.clear();
 }
 
+size_t FilterPipeline::applyStep(size_t index, Image& image) const {
+    Filter& filter = *filters[index];
+    Filter::takeReportedDevice();   // Whatever an earlier call left on this thread
+    const Clock::time_point start = Clock::now();
+    size_t saved = 0;
+    if (inPlaceEnabled && filter.supportsInPlace()) {
+        filter.applyInPlace(image);
+        saved = image.size();
+    } else {
+        Image temp = std::move(image);
+        filter.apply(temp, image);
+    }
+    recordStep(index, start, image);
+    return saved;
+}
+
+void FilterPipeline::recordStep(size_t index, Clock::time_point start, const Image& output) const {
+    if (profile) {
+        const double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        profile->recordFilter(index, filters[index]->getName(), Filter::takeReportedDevice(), ms,
+                              static_cast<uint64_t>(output.getWidth()) * output.getHeight());
+    }
+}
+
+void FilterPipeline::recordRun(Clock::time_point start, const Image& output) const {
+    if (profile) {
+        const double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        profile->recordRun(ms, static_cast<uint64_t>(output.getWidth()) * output.getHeight(), filters.size());
+    }
+}
+
 Image FilterPipeline::apply(const Image& input) const {
     if (filters.empty()) {
         return input;
     }
     
-    Image result = input;
-    Image temp; 
+    lastBytesSavedInPlace = 0;
+    const Clock::time_point start = Clock::now();
     
-    for (const auto& filter : filters) {
-        temp = std::move(result);
-        filter->apply(temp, result); 
+    // An out-of-place first filter reads the caller's image directly,
+    // an in-place one needs its own copy to mutate
+    Image result;
+    size_t first = 0;
+    if (inPlaceEnabled && filters.front()->supportsInPlace()) {
+        result = input;
+    } else {
+        Filter::takeReportedDevice();
+        filters.front()->apply(input, result);
+        recordStep(0, start, result);
+        first = 1;
+    }
+    
+    for (size_t i = first; i < filters.size(); ++i) {
+        lastBytesSavedInPlace += applyStep(i, result);
     }
     
+    recordRun(start, result);
     return result;
 }
 
@@ -112,17 +164,73 @@ Image FilterPipeline::apply(Image&& input) const {
         return std::move(input);
     }
     
+    lastBytesSavedInPlace = 0;
+    const Clock::time_point start = Clock::now();
     Image result = std::move(input);
-    Image temp;
     
-    for (const auto& filter : filters) {
-        temp = std::move(result);
-        filter->apply(temp, result);
+    for (size_t i = 0; i < filters.size(); ++i) {
+        lastBytesSavedInPlace += applyStep(i, result);
     }
     
+    recordRun(start, result);
     return result;
 }
 
+Image FilterPipeline::applyRegion(const Image& input, int x, int y, int width, int height) const {
+    const int halo = getHaloRadius();
+    if (halo < 0) {
+        Image full = apply(input);
+        if (full.getWidth() != input.getWidth() || full.getHeight() != input.getHeight()) {
+            throw std::invalid_argument("FilterPipeline::applyRegion: pipeline changes the image size");
+        }
+        return full.crop(x, y, width, height);
+    }
+    
+    const int x0 = std::max(0, x - halo);
+    const int y0 = std::max(0, y - halo);
+    const int x1 = std::min(input.getWidth(), x + width + halo);
+    const int y1 = std::min(input.getHeight(), y + height + halo);
+    if (x0 == 0 && y0 == 0 && x1 == input.getWidth() && y1 == input.getHeight() &&
+        width == input.getWidth() && height == input.getHeight()) {
+        return apply(input);
+    }
+    
+    Image result = apply(input.crop(x0, y0, x1 - x0, y1 - y0));
+    if (result.getWidth() != x1 - x0 || result.getHeight() != y1 - y0) {
+        throw std::invalid_argument("FilterPipeline::applyRegion: pipeline changes the image size");
+    }
+    if (x0 == x && y0 == y && result.getWidth() == width && result.getHeight() == height) {
+        return result;
+    }
+    return result.crop(x - x0, y - y0, width, height);
+}
+
+FilterPipeline::PipelineMetrics FilterPipeline::applyWithMetrics(const Image& input) {
+    PipelineMetrics metrics{};
+    metrics.gpuUsed = false;
+    
+    const Clock::time_point runStart = Clock::now();
+    auto totalStart = std::chrono::high_resolution_clock::now();
+    Image result = input;
+    
+    for (size_t i = 0; i < filters.size(); ++i) {
+        auto start = std::chrono::high_resolution_clock::now();
+        metrics.bytesSavedInPlace += applyStep(i, result);
+        auto end = std::chrono::high_resolution_clock::now();
+        
+        metrics.filterTimes.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+        metrics.filterNames.push_back(filters[i]->getName());
+        metrics.gpuUsed = metrics.gpuUsed || filters[i]->supportsGPU();
+    }
+    
+    auto totalEnd = std::chrono::high_resolution_clock::now();
+    metrics.totalTimeMs = std::chrono::duration<double, std::milli>(totalEnd - totalStart).count();
+    lastBytesSavedInPlace = metrics.bytesSavedInPlace;
+    recordRun(runStart, result);
+    
+    return metrics;
+}
+
 const Filter* FilterPipeline::getFilter(size_t index) const {
     if (index >= filters.size()) {
         throw std::out_of_range("FilterPipeline::getFilter: index out of range");
@@ -134,6 +242,16 @@ Filter* FilterPipeline::getFilter(size_t index) {
     return const_cast<Filter*>(static_cast<const FilterPipeline*>(this)->getFilter(index));
 }
 
+int FilterPipeline::getHaloRadius() const {
+    int halo = 0;
+    for (const auto& filter : filters) {
+        const int radius = filter->getHaloRadius();
+        if (radius < 0) return -1;
+        halo += radius;
+    }
+    return halo;
+}
+
 std::string FilterPipeline::toString() const {
     std::ostringstream oss;
     oss << "FilterPipeline[" << filters.size() << "]:\n";
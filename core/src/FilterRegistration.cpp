@@ -38,6 +38,16 @@
 #include "filters/BoxBlurFilter.hpp"
 #include "filters/BoxBlurFilterGPU.hpp"
 #include "filters/SepiaFilter.hpp"
+#include "filters/BlendFilter.hpp"
+#include "filters/BlendFilterGPU.hpp"
+#include "filters/WarpFilter.hpp"
+#include "filters/WarpFilterGPU.hpp"
+#include "filters/NLMeansFilter.hpp"
+#include "filters/NLMeansFilterGPU.hpp"
+#include "filters/ThresholdFilter.hpp"
+#include "filters/ThresholdFilterGPU.hpp"
+#include "filters/DitherFilter.hpp"
+#include "filters/QuantizeFilter.hpp"
 #include <iostream>
 
 /**
@@ -51,7 +61,7 @@
  * No need to modify the GUI code!
  */
 void registerAllFilters() {
-    std::cout << "========== REGISTERING FILTERS ==========" << std::endl;
+    std::clog << "========== REGISTERING FILTERS ==========" << std::endl;
     auto& factory = FilterFactory::instance();
 
     // Grayscale filter
@@ -92,8 +102,74 @@ void registerAllFilters() {
         "Applique un effet ton sépia vintage"
     );
 
-    std::cout << "Total filters registered: " << factory.getFilterIds().size() << std::endl;
-    std::cout << "========== REGISTRATION COMPLETE ==========" << std::endl;
+    // Blend / composite filter (overlay image chosen by the GUI or CLI)
+    factory.registerParameterizedFilterWithGPU<BlendFilter, BlendFilterGPU>(
+        "blend",
+        "Fusion / Filigrane",
+        "Superpose une image (filigrane) avec alpha et modes de fusion",
+        []() { return std::make_unique<BlendFilter>(); },
+        []() { return std::make_unique<BlendFilterGPU>(); }
+    );
+
+    // Rotation / deskew (angle chosen by the GUI or CLI)
+    factory.registerParameterizedFilterWithGPU<WarpFilter, WarpFilterGPU>(
+        "rotate",
+        "Rotation / Redressement",
+        "Fait pivoter l'image autour de son centre (redressement de documents)",
+        []() { return std::make_unique<WarpFilter>(WarpFilter::rotation(0.0)); },
+        []() { return std::make_unique<WarpFilterGPU>(WarpFilter::rotation(0.0)); }
+    );
+
+    // Non-local means denoising (strength chosen by the CLI)
+    factory.registerParameterizedFilterWithGPU<NLMeansFilter, NLMeansFilterGPU>(
+        "nlmeans",
+        "Débruitage NL-Means",
+        "Réduit le bruit en préservant les contours et les textures",
+        []() { return std::make_unique<NLMeansFilter>(10.0f, 2, 7); },
+        []() { return std::make_unique<NLMeansFilterGPU>(10.0f, 2, 7); }
+    );
+
+    // Document binarization: fixed, Otsu and adaptive thresholds
+    factory.registerParameterizedFilterWithGPU<ThresholdFilter, ThresholdFilterGPU>(
+        "threshold",
+        "Seuil",
+        "Binarise l'image avec un seuil fixe",
+        []() { return std::make_unique<ThresholdFilter>(128); },
+        []() { return std::make_unique<ThresholdFilterGPU>(128); }
+    );
+
+    factory.registerFilterWithGPU<OtsuThresholdFilter, OtsuThresholdFilterGPU>(
+        "otsu",
+        "Seuil Otsu",
+        "Binarise l'image avec un seuil global calculé automatiquement (Otsu)"
+    );
+
+    factory.registerParameterizedFilterWithGPU<AdaptiveThresholdFilter, AdaptiveThresholdFilterGPU>(
+        "adaptive",
+        "Seuil Adaptatif",
+        "Binarise les documents numérisés avec un seuil local (Sauvola)",
+        []() { return std::make_unique<AdaptiveThresholdFilter>(AdaptiveMethod::Sauvola); },
+        []() { return std::make_unique<AdaptiveThresholdFilterGPU>(AdaptiveMethod::Sauvola); }
+    );
+
+    // Dithering to a few levels per channel (mode chosen by the CLI)
+    factory.registerParameterizedFilter<DitherFilter>(
+        "dither",
+        "Tramage",
+        "Réduit le nombre de niveaux par canal (Floyd-Steinberg ou Bayer)",
+        []() { return std::make_unique<DitherFilter>(DitherMode::FloydSteinberg, 2); }
+    );
+
+    // Palette reduction for compact indexed PNG output
+    factory.registerParameterizedFilter<QuantizeFilter>(
+        "quantize",
+        "Quantification",
+        "Réduit l'image à une palette de 256 couleurs (k-means)",
+        []() { return std::make_unique<QuantizeFilter>(QuantizeMethod::KMeans, 256); }
+    );
+
+    std::clog << "Total filters registered: " << factory.getFilterIds().size() << std::endl;
+    std::clog << "========== REGISTRATION COMPLETE ==========" << std::endl;
 }
 namespace {
     struct FilterRegistrar {
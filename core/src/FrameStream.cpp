@@ -0,0 +1,436 @@
+/**
+ * @file FrameStream.cpp
+ * @brief Y4M / raw frame I/O and the threaded decode-filter-encode pipeline
+ *
+ * @details
+ * YUV <-> RGB, BT.601 limited range, 8.8 fixed point:
+ *   R = (298 (Y - 16) + 409 (V - 128) + 128) >> 8
+ *   G = (298 (Y - 16) - 100 (U - 128) - 208 (V - 128) + 128) >> 8
+ *   B = (298 (Y - 16) + 516 (U - 128) + 128) >> 8
+ *   Y = ((66 R + 129 G + 25 B + 128) >> 8) + 16
+ *   U = ((-38 R - 74 G + 112 B + 128) >> 8) + 128
+ *   V = ((112 R - 94 G - 18 B + 128) >> 8) + 128
+ * 4:2:0 output averages the RGB of each 2x2 block before computing U, V.
+ *
+ * Threading (FrameStream::run):
+ *   free pool → [reader thread] → decoded → [caller thread: pipeline]
+ *             → filtered → [writer thread] → free pool
+ * Every queue is FIFO and each stage has a single thread, so output order
+ * equals input order. A failing stage closes every queue; the others drain
+ * and stop.
+ *
+ * @see FrameStream.hpp for formats and buffer reuse
+ * @author Rowan HOUPA
+ * @date January 2026
+ */
+
+#include "FrameStream.hpp"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <thread>
+
+namespace {
+
+// Unbounded FIFO; the fixed number of buffers in flight bounds its size
+template<typename T>
+class Channel {
+public:
+    void push(T value) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (closed) return;
+            items.push_back(std::move(value));
+        }
+        ready.notify_one();
+    }
+
+    // Waits for an item; empty once the channel is closed and drained
+    std::optional<T> pop() {
+        std::unique_lock<std::mutex> lock(mutex);
+        ready.wait(lock, [this] { return closed || !items.empty(); });
+        if (items.empty()) return std::nullopt;
+        T value = std::move(items.front());
+        items.pop_front();
+        return value;
+    }
+
+    void close() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            closed = true;
+        }
+        ready.notify_all();
+    }
+
+private:
+    std::deque<T> items;
+    std::mutex mutex;
+    std::condition_variable ready;
+    bool closed = false;
+};
+
+inline uint8_t clampByte(int value) {
+    return static_cast<uint8_t>(std::clamp(value, 0, 255));
+}
+
+inline int chromaWidth(int width, FrameReader::Chroma chroma) {
+    return chroma == FrameReader::Chroma::C420 ? (width + 1) / 2 : width;
+}
+
+inline int chromaHeight(int height, FrameReader::Chroma chroma) {
+    return chroma == FrameReader::Chroma::C420 ? (height + 1) / 2 : height;
+}
+
+inline size_t chromaPlaneSize(int width, int height, FrameReader::Chroma chroma) {
+    if (chroma == FrameReader::Chroma::Mono) return 0;
+    return static_cast<size_t>(chromaWidth(width, chroma)) * chromaHeight(height, chroma);
+}
+
+// Reads up to '\n' (excluded); false at end of file before any character
+bool readLine(std::FILE* file, std::string& line) {
+    line.clear();
+    int c;
+    while ((c = std::fgetc(file)) != EOF && c != '\n') {
+        line.push_back(static_cast<char>(c));
+    }
+    return c != EOF || !line.empty();
+}
+
+// RGB of pixel p of a 1-4 channel row
+inline void pixelRGB(const uint8_t* p, int channels, int& r, int& g, int& b) {
+    if (channels < 3) {
+        r = g = b = p[0];
+    } else {
+        r = p[0]; g = p[1]; b = p[2];
+    }
+}
+
+} // namespace
+
+// ============================================================================
+// FrameReader
+// ============================================================================
+
+FrameReader::FrameReader(std::FILE* file, FrameFormat format, int width, int height)
+    : file(file), format(format), width(width), height(height) {}
+
+bool FrameReader::open() {
+    if (!file) {
+        error = "flux d'entrée invalide";
+        return false;
+    }
+    if (format != FrameFormat::Y4M) {
+        if (width <= 0 || height <= 0) {
+            error = "taille de trame requise pour le format brut";
+            return false;
+        }
+        return true;
+    }
+
+    std::string line;
+    if (!readLine(file, line) || line.rfind("YUV4MPEG2", 0) != 0) {
+        error = "en-tête YUV4MPEG2 manquant";
+        return false;
+    }
+
+    std::istringstream tokens(line.substr(9));
+    std::string token;
+    while (tokens >> token) {
+        switch (token[0]) {
+        case 'W': width = std::atoi(token.c_str() + 1); break;
+        case 'H': height = std::atoi(token.c_str() + 1); break;
+        case 'C':
+            if (token.rfind("C420", 0) == 0) {
+                chroma = Chroma::C420;
+            } else if (token == "C444") {
+                chroma = Chroma::C444;
+            } else if (token == "Cmono") {
+                chroma = Chroma::Mono;
+            } else {
+                error = "sous-échantillonnage non supporté: " + token;
+                return false;
+            }
+            break;
+        default:
+            parameters += (parameters.empty() ? "" : " ") + token;
+            break;
+        }
+    }
+
+    if (width <= 0 || height <= 0) {
+        error = "dimensions Y4M invalides";
+        return false;
+    }
+    return true;
+}
+
+bool FrameReader::readFrame(Image& frame) {
+    if (format == FrameFormat::Y4M) {
+        return readY4MFrame(frame);
+    }
+
+    const int channels = format == FrameFormat::RawRGBA ? 4 : 3;
+    if (frame.getWidth() != width || frame.getHeight() != height || frame.getChannels() != channels) {
+        frame = Image(width, height, channels);
+    }
+
+    const size_t read = std::fread(frame.data(), 1, frame.size(), file);
+    if (read == frame.size()) return true;
+    if (read != 0) error = "trame brute incomplète";
+    return false;
+}
+
+bool FrameReader::readY4MFrame(Image& frame) {
+    std::string line;
+    if (!readLine(file, line)) return false;   // Clean end of stream
+    if (line.rfind("FRAME", 0) != 0) {
+        error = "marqueur FRAME attendu";
+        return false;
+    }
+
+    const size_t lumaSize = static_cast<size_t>(width) * height;
+    const size_t chromaSize = chromaPlaneSize(width, height, chroma);
+    planes.resize(lumaSize + 2 * chromaSize);
+    if (std::fread(planes.data(), 1, planes.size(), file) != planes.size()) {
+        error = "trame Y4M incomplète";
+        return false;
+    }
+
+    if (frame.getWidth() != width || frame.getHeight() != height || frame.getChannels() != 3) {
+        frame = Image(width, height, 3);
+    }
+
+    const uint8_t* lumaPlane = planes.data();
+    const uint8_t* uPlane = lumaPlane + lumaSize;
+    const uint8_t* vPlane = uPlane + chromaSize;
+    const int cw = chromaWidth(width, chroma);
+    const int shift = chroma == Chroma::C420 ? 1 : 0;
+    const bool mono = chroma == Chroma::Mono;
+    uint8_t* dst = frame.data();
+
+    #pragma omp parallel for schedule(static)
+    for (int y = 0; y < height; ++y) {
+        const uint8_t* yRow = lumaPlane + static_cast<size_t>(y) * width;
+        const size_t chromaRow = static_cast<size_t>(y >> shift) * cw;
+        uint8_t* out = dst + static_cast<size_t>(y) * width * 3;
+
+        for (int x = 0; x < width; ++x) {
+            const int c = 298 * (yRow[x] - 16);
+            const int d = mono ? 0 : uPlane[chromaRow + (x >> shift)] - 128;
+            const int e = mono ? 0 : vPlane[chromaRow + (x >> shift)] - 128;
+            out[x * 3 + 0] = clampByte((c + 409 * e + 128) >> 8);
+            out[x * 3 + 1] = clampByte((c - 100 * d - 208 * e + 128) >> 8);
+            out[x * 3 + 2] = clampByte((c + 516 * d + 128) >> 8);
+        }
+    }
+    return true;
+}
+
+// ============================================================================
+// FrameWriter
+// ============================================================================
+
+FrameWriter::FrameWriter(std::FILE* file, FrameFormat format, FrameReader::Chroma chroma,
+                         const std::string& parameters)
+    : file(file), format(format), chroma(chroma), parameters(parameters) {}
+
+bool FrameWriter::writeFrame(const Image& frame) {
+    const int frameWidth = frame.getWidth();
+    const int frameHeight = frame.getHeight();
+    const int channels = frame.getChannels();
+
+    if (width == 0) {
+        width = frameWidth;
+        height = frameHeight;
+        if (format == FrameFormat::Y4M) {
+            const char* layout = chroma == FrameReader::Chroma::C444 ? "C444"
+                               : chroma == FrameReader::Chroma::Mono ? "Cmono" : "C420jpeg";
+            std::string header = "YUV4MPEG2 W" + std::to_string(width) + " H" + std::to_string(height) +
+                                 (parameters.empty() ? "" : " " + parameters) + " " + layout + "\n";
+            std::fwrite(header.data(), 1, header.size(), file);
+        }
+    } else if (frameWidth != width || frameHeight != height) {
+        error = "toutes les trames doivent avoir la même taille";
+        return false;
+    }
+
+    const uint8_t* src = frame.data();
+    const size_t rowValues = static_cast<size_t>(width) * channels;
+
+    if (format != FrameFormat::Y4M) {
+        const int outChannels = format == FrameFormat::RawRGBA ? 4 : 3;
+        const uint8_t* data = src;
+        if (channels != outChannels) {
+            scratch.resize(static_cast<size_t>(width) * height * outChannels);
+            uint8_t* dst = scratch.data();
+
+            #pragma omp parallel for schedule(static)
+            for (int y = 0; y < height; ++y) {
+                const uint8_t* in = src + y * rowValues;
+                uint8_t* out = dst + static_cast<size_t>(y) * width * outChannels;
+                for (int x = 0; x < width; ++x) {
+                    int r, g, b;
+                    pixelRGB(in + x * channels, channels, r, g, b);
+                    out[x * outChannels + 0] = static_cast<uint8_t>(r);
+                    out[x * outChannels + 1] = static_cast<uint8_t>(g);
+                    out[x * outChannels + 2] = static_cast<uint8_t>(b);
+                    if (outChannels == 4) {
+                        const bool hasAlpha = (channels == 2 || channels == 4);
+                        out[x * 4 + 3] = hasAlpha ? in[x * channels + channels - 1] : 255;
+                    }
+                }
+            }
+            data = dst;
+        }
+        const size_t bytes = static_cast<size_t>(width) * height * outChannels;
+        if (std::fwrite(data, 1, bytes, file) != bytes) {
+            error = "écriture de la trame impossible";
+            return false;
+        }
+        return true;
+    }
+
+    // Y4M: RGB → Y'CbCr planes
+    const size_t lumaSize = static_cast<size_t>(width) * height;
+    const size_t chromaSize = chromaPlaneSize(width, height, chroma);
+    scratch.resize(lumaSize + 2 * chromaSize);
+    uint8_t* lumaPlane = scratch.data();
+    uint8_t* uPlane = lumaPlane + lumaSize;
+    uint8_t* vPlane = uPlane + chromaSize;
+    const int cw = chromaWidth(width, chroma);
+    const int ch = chromaHeight(height, chroma);
+    const int block = chroma == FrameReader::Chroma::C420 ? 2 : 1;
+
+    #pragma omp parallel for schedule(static)
+    for (int y = 0; y < height; ++y) {
+        const uint8_t* in = src + y * rowValues;
+        uint8_t* out = lumaPlane + static_cast<size_t>(y) * width;
+        for (int x = 0; x < width; ++x) {
+            int r, g, b;
+            pixelRGB(in + x * channels, channels, r, g, b);
+            out[x] = static_cast<uint8_t>(((66 * r + 129 * g + 25 * b + 128) >> 8) + 16);
+        }
+    }
+
+    if (chroma != FrameReader::Chroma::Mono) {
+        #pragma omp parallel for schedule(static)
+        for (int cy = 0; cy < ch; ++cy) {
+            const int y0 = cy * block;
+            const int y1 = std::min(height, y0 + block);
+            for (int cx = 0; cx < cw; ++cx) {
+                const int x0 = cx * block;
+                const int x1 = std::min(width, x0 + block);
+                int sr = 0, sg = 0, sb = 0;
+                for (int y = y0; y < y1; ++y) {
+                    for (int x = x0; x < x1; ++x) {
+                        int r, g, b;
+                        pixelRGB(src + y * rowValues + x * channels, channels, r, g, b);
+                        sr += r; sg += g; sb += b;
+                    }
+                }
+                const int n = (y1 - y0) * (x1 - x0);
+                const int r = (sr + n / 2) / n;
+                const int g = (sg + n / 2) / n;
+                const int b = (sb + n / 2) / n;
+                const size_t i = static_cast<size_t>(cy) * cw + cx;
+                uPlane[i] = static_cast<uint8_t>(((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128);
+                vPlane[i] = static_cast<uint8_t>(((112 * r - 94 * g - 18 * b + 128) >> 8) + 128);
+            }
+        }
+    }
+
+    static const char marker[] = "FRAME\n";
+    std::fwrite(marker, 1, sizeof(marker) - 1, file);
+    if (std::fwrite(scratch.data(), 1, scratch.size(), file) != scratch.size()) {
+        error = "écriture de la trame impossible";
+        return false;
+    }
+    return true;
+}
+
+// ============================================================================
+// FrameStream
+// ============================================================================
+
+StreamStats FrameStream::run(FrameReader& reader, FrameWriter& writer, const FilterPipeline& pipeline,
+                             int slots) {
+    return run(reader, writer, [&pipeline](Image&& frame) { return pipeline.apply(std::move(frame)); },
+               slots);
+}
+
+StreamStats FrameStream::run(FrameReader& reader, FrameWriter& writer,
+                             const std::function<Image(Image&&)>& process, int slots) {
+    StreamStats stats;
+    auto start = std::chrono::high_resolution_clock::now();
+
+    Channel<Image> freeFrames;
+    Channel<Image> decoded;
+    Channel<Image> filtered;
+    for (int i = 0; i < std::max(2, slots); ++i) {
+        freeFrames.push(Image());
+    }
+
+    std::string readerError;
+    std::string writerError;
+
+    auto closeAll = [&] {
+        freeFrames.close();
+        decoded.close();
+        filtered.close();
+    };
+
+    std::thread decodeThread([&] {
+        while (auto frame = freeFrames.pop()) {
+            if (!reader.readFrame(*frame)) {
+                readerError = reader.getError();
+                break;
+            }
+            decoded.push(std::move(*frame));
+        }
+        // End of input: the filter stage drains what is queued, then stops
+        decoded.close();
+    });
+
+    std::thread encodeThread([&] {
+        while (auto frame = filtered.pop()) {
+            if (!writer.writeFrame(*frame)) {
+                writerError = writer.getError();
+                closeAll();
+                return;
+            }
+            freeFrames.push(std::move(*frame));
+        }
+        writer.flush();
+    });
+
+    std::string filterError;
+    while (auto frame = decoded.pop()) {
+        try {
+            auto filterStart = std::chrono::high_resolution_clock::now();
+            Image result = process(std::move(*frame));
+            auto filterEnd = std::chrono::high_resolution_clock::now();
+            stats.filterMs += std::chrono::duration<double, std::milli>(filterEnd - filterStart).count();
+            ++stats.frames;
+            filtered.push(std::move(result));
+        } catch (const std::exception& e) {
+            filterError = e.what();
+            closeAll();
+            break;
+        }
+    }
+    filtered.close();
+
+    decodeThread.join();
+    encodeThread.join();
+
+    stats.error = !filterError.empty() ? filterError
+                : !writerError.empty() ? writerError : readerError;
+    auto end = std::chrono::high_resolution_clock::now();
+    stats.totalMs = std::chrono::duration<double, std::milli>(end - start).count();
+    return stats;
+}
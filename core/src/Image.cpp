@@ -27,6 +27,8 @@
  */
 
 #include "Image.hpp"
+#include <algorithm>
+#include <cstdio>
 
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wunused-function"
@@ -60,6 +62,66 @@ bool Image::loadFromFile(const std::string& filepath) {
     return true;
 }
 
+namespace {
+    struct ProgressReader {
+        std::FILE* file;
+        long total;
+        long consumed;
+        int percent;
+        const std::function<void(int)>* progress;
+
+        void advance(long bytes) {
+            consumed += bytes;
+            const int now = total > 0 ? static_cast<int>(std::min(100L, consumed * 100 / total)) : 100;
+            if (now > percent) {
+                percent = now;
+                (*progress)(percent);
+            }
+        }
+    };
+
+    int readCallback(void* user, char* data, int size) {
+        auto* reader = static_cast<ProgressReader*>(user);
+        const int read = static_cast<int>(std::fread(data, 1, size, reader->file));
+        reader->advance(read);
+        return read;
+    }
+
+    // stb may also "unget" with a negative n
+    void skipCallback(void* user, int n) {
+        auto* reader = static_cast<ProgressReader*>(user);
+        std::fseek(reader->file, n, SEEK_CUR);
+        reader->advance(n);
+    }
+
+    int eofCallback(void* user) {
+        return std::feof(static_cast<ProgressReader*>(user)->file);
+    }
+}
+
+bool Image::loadFromFile(const std::string& filepath, const std::function<void(int)>& progress) {
+    std::FILE* file = std::fopen(filepath.c_str(), "rb");
+    if (!file) return false;
+    std::fseek(file, 0, SEEK_END);
+    ProgressReader reader{file, std::ftell(file), 0, -1, &progress};
+    std::fseek(file, 0, SEEK_SET);
+
+    const stbi_io_callbacks callbacks{readCallback, skipCallback, eofCallback};
+    int width, height, channels;
+    unsigned char* data = stbi_load_from_callbacks(&callbacks, &reader, &width, &height, &channels, 0);
+    std::fclose(file);
+
+    if (!data) return false;
+
+    m_width = width;
+    m_height = height;
+    m_channels = channels;
+    m_pixels.assign(data, data + static_cast<size_t>(width) * height * channels);
+
+    stbi_image_free(data);
+    return true;
+}
+
 bool Image::saveToFile(const std::string& filepath) const {
     std::string ext = filepath.substr(filepath.find_last_of(".") + 1);
     
@@ -88,6 +150,19 @@ const uint8_t& Image::at(int x, int y, int channel) const {
     return const_cast<Image*>(this)->at(x, y, channel);
 }
 
+Image Image::crop(int x, int y, int width, int height) const {
+    if (x < 0 || y < 0 || width <= 0 || height <= 0 || x + width > m_width || y + height > m_height) {
+        throw std::out_of_range("Image::crop: region out of range");
+    }
+    Image result(width, height, m_channels);
+    const size_t rowBytes = static_cast<size_t>(width) * m_channels;
+    for (int row = 0; row < height; ++row) {
+        std::copy_n(m_pixels.data() + (static_cast<size_t>(y + row) * m_width + x) * m_channels,
+                    rowBytes, result.m_pixels.data() + row * rowBytes);
+    }
+    return result;
+}
+
 void Image::stbiWriteFunc(void* context, void* data, int size) {
     (void)context;
     (void)data;
@@ -0,0 +1,387 @@
+/**
+ * @file ImageScanner.cpp
+ * @brief Threaded traversal, OpenMP probing and the scan index file
+ *
+ * @details
+ * The traversal threads only read the previous index and add finished
+ * folders to the new one under a lock; a folder's images are probed later,
+ * through pointers into the new index (std::unordered_map never moves its
+ * elements). The index is rewritten whole after each scan, through a
+ * temporary file and a rename; folders no longer reached drop out of it.
+ *
+ * @see ImageScanner.hpp for the reuse rules
+ * @author Rowan HOUPA
+ * @date January 2026
+ */
+
+#include "ImageScanner.hpp"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+
+#include <stb/stb_image.h>
+
+namespace fs = std::filesystem;
+
+namespace {
+    constexpr char MAGIC[4] = {'I', 'F', 'S', 'X'};
+    constexpr uint32_t VERSION = 1;
+
+    // 64-bit hash, 8 bytes per step
+    uint64_t hashBytes(const unsigned char* data, size_t size) {
+        uint64_t hash = 0x9e3779b97f4a7c15ull ^ (size * 0xff51afd7ed558ccdull);
+        size_t i = 0;
+        for (; i + 8 <= size; i += 8) {
+            uint64_t word;
+            std::memcpy(&word, data + i, 8);
+            hash ^= word * 0x9e3779b97f4a7c15ull;
+            hash = ((hash << 27) | (hash >> 37)) * 0xc4ceb9fe1a85ec53ull;
+        }
+        for (; i < size; ++i) {
+            hash = (hash ^ data[i]) * 1099511628211ull;
+        }
+        hash ^= hash >> 33;
+        hash *= 0xff51afd7ed558ccdull;
+        hash ^= hash >> 33;
+        return hash ? hash : 1;
+    }
+
+    void write32(std::string& out, uint32_t value) {
+        for (int k = 0; k < 4; ++k) out.push_back(static_cast<char>(value >> (8 * k)));
+    }
+
+    void write64(std::string& out, uint64_t value) {
+        for (int k = 0; k < 8; ++k) out.push_back(static_cast<char>(value >> (8 * k)));
+    }
+
+    void writeString(std::string& out, const std::string& text) {
+        write32(out, static_cast<uint32_t>(text.size()));
+        out += text;
+    }
+
+    // Bounds-checked reader over the index file
+    struct Reader {
+        const std::string& data;
+        size_t offset = 0;
+        bool ok = true;
+
+        uint64_t read(int bytes) {
+            if (!ok || data.size() - offset < static_cast<size_t>(bytes)) {
+                ok = false;
+                return 0;
+            }
+            uint64_t value = 0;
+            for (int k = 0; k < bytes; ++k) {
+                value |= static_cast<uint64_t>(static_cast<unsigned char>(data[offset + k])) << (8 * k);
+            }
+            offset += bytes;
+            return value;
+        }
+
+        std::string readString() {
+            const size_t length = read(4);
+            if (!ok || data.size() - offset < length) {
+                ok = false;
+                return {};
+            }
+            std::string text = data.substr(offset, length);
+            offset += length;
+            return text;
+        }
+    };
+
+    // Default index location, outside the scanned tree: saving the index
+    // there would change the time of the folder holding it on every scan
+    fs::path defaultIndexPath(const std::string& root) {
+        fs::path cache;
+        if (const char* xdg = std::getenv("XDG_CACHE_HOME"); xdg && *xdg) {
+            cache = fs::path(xdg) / "imageflow";
+        } else if (const char* home = std::getenv("HOME"); home && *home) {
+            cache = fs::path(home) / ".cache" / "imageflow";
+        } else {
+            std::error_code error;
+            cache = fs::temp_directory_path(error) / "imageflow";
+        }
+        std::error_code error;
+        const std::string absolute = fs::weakly_canonical(fs::absolute(root, error), error).string();
+        char name[32];
+        std::snprintf(name, sizeof(name), "scan-%016llx.idx",
+                      static_cast<unsigned long long>(
+                          hashBytes(reinterpret_cast<const unsigned char*>(absolute.data()), absolute.size())));
+        return cache / name;
+    }
+
+    // Fills width/height/channels (and contentHash); returns the bytes read
+    uint64_t probe(const fs::path& path, ScannedImage& image, bool hashContents) {
+        int width = 0, height = 0, channels = 0;
+        uint64_t bytes = 0;
+        if (hashContents) {
+            std::ifstream in(path, std::ios::binary);
+            std::vector<unsigned char> data(image.size);
+            if (in && in.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size()))) {
+                bytes = data.size();
+                image.contentHash = hashBytes(data.data(), data.size());
+                const int header = static_cast<int>(std::min<size_t>(data.size(), INT_MAX));
+                if (!stbi_info_from_memory(data.data(), header, &width, &height, &channels)) {
+                    width = height = channels = 0;
+                }
+            }
+        } else if (!stbi_info(path.string().c_str(), &width, &height, &channels)) {
+            width = height = channels = 0;
+        }
+        image.width = width;
+        image.height = height;
+        image.channels = channels;
+        return bytes;
+    }
+}
+
+ImageScanner::ImageScanner(std::string root, std::string indexPath)
+    : root(std::move(root)), indexPath(std::move(indexPath)) {
+    if (this->indexPath.empty()) {
+        this->indexPath = defaultIndexPath(this->root).string();
+    }
+}
+
+bool ImageScanner::isImagePath(const std::string& path) {
+    static const std::unordered_set<std::string> extensions = {".png", ".jpg", ".jpeg", ".bmp", ".tga"};
+    std::string extension = fs::path(path).extension().string();
+    if (extension.size() > 5) return false;
+    std::transform(extension.begin(), extension.end(), extension.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return extensions.count(extension) > 0;
+}
+
+std::vector<ScannedImage> ImageScanner::scan() {
+    const auto start = std::chrono::steady_clock::now();
+    stats = Stats{};
+    if (index.empty()) {
+        loadIndex();
+    }
+    const fs::path rootPath(root);
+
+    struct Probe {
+        const std::string* directory;
+        ScannedImage* image;
+    };
+    std::unordered_map<std::string, Directory> updated;
+    std::vector<Probe> probes;
+    std::deque<std::string> work = {""};
+    size_t active = 0;
+    std::mutex mutex;
+    std::condition_variable wake;
+
+    // Fills directory (listed, or from the index); changed gets the images to probe
+    auto visit = [&](const std::string& relative, Directory& directory, std::vector<size_t>& changed, bool& listed) {
+        const fs::path absolute = relative.empty() ? rootPath : rootPath / relative;
+        std::error_code error;
+        directory.modified = fs::last_write_time(absolute, error).time_since_epoch().count();
+        if (error) return false;
+
+        const auto previous = index.find(relative);
+        listed = verifyFiles || previous == index.end() || previous->second.modified != directory.modified;
+        if (!listed) {
+            directory = previous->second;
+            for (size_t i = 0; i < directory.images.size(); ++i) {
+                if (hashContents && directory.images[i].contentHash == 0) changed.push_back(i);
+            }
+            return true;
+        }
+
+        std::unordered_map<std::string, const ScannedImage*> known;
+        if (previous != index.end()) {
+            for (const ScannedImage& image : previous->second.images) {
+                known.emplace(image.path, &image);
+            }
+        }
+        for (fs::directory_iterator it(absolute, fs::directory_options::skip_permission_denied, error), end;
+             !error && it != end; it.increment(error)) {
+            std::error_code entryError;
+            const std::string name = it->path().filename().string();
+            if (it->is_symlink(entryError) && it->is_directory(entryError)) continue;
+            if (it->is_directory(entryError)) {
+                directory.subdirectories.push_back(name);
+                continue;
+            }
+            if (!isImagePath(name) || !it->is_regular_file(entryError)) continue;
+
+            ScannedImage image;
+            image.path = name;
+            image.size = it->file_size(entryError);
+            image.modified = it->last_write_time(entryError).time_since_epoch().count();
+            if (entryError) continue;
+            const auto old = known.find(name);
+            if (old != known.end() && old->second->size == image.size && old->second->modified == image.modified &&
+                (old->second->contentHash != 0 || !hashContents)) {
+                image = *old->second;
+            } else {
+                changed.push_back(directory.images.size());
+            }
+            directory.images.push_back(std::move(image));
+        }
+        return true;
+    };
+
+    auto traverse = [&] {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            wake.wait(lock, [&] { return !work.empty() || active == 0; });
+            if (work.empty()) break;
+            std::string relative = std::move(work.front());
+            work.pop_front();
+            ++active;
+            lock.unlock();
+
+            Directory directory;
+            std::vector<size_t> changed;
+            bool listed = false;
+            const bool found = visit(relative, directory, changed, listed);
+
+            lock.lock();
+            --active;
+            if (found) {
+                auto [entry, inserted] = updated.emplace(relative, std::move(directory));
+                if (inserted) {
+                    ++stats.directories;
+                    if (listed) ++stats.directoriesListed;
+                    for (size_t i : changed) {
+                        probes.push_back({&entry->first, &entry->second.images[i]});
+                    }
+                    for (const std::string& name : entry->second.subdirectories) {
+                        work.push_back(relative.empty() ? name : (fs::path(relative) / name).generic_string());
+                    }
+                }
+            }
+            wake.notify_all();
+        }
+        wake.notify_all();
+    };
+
+    int threadCount = threads > 0 ? threads
+                                  : std::max(4, 2 * static_cast<int>(std::thread::hardware_concurrency()));
+    std::vector<std::thread> pool;
+    for (int t = 1; t < threadCount; ++t) {
+        pool.emplace_back(traverse);
+    }
+    traverse();
+    for (std::thread& thread : pool) {
+        thread.join();
+    }
+
+    // Probe new and changed images of all folders together
+    const long probeCount = static_cast<long>(probes.size());
+    uint64_t bytesRead = 0;
+    #pragma omp parallel for schedule(dynamic, 16) reduction(+:bytesRead)
+    for (long k = 0; k < probeCount; ++k) {
+        const Probe& item = probes[k];
+        const fs::path directory = item.directory->empty() ? rootPath : rootPath / *item.directory;
+        bytesRead += probe(directory / item.image->path, *item.image, hashContents);
+    }
+
+    std::vector<ScannedImage> images;
+    for (const auto& [relative, directory] : updated) {
+        const fs::path folder = relative.empty() ? rootPath : rootPath / relative;
+        for (const ScannedImage& image : directory.images) {
+            ScannedImage entry = image;
+            entry.path = (folder / image.path).string();
+            images.push_back(std::move(entry));
+        }
+    }
+    std::sort(images.begin(), images.end(),
+              [](const ScannedImage& a, const ScannedImage& b) { return a.path < b.path; });
+
+    index = std::move(updated);
+    saveIndex();
+
+    stats.images = images.size();
+    stats.imagesProbed = probes.size();
+    stats.bytesRead = bytesRead;
+    stats.ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return images;
+}
+
+bool ImageScanner::loadIndex() {
+    std::ifstream in(indexPath, std::ios::binary);
+    if (!in) return false;
+    const std::string data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+    Reader reader{data};
+    if (data.size() < 4 || !std::equal(MAGIC, MAGIC + 4, data.begin())) return false;
+    reader.offset = 4;
+    if (reader.read(4) != VERSION) return false;
+
+    std::unordered_map<std::string, Directory> loaded;
+    const uint64_t count = reader.read(8);
+    for (uint64_t d = 0; d < count && reader.ok; ++d) {
+        std::string relative = reader.readString();
+        Directory directory;
+        directory.modified = static_cast<int64_t>(reader.read(8));
+        const uint64_t subdirectories = reader.read(4);
+        for (uint64_t s = 0; s < subdirectories && reader.ok; ++s) {
+            directory.subdirectories.push_back(reader.readString());
+        }
+        const uint64_t images = reader.read(4);
+        for (uint64_t i = 0; i < images && reader.ok; ++i) {
+            ScannedImage image;
+            image.path = reader.readString();
+            image.size = reader.read(8);
+            image.modified = static_cast<int64_t>(reader.read(8));
+            image.width = static_cast<int>(reader.read(4));
+            image.height = static_cast<int>(reader.read(4));
+            image.channels = static_cast<int>(reader.read(4));
+            image.contentHash = reader.read(8);
+            directory.images.push_back(std::move(image));
+        }
+        loaded.emplace(std::move(relative), std::move(directory));
+    }
+    if (!reader.ok) return false;
+    index = std::move(loaded);
+    return true;
+}
+
+bool ImageScanner::saveIndex() const {
+    std::string data(MAGIC, 4);
+    write32(data, VERSION);
+    write64(data, index.size());
+    for (const auto& [relative, directory] : index) {
+        writeString(data, relative);
+        write64(data, static_cast<uint64_t>(directory.modified));
+        write32(data, static_cast<uint32_t>(directory.subdirectories.size()));
+        for (const std::string& name : directory.subdirectories) {
+            writeString(data, name);
+        }
+        write32(data, static_cast<uint32_t>(directory.images.size()));
+        for (const ScannedImage& image : directory.images) {
+            writeString(data, image.path);
+            write64(data, image.size);
+            write64(data, static_cast<uint64_t>(image.modified));
+            write32(data, static_cast<uint32_t>(image.width));
+            write32(data, static_cast<uint32_t>(image.height));
+            write32(data, static_cast<uint32_t>(image.channels));
+            write64(data, image.contentHash);
+        }
+    }
+
+    const std::string temporary = indexPath + ".tmp";
+    std::error_code error;
+    fs::create_directories(fs::path(indexPath).parent_path(), error);
+    {
+        std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+        if (!out) return false;
+        out.write(data.data(), static_cast<std::streamsize>(data.size()));
+        if (!out) return false;
+    }
+    fs::rename(temporary, indexPath, error);
+    return !error;
+}
@@ -0,0 +1,281 @@
+/**
+ * @file IndexedImage.cpp
+ * @brief Exact palettization, expansion and indexed PNG output
+ *
+ * @details
+ * - fromImage(): each thread collects the distinct colors of its rows
+ *   (giving up as soon as one set exceeds the limit), the sets are merged
+ *   and sorted, then pixels are mapped by binary search over the palette
+ * - Palette order: non-opaque entries first so that the tRNS chunk, which
+ *   lists alpha values from index 0 up to the last non-opaque entry, stays
+ *   short
+ * - saveToFile(".png"): IHDR, PLTE, optional tRNS, one IDAT, IEND; rows are
+ *   bit-packed in parallel (most significant bits first, as PNG requires)
+ *   and deflated by stbi_zlib_compress() from stb_image_write
+ *
+ * @see IndexedImage.hpp for the layout
+ * @author Rowan HOUPA
+ * @date January 2026
+ */
+
+#include "IndexedImage.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <climits>
+#include <cstdlib>
+#include <fstream>
+#include <unordered_set>
+
+// Provided by the stb_image_write implementation compiled in Image.cpp
+extern "C" unsigned char* stbi_zlib_compress(unsigned char* data, int data_len, int* out_len, int quality);
+
+namespace {
+
+// Pixel as 0xAABBGGRR (gray channels are replicated to R, G and B)
+inline uint32_t packPixel(const uint8_t* p, int channels) {
+    switch (channels) {
+    case 1:
+        return p[0] | (p[0] << 8) | (p[0] << 16) | 0xFF000000u;
+    case 2:
+        return p[0] | (p[0] << 8) | (p[0] << 16) | (static_cast<uint32_t>(p[1]) << 24);
+    case 3:
+        return p[0] | (p[1] << 8) | (p[2] << 16) | 0xFF000000u;
+    default:
+        return p[0] | (p[1] << 8) | (p[2] << 16) | (static_cast<uint32_t>(p[3]) << 24);
+    }
+}
+
+const std::array<uint32_t, 256> CRC_TABLE = [] {
+    std::array<uint32_t, 256> table{};
+    for (uint32_t n = 0; n < 256; ++n) {
+        uint32_t c = n;
+        for (int k = 0; k < 8; ++k) {
+            c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+        }
+        table[n] = c;
+    }
+    return table;
+}();
+
+uint32_t crc32(uint32_t crc, const uint8_t* data, size_t length) {
+    for (size_t i = 0; i < length; ++i) {
+        crc = CRC_TABLE[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return crc;
+}
+
+void appendU32(std::vector<uint8_t>& out, uint32_t value) {
+    out.push_back(static_cast<uint8_t>(value >> 24));
+    out.push_back(static_cast<uint8_t>(value >> 16));
+    out.push_back(static_cast<uint8_t>(value >> 8));
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+// Length, type, payload, CRC (of type + payload)
+void writeChunk(std::ofstream& file, const char* type, const uint8_t* payload, size_t length) {
+    std::vector<uint8_t> header;
+    appendU32(header, static_cast<uint32_t>(length));
+    header.insert(header.end(), type, type + 4);
+
+    uint32_t crc = crc32(0xFFFFFFFFu, header.data() + 4, 4);
+    crc = crc32(crc, payload, length) ^ 0xFFFFFFFFu;
+    std::vector<uint8_t> trailer;
+    appendU32(trailer, crc);
+
+    file.write(reinterpret_cast<const char*>(header.data()), header.size());
+    file.write(reinterpret_cast<const char*>(payload), static_cast<std::streamsize>(length));
+    file.write(reinterpret_cast<const char*>(trailer.data()), trailer.size());
+}
+
+} // namespace
+
+IndexedImage::IndexedImage(int width, int height)
+    : m_width(width), m_height(height) {
+    if (width <= 0 || height <= 0) {
+        throw std::invalid_argument("IndexedImage dimensions must be positive");
+    }
+    m_indices.assign(static_cast<size_t>(width) * height, 0);
+}
+
+IndexedImage IndexedImage::fromImage(const Image& image, int maxColors) {
+    const int width = image.getWidth();
+    const int height = image.getHeight();
+    const int channels = image.getChannels();
+    const uint8_t* src = image.data();
+    const size_t limit = static_cast<size_t>(std::clamp(maxColors, 1, 256));
+
+    // 1. Distinct colors (per-thread sets, early exit past the limit)
+    std::atomic<bool> tooMany{false};
+    std::vector<uint32_t> colors;
+
+    #pragma omp parallel
+    {
+        std::unordered_set<uint32_t> local;
+
+        #pragma omp for schedule(static)
+        for (int y = 0; y < height; ++y) {
+            if (tooMany.load(std::memory_order_relaxed)) continue;
+            const uint8_t* in = src + static_cast<size_t>(y) * width * channels;
+            uint32_t previous = packPixel(in, channels);
+            local.insert(previous);
+            for (int x = 1; x < width; ++x) {
+                const uint32_t key = packPixel(in + x * channels, channels);
+                if (key == previous) continue;
+                previous = key;
+                local.insert(key);
+            }
+            if (local.size() > limit) tooMany.store(true, std::memory_order_relaxed);
+        }
+
+        #pragma omp critical
+        colors.insert(colors.end(), local.begin(), local.end());
+    }
+
+    if (tooMany.load()) return IndexedImage();
+    std::sort(colors.begin(), colors.end());
+    colors.erase(std::unique(colors.begin(), colors.end()), colors.end());
+    if (colors.size() > limit || colors.empty()) return IndexedImage();
+
+    // Palette order: non-opaque entries first
+    std::vector<uint32_t> order = colors;
+    std::stable_partition(order.begin(), order.end(),
+                          [](uint32_t c) { return (c >> 24) != 255; });
+
+    IndexedImage result(width, height);
+    std::vector<uint8_t> slot(colors.size());
+    result.m_palette.resize(order.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        const uint32_t c = order[i];
+        result.m_palette[i] = {static_cast<uint8_t>(c), static_cast<uint8_t>(c >> 8),
+                               static_cast<uint8_t>(c >> 16), static_cast<uint8_t>(c >> 24)};
+        const size_t sorted = std::lower_bound(colors.begin(), colors.end(), c) - colors.begin();
+        slot[sorted] = static_cast<uint8_t>(i);
+    }
+
+    // 2. Indices (binary search over at most 256 sorted colors)
+    #pragma omp parallel for schedule(static)
+    for (int y = 0; y < height; ++y) {
+        const uint8_t* in = src + static_cast<size_t>(y) * width * channels;
+        uint8_t* out = result.row(y);
+        uint32_t previous = packPixel(in, channels);
+        uint8_t index = slot[std::lower_bound(colors.begin(), colors.end(), previous) - colors.begin()];
+        for (int x = 0; x < width; ++x) {
+            const uint32_t key = packPixel(in + x * channels, channels);
+            if (key != previous) {
+                previous = key;
+                index = slot[std::lower_bound(colors.begin(), colors.end(), key) - colors.begin()];
+            }
+            out[x] = index;
+        }
+    }
+    return result;
+}
+
+Image IndexedImage::toImage(int channels) const {
+    channels = std::clamp(channels, 1, 4);
+    Image result(m_width, m_height, channels);
+    uint8_t* dst = result.data();
+
+    #pragma omp parallel for schedule(static)
+    for (int y = 0; y < m_height; ++y) {
+        const uint8_t* in = row(y);
+        uint8_t* out = dst + static_cast<size_t>(y) * m_width * channels;
+        for (int x = 0; x < m_width; ++x) {
+            const PaletteColor& c = m_palette[in[x]];
+            uint8_t* p = out + x * channels;
+            switch (channels) {
+            case 1: p[0] = c.r; break;
+            case 2: p[0] = c.r; p[1] = c.a; break;
+            case 3: p[0] = c.r; p[1] = c.g; p[2] = c.b; break;
+            default: p[0] = c.r; p[1] = c.g; p[2] = c.b; p[3] = c.a; break;
+            }
+        }
+    }
+    return result;
+}
+
+int IndexedImage::getBitDepth() const {
+    const size_t n = m_palette.size();
+    if (n <= 2) return 1;
+    if (n <= 4) return 2;
+    if (n <= 16) return 4;
+    return 8;
+}
+
+bool IndexedImage::saveToFile(const std::string& filepath) const {
+    std::string ext = filepath.substr(filepath.find_last_of(".") + 1);
+
+    if (ext != "png") {
+        const bool hasAlpha = std::any_of(m_palette.begin(), m_palette.end(),
+                                          [](const PaletteColor& c) { return c.a != 255; });
+        return toImage(hasAlpha ? 4 : 3).saveToFile(filepath);
+    }
+    if (empty() || m_palette.empty() || m_palette.size() > 256) return false;
+
+    // Filtered scanlines: filter byte 0, then bitDepth bits per index
+    const int bitDepth = getBitDepth();
+    const size_t rowBytes = (static_cast<size_t>(m_width) * bitDepth + 7) / 8;
+    const size_t rawSize = (rowBytes + 1) * m_height;
+    if (rawSize > static_cast<size_t>(INT_MAX)) return false;
+
+    std::vector<uint8_t> raw(rawSize, 0);
+    const int perByte = 8 / bitDepth;
+
+    #pragma omp parallel for schedule(static)
+    for (int y = 0; y < m_height; ++y) {
+        const uint8_t* in = row(y);
+        uint8_t* out = raw.data() + y * (rowBytes + 1) + 1;
+        if (bitDepth == 8) {
+            std::copy(in, in + m_width, out);
+            continue;
+        }
+        for (int x = 0; x < m_width; ++x) {
+            const int shift = 8 - bitDepth * (x % perByte + 1);
+            out[x / perByte] |= static_cast<uint8_t>(in[x] << shift);
+        }
+    }
+
+    int compressedSize = 0;
+    unsigned char* compressed = stbi_zlib_compress(raw.data(), static_cast<int>(rawSize), &compressedSize, 8);
+    if (!compressed) return false;
+
+    std::ofstream file(filepath, std::ios::binary);
+    if (!file) {
+        std::free(compressed);
+        return false;
+    }
+
+    static const uint8_t signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    file.write(reinterpret_cast<const char*>(signature), 8);
+
+    std::vector<uint8_t> header;
+    appendU32(header, static_cast<uint32_t>(m_width));
+    appendU32(header, static_cast<uint32_t>(m_height));
+    header.push_back(static_cast<uint8_t>(bitDepth));
+    header.push_back(3); // Color type: indexed
+    header.push_back(0); // Compression: deflate
+    header.push_back(0); // Filter method: adaptive
+    header.push_back(0); // No interlace
+    writeChunk(file, "IHDR", header.data(), header.size());
+
+    std::vector<uint8_t> plte;
+    std::vector<uint8_t> trns;
+    for (const PaletteColor& c : m_palette) {
+        plte.push_back(c.r);
+        plte.push_back(c.g);
+        plte.push_back(c.b);
+        trns.push_back(c.a);
+    }
+    while (!trns.empty() && trns.back() == 255) trns.pop_back();
+
+    writeChunk(file, "PLTE", plte.data(), plte.size());
+    if (!trns.empty()) {
+        writeChunk(file, "tRNS", trns.data(), trns.size());
+    }
+    writeChunk(file, "IDAT", compressed, static_cast<size_t>(compressedSize));
+    writeChunk(file, "IEND", nullptr, 0);
+
+    std::free(compressed);
+    return static_cast<bool>(file);
+}
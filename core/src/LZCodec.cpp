@@ -0,0 +1,194 @@
+/**
+ * @file LZCodec.cpp
+ * @brief Greedy LZ77 block encoder and bounds-checked decoder
+ *
+ * @details
+ * The encoder hashes the 4 bytes at the current position (Knuth's
+ * multiplicative hash), checks the last position seen with that hash and,
+ * on a match, extends it as far as it goes. Without a match the step grows
+ * by one byte every 64 unmatched bytes.
+ *
+ * Matches may overlap their own output (offset < length encodes runs); the
+ * decoder copies them as non-overlapping whole periods.
+ *
+ * @see LZCodec.hpp for the stream layout
+ * @author Rowan HOUPA
+ * @date January 2026
+ */
+
+#include "LZCodec.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+    constexpr int HASH_BITS = 16;
+    constexpr size_t MIN_MATCH = 4;
+    constexpr size_t MAX_OFFSET = 65535;
+
+    uint32_t read32(const uint8_t* p) {
+        uint32_t value;
+        std::memcpy(&value, p, sizeof(value));
+        return value;
+    }
+
+    void writeLength(std::vector<uint8_t>& out, size_t length) {
+        while (length >= 255) {
+            out.push_back(255);
+            length -= 255;
+        }
+        out.push_back(static_cast<uint8_t>(length));
+    }
+
+    // Literals [literals, literals + literalCount), then a match unless matchLength is 0
+    void writeSequence(std::vector<uint8_t>& out, const uint8_t* literals, size_t literalCount,
+                       size_t offset, size_t matchLength) {
+        const size_t matchCode = matchLength ? matchLength - MIN_MATCH : 0;
+        out.push_back(static_cast<uint8_t>((std::min<size_t>(literalCount, 15) << 4) |
+                                           std::min<size_t>(matchCode, 15)));
+        if (literalCount >= 15) {
+            writeLength(out, literalCount - 15);
+        }
+        out.insert(out.end(), literals, literals + literalCount);
+        if (matchLength == 0) {
+            return;
+        }
+        out.push_back(static_cast<uint8_t>(offset & 0xFF));
+        out.push_back(static_cast<uint8_t>(offset >> 8));
+        if (matchCode >= 15) {
+            writeLength(out, matchCode - 15);
+        }
+    }
+
+    void compressBlock(const uint8_t* src, size_t size, std::vector<uint8_t>& out) {
+        std::vector<uint32_t> table(size_t(1) << HASH_BITS, 0);    // Position + 1, 0 = empty
+        out.reserve(size + size / 128 + 16);
+
+        size_t anchor = 0;
+        size_t i = 0;
+        while (i + MIN_MATCH <= size) {
+            const uint32_t sequence = read32(src + i);
+            const uint32_t hash = (sequence * 2654435761u) >> (32 - HASH_BITS);
+            const size_t candidate = table[hash];
+            table[hash] = static_cast<uint32_t>(i + 1);
+
+            if (candidate != 0 && i - (candidate - 1) <= MAX_OFFSET &&
+                read32(src + candidate - 1) == sequence) {
+                const size_t reference = candidate - 1;
+                size_t length = MIN_MATCH;
+                while (i + length < size && src[reference + length] == src[i + length]) {
+                    ++length;
+                }
+                writeSequence(out, src + anchor, i - anchor, i - reference, length);
+                i += length;
+                anchor = i;
+            } else {
+                i += 1 + ((i - anchor) >> 6);
+            }
+        }
+        writeSequence(out, src + anchor, size - anchor, 0, 0);
+    }
+
+    bool readLength(const uint8_t* in, size_t inSize, size_t& position, size_t& length) {
+        uint8_t byte;
+        do {
+            if (position >= inSize) return false;
+            byte = in[position++];
+            length += byte;
+        } while (byte == 255);
+        return true;
+    }
+
+    bool decompressBlock(const uint8_t* in, size_t inSize, uint8_t* out, size_t outSize) {
+        size_t ip = 0;
+        size_t op = 0;
+        while (ip < inSize) {
+            const uint8_t token = in[ip++];
+
+            size_t literalCount = token >> 4;
+            if (literalCount == 15 && !readLength(in, inSize, ip, literalCount)) return false;
+            if (literalCount > inSize - ip || literalCount > outSize - op) return false;
+            std::memcpy(out + op, in + ip, literalCount);
+            ip += literalCount;
+            op += literalCount;
+            if (ip == inSize) {
+                break;      // Last sequence: literals only
+            }
+
+            if (inSize - ip < 2) return false;
+            const size_t offset = in[ip] | (static_cast<size_t>(in[ip + 1]) << 8);
+            ip += 2;
+            size_t length = token & 15;
+            if (length == 15 && !readLength(in, inSize, ip, length)) return false;
+            length += MIN_MATCH;
+            if (offset == 0 || offset > op || length > outSize - op) return false;
+            // Output from op - offset on repeats with period offset: copy
+            // whole periods, which never overlap, doubling each time
+            size_t copied = 0;
+            while (copied < length) {
+                const size_t period = offset * ((offset + copied) / offset);
+                const size_t chunk = std::min(period, length - copied);
+                std::memcpy(out + op + copied, out + op + copied - period, chunk);
+                copied += chunk;
+            }
+            op += length;
+        }
+        return op == outSize;
+    }
+}
+
+std::vector<uint8_t> LZCodec::compress(const uint8_t* data, size_t size) {
+    const long long blocks = static_cast<long long>((size + BLOCK_SIZE - 1) / BLOCK_SIZE);
+    std::vector<std::vector<uint8_t>> packedBlocks(blocks);
+
+    #pragma omp parallel for schedule(dynamic)
+    for (long long b = 0; b < blocks; ++b) {
+        const size_t begin = static_cast<size_t>(b) * BLOCK_SIZE;
+        compressBlock(data + begin, std::min(BLOCK_SIZE, size - begin), packedBlocks[b]);
+    }
+
+    size_t total = 0;
+    for (const auto& block : packedBlocks) {
+        total += 4 + block.size();
+    }
+    std::vector<uint8_t> packed;
+    packed.reserve(total);
+    for (const auto& block : packedBlocks) {
+        const uint32_t blockSize = static_cast<uint32_t>(block.size());
+        for (int shift = 0; shift < 32; shift += 8) {
+            packed.push_back(static_cast<uint8_t>(blockSize >> shift));
+        }
+        packed.insert(packed.end(), block.begin(), block.end());
+    }
+    return packed;
+}
+
+bool LZCodec::decompress(const std::vector<uint8_t>& packed, uint8_t* output, size_t size) {
+    const long long blocks = static_cast<long long>((size + BLOCK_SIZE - 1) / BLOCK_SIZE);
+
+    // Block boundaries first (sequential), then independent decodes
+    std::vector<size_t> offsets(blocks);
+    std::vector<size_t> sizes(blocks);
+    size_t position = 0;
+    for (long long b = 0; b < blocks; ++b) {
+        if (packed.size() - position < 4) return false;
+        uint32_t blockSize = 0;
+        for (int k = 0; k < 4; ++k) {
+            blockSize |= static_cast<uint32_t>(packed[position + k]) << (8 * k);
+        }
+        position += 4;
+        if (blockSize > packed.size() - position) return false;
+        offsets[b] = position;
+        sizes[b] = blockSize;
+        position += blockSize;
+    }
+    if (position != packed.size()) return false;
+
+    bool ok = true;
+    #pragma omp parallel for schedule(dynamic) reduction(&&:ok)
+    for (long long b = 0; b < blocks; ++b) {
+        const size_t begin = static_cast<size_t>(b) * BLOCK_SIZE;
+        ok = decompressBlock(packed.data() + offsets[b], sizes[b], output + begin,
+                             std::min(BLOCK_SIZE, size - begin)) && ok;
+    }
+    return ok;
+}
@@ -0,0 +1,197 @@
+/**
+ * @file PerceptualHash.cpp
+ * @brief dHash / pHash computation and BK-tree search
+ *
+ * @details
+ * Thumbnail cell (tx, ty) averages the pixel box
+ * [tx W / w, (tx + 1) W / w) × [ty H / h, (ty + 1) H / h), widened to one
+ * pixel when the image is smaller than the thumbnail. Cells are
+ * independent: OpenMP collapse(2) over the thumbnail.
+ *
+ * pHash: C(u, v) = Σx Σy T(x, y) cos((2x + 1) u π / 64) cos((2y + 1) v π / 64)
+ * for u, v < 8, computed as 32 row transforms then 8 column transforms.
+ * Bit 8v + u is set when C(u, v) exceeds the median of the 63 AC terms.
+ *
+ * BK-tree nodes live in one vector; children are (edge distance, index)
+ * pairs and searches use an explicit stack (no recursion).
+ *
+ * @see PerceptualHash.hpp for the hash definitions
+ * @author Rowan HOUPA
+ * @date January 2026
+ */
+
+#include "PerceptualHash.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace {
+
+constexpr int DCT_SIZE = 32;
+constexpr int DCT_KEEP = 8;
+
+inline float lumaAt(const uint8_t* p, int channels) {
+    if (channels < 3) return p[0];
+    return static_cast<float>((77 * p[0] + 150 * p[1] + 29 * p[2] + 128) >> 8);
+}
+
+} // namespace
+
+std::vector<float> PerceptualHash::lumaThumbnail(const Image& image, int width, int height) {
+    const int imageWidth = image.getWidth();
+    const int imageHeight = image.getHeight();
+    const int channels = image.getChannels();
+    const uint8_t* src = image.data();
+    std::vector<float> thumbnail(static_cast<size_t>(width) * height, 0.0f);
+    if (imageWidth == 0 || imageHeight == 0) return thumbnail;
+
+    #pragma omp parallel for collapse(2) schedule(static)
+    for (int ty = 0; ty < height; ++ty) {
+        for (int tx = 0; tx < width; ++tx) {
+            const int x0 = std::min(imageWidth - 1, tx * imageWidth / width);
+            const int x1 = std::max(x0 + 1, (tx + 1) * imageWidth / width);
+            const int y0 = std::min(imageHeight - 1, ty * imageHeight / height);
+            const int y1 = std::max(y0 + 1, (ty + 1) * imageHeight / height);
+
+            double sum = 0.0;
+            for (int y = y0; y < y1; ++y) {
+                const uint8_t* row = src + static_cast<size_t>(y) * imageWidth * channels;
+                uint32_t rowSum = 0;
+                for (int x = x0; x < x1; ++x) {
+                    rowSum += static_cast<uint32_t>(lumaAt(row + x * channels, channels));
+                }
+                sum += rowSum;
+            }
+            thumbnail[static_cast<size_t>(ty) * width + tx] =
+                static_cast<float>(sum / (static_cast<double>(x1 - x0) * (y1 - y0)));
+        }
+    }
+    return thumbnail;
+}
+
+uint64_t PerceptualHash::dHash(const Image& image) {
+    const std::vector<float> t = lumaThumbnail(image, 9, 8);
+    uint64_t hash = 0;
+    for (int y = 0; y < 8; ++y) {
+        for (int x = 0; x < 8; ++x) {
+            if (t[y * 9 + x] < t[y * 9 + x + 1]) {
+                hash |= uint64_t(1) << (y * 8 + x);
+            }
+        }
+    }
+    return hash;
+}
+
+uint64_t PerceptualHash::pHash(const Image& image) {
+    const std::vector<float> t = lumaThumbnail(image, DCT_SIZE, DCT_SIZE);
+
+    static const std::array<float, DCT_KEEP * DCT_SIZE> cosines = [] {
+        std::array<float, DCT_KEEP * DCT_SIZE> table;
+        for (int u = 0; u < DCT_KEEP; ++u) {
+            for (int x = 0; x < DCT_SIZE; ++x) {
+                table[u * DCT_SIZE + x] = static_cast<float>(
+                    std::cos((2 * x + 1) * u * 3.14159265358979323846 / (2 * DCT_SIZE)));
+            }
+        }
+        return table;
+    }();
+
+    // Row transforms: rows[y][u]
+    std::array<float, DCT_SIZE * DCT_KEEP> rows;
+    for (int y = 0; y < DCT_SIZE; ++y) {
+        for (int u = 0; u < DCT_KEEP; ++u) {
+            float sum = 0.0f;
+            for (int x = 0; x < DCT_SIZE; ++x) {
+                sum += t[y * DCT_SIZE + x] * cosines[u * DCT_SIZE + x];
+            }
+            rows[y * DCT_KEEP + u] = sum;
+        }
+    }
+
+    // Column transforms: coefficients[v][u]
+    std::array<float, DCT_KEEP * DCT_KEEP> coefficients;
+    for (int v = 0; v < DCT_KEEP; ++v) {
+        for (int u = 0; u < DCT_KEEP; ++u) {
+            float sum = 0.0f;
+            for (int y = 0; y < DCT_SIZE; ++y) {
+                sum += rows[y * DCT_KEEP + u] * cosines[v * DCT_SIZE + y];
+            }
+            coefficients[v * DCT_KEEP + u] = sum;
+        }
+    }
+
+    // Median of the AC coefficients (the DC term only tracks brightness)
+    std::array<float, DCT_KEEP * DCT_KEEP - 1> ac;
+    std::copy(coefficients.begin() + 1, coefficients.end(), ac.begin());
+    std::nth_element(ac.begin(), ac.begin() + ac.size() / 2, ac.end());
+    const float median = ac[ac.size() / 2];
+
+    uint64_t hash = 0;
+    for (int i = 0; i < DCT_KEEP * DCT_KEEP; ++i) {
+        if (coefficients[i] > median) {
+            hash |= uint64_t(1) << i;
+        }
+    }
+    return hash;
+}
+
+void BKTree::insert(uint64_t hash, size_t id) {
+    const uint32_t index = static_cast<uint32_t>(nodes.size());
+    nodes.push_back({hash, id, {}});
+    if (index == 0) return;
+
+    uint32_t current = 0;
+    while (true) {
+        const int d = PerceptualHash::distance(nodes[current].hash, hash);
+        auto& children = nodes[current].children;
+        auto it = std::find_if(children.begin(), children.end(),
+                               [d](const std::pair<int, uint32_t>& c) { return c.first == d; });
+        if (it == children.end()) {
+            children.emplace_back(d, index);
+            return;
+        }
+        current = it->second;
+    }
+}
+
+template<typename Visit>
+void BKTree::search(uint64_t hash, int maxDistance, Visit&& visit) const {
+    if (nodes.empty()) return;
+
+    std::vector<uint32_t> stack{0};
+    while (!stack.empty()) {
+        const Node& node = nodes[stack.back()];
+        stack.pop_back();
+
+        const int d = PerceptualHash::distance(node.hash, hash);
+        if (d <= maxDistance) visit(node, d);
+
+        for (const auto& [edge, child] : node.children) {
+            if (edge >= d - maxDistance && edge <= d + maxDistance) {
+                stack.push_back(child);
+            }
+        }
+    }
+}
+
+bool BKTree::findNearest(uint64_t hash, int maxDistance, size_t& id, int& distance) const {
+    bool found = false;
+    search(hash, maxDistance, [&](const Node& node, int d) {
+        if (!found || d < distance || (d == distance && node.id < id)) {
+            found = true;
+            id = node.id;
+            distance = d;
+        }
+    });
+    return found;
+}
+
+std::vector<std::pair<size_t, int>> BKTree::findWithin(uint64_t hash, int maxDistance) const {
+    std::vector<std::pair<size_t, int>> matches;
+    search(hash, maxDistance, [&](const Node& node, int d) {
+        matches.emplace_back(node.id, d);
+    });
+    std::sort(matches.begin(), matches.end(),
+              [](const auto& a, const auto& b) { return a.second != b.second ? a.second < b.second : a.first < b.first; });
+    return matches;
+}
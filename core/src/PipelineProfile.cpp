@@ -0,0 +1,54 @@
+/**
+ * @file PipelineProfile.cpp
+ * @brief Accumulation of the per-step timings reported by FilterPipeline
+ *
+ * @details
+ * The caller builds the filter's name and device strings before the
+ * call, so the critical section is only the additions and two moves.
+ *
+ * @see PipelineProfile.hpp
+ * @author Rowan HOUPA
+ * @date January 2026
+ */
+
+#include "PipelineProfile.hpp"
+
+void PipelineProfile::recordFilter(size_t index, std::string name, std::string device, double ms,
+                                   uint64_t pixels) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (stats.filters.size() <= index) {
+        stats.filters.resize(index + 1);
+    }
+    FilterStats& entry = stats.filters[index];
+    if (entry.name != name) {
+        entry = FilterStats{};
+        entry.name = std::move(name);
+    }
+    entry.device = std::move(device);
+    ++entry.calls;
+    entry.totalMs += ms;
+    entry.lastMs = ms;
+    entry.pixels += pixels;
+}
+
+void PipelineProfile::recordRun(double ms, uint64_t pixels, size_t filterCount) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (stats.filters.size() > filterCount) {
+        stats.filters.resize(filterCount);
+    }
+    ++stats.runs;
+    stats.totalMs += ms;
+    stats.pixels += pixels;
+    stats.lastRunMs = ms;
+    stats.lastRunPixels = pixels;
+}
+
+PipelineProfile::Stats PipelineProfile::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return stats;
+}
+
+void PipelineProfile::reset() {
+    std::lock_guard<std::mutex> lock(mutex);
+    stats = Stats{};
+}
@@ -0,0 +1,84 @@
+/**
+ * @file SummedAreaTable.cpp
+ * @brief CPU build of summed-area tables using OpenMP
+ *
+ * @details
+ * Two-pass scan into the (width + 1) × (height + 1) padded table:
+ * 1. Row pass (OpenMP over rows): running sum of each channel along the
+ *    row, written to table row y + 1
+ * 2. Column pass (OpenMP over 64-column blocks): every table row adds the
+ *    row above it; a block is contiguous in memory so the inner loop is a
+ *    straight `omp simd` addition and each thread streams its own strip
+ *
+ * Unsigned tables rely on modular arithmetic: intermediate entries may wrap
+ * around, rectangle sums stay exact (see SummedAreaTable.hpp).
+ *
+ * @see SummedAreaTableGPU.cpp for the SYCL build
+ * @author Rowan HOUPA
+ * @date January 2026
+ */
+
+#include "SummedAreaTable.hpp"
+#include <algorithm>
+
+namespace {
+    constexpr int COLUMN_BLOCK = 64;
+}
+
+template<typename T>
+void SummedAreaTable<T>::resize(const Image& image) {
+    m_width = image.getWidth();
+    m_height = image.getHeight();
+    m_channels = image.getChannels();
+    m_table.assign(static_cast<size_t>(m_width + 1) * (m_height + 1) * m_channels, T(0));
+}
+
+template<typename T>
+void SummedAreaTable<T>::build(const Image& image, SatValue value) {
+    resize(image);
+
+    const int width = m_width;
+    const int height = m_height;
+    const int channels = m_channels;
+    const bool squared = (value == SatValue::Squared);
+    const size_t rowStride = static_cast<size_t>(width + 1) * channels;
+    const uint8_t* src = image.data();
+    T* table = m_table.data();
+
+    // 1. Row pass: independent prefix sums per row and channel
+    #pragma omp parallel for schedule(static)
+    for (int y = 0; y < height; ++y) {
+        const uint8_t* row = src + static_cast<size_t>(y) * width * channels;
+        T* out = table + static_cast<size_t>(y + 1) * rowStride + channels;
+        for (int c = 0; c < channels; ++c) {
+            T sum = T(0);
+            for (int x = 0; x < width; ++x) {
+                const T v = static_cast<T>(row[x * channels + c]);
+                sum += squared ? v * v : v;
+                out[x * channels + c] = sum;
+            }
+        }
+    }
+
+    // 2. Column pass: blocks of contiguous columns scanned down the rows
+    const int columns = static_cast<int>(rowStride);
+    const int blocks = (columns + COLUMN_BLOCK - 1) / COLUMN_BLOCK;
+
+    #pragma omp parallel for schedule(static)
+    for (int b = 0; b < blocks; ++b) {
+        const int begin = b * COLUMN_BLOCK;
+        const int end = std::min(columns, begin + COLUMN_BLOCK);
+        for (int y = 2; y <= height; ++y) {
+            const T* above = table + static_cast<size_t>(y - 1) * rowStride;
+            T* current = table + static_cast<size_t>(y) * rowStride;
+            #pragma omp simd
+            for (int i = begin; i < end; ++i) {
+                current[i] += above[i];
+            }
+        }
+    }
+}
+
+template class SummedAreaTable<uint32_t>;
+template class SummedAreaTable<uint64_t>;
+template class SummedAreaTable<float>;
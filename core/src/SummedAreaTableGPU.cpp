@@ -0,0 +1,105 @@
+/**
+ * @file SummedAreaTableGPU.cpp
+ * @brief SYCL build of summed-area tables
+ *
+ * @details
+ * SYCL Implementation:
+ * - Row pass: one 256-wide work-group per image row; the row is processed
+ *   in 256-value chunks with sycl::inclusive_scan_over_group, the running
+ *   carry between chunks coming from sycl::reduce_over_group
+ * - Column pass: one work-item per table column walking down the rows
+ *   (neighbouring work-items touch neighbouring addresses: coalesced)
+ * - Both kernels work on the zero-initialized padded table in place
+ *
+ * Error Handling:
+ * - Catches sycl::exception and falls back to the CPU build()
+ *
+ * @see SummedAreaTable.cpp for the CPU build
+ * @author Rowan HOUPA
+ * @date January 2026
+ */
+
+#include "SummedAreaTable.hpp"
+#include <iostream>
+
+namespace {
+    constexpr int SCAN_GROUP_SIZE = 256;
+}
+
+template<typename T>
+void SummedAreaTable<T>::buildGPU(const Image& image, SatValue value) {
+    resize(image);
+
+    try {
+        sycl::queue q(sycl::gpu_selector_v);
+
+        const int width = m_width;
+        const int height = m_height;
+        const int channels = m_channels;
+        const bool squared = (value == SatValue::Squared);
+        const size_t rowStride = static_cast<size_t>(width + 1) * channels;
+
+        {
+            sycl::buffer<uint8_t, 1> bufIn(image.data(), sycl::range<1>(image.size()));
+            sycl::buffer<T, 1> bufTable(m_table.data(), sycl::range<1>(m_table.size()));
+
+            // 1. Row pass: work-group scans
+            q.submit([&](sycl::handler& h) {
+                auto in = bufIn.template get_access<sycl::access::mode::read>(h);
+                auto table = bufTable.template get_access<sycl::access::mode::read_write>(h);
+
+                h.parallel_for(
+                    sycl::nd_range<1>(sycl::range<1>(static_cast<size_t>(height) * SCAN_GROUP_SIZE),
+                                      sycl::range<1>(SCAN_GROUP_SIZE)),
+                    [=](sycl::nd_item<1> item) {
+                        const auto group = item.get_group();
+                        const int y = static_cast<int>(item.get_group(0));
+                        const int lid = static_cast<int>(item.get_local_id(0));
+                        const size_t srcRow = static_cast<size_t>(y) * width * channels;
+                        const size_t dstRow = static_cast<size_t>(y + 1) * rowStride + channels;
+
+                        for (int c = 0; c < channels; ++c) {
+                            T carry = T(0);
+                            for (int base = 0; base < width; base += SCAN_GROUP_SIZE) {
+                                const int x = base + lid;
+                                T v = T(0);
+                                if (x < width) {
+                                    v = static_cast<T>(in[srcRow + static_cast<size_t>(x) * channels + c]);
+                                    if (squared) v *= v;
+                                }
+                                const T scanned = sycl::inclusive_scan_over_group(group, v, sycl::plus<T>());
+                                if (x < width) {
+                                    table[dstRow + static_cast<size_t>(x) * channels + c] = carry + scanned;
+                                }
+                                carry += sycl::reduce_over_group(group, v, sycl::plus<T>());
+                            }
+                        }
+                    });
+            });
+
+            // 2. Column pass: one work-item per column
+            q.submit([&](sycl::handler& h) {
+                auto table = bufTable.template get_access<sycl::access::mode::read_write>(h);
+
+                h.parallel_for(sycl::range<1>(rowStride), [=](sycl::id<1> idx) {
+                    const size_t column = idx[0];
+                    T running = T(0);
+                    for (int y = 1; y <= height; ++y) {
+                        const size_t i = static_cast<size_t>(y) * rowStride + column;
+                        running += table[i];
+                        table[i] = running;
+                    }
+                });
+            }).wait();
+        }
+
+    } catch (sycl::exception const& e) {
+        std::cerr << "SYCL exception: " << e.what() << std::endl;
+        std::cerr << "↩Fallback sur CPU..." << std::endl;
+        build(image, value);
+    }
+}
+
+template void SummedAreaTable<uint32_t>::buildGPU(const Image&, SatValue);
+template void SummedAreaTable<uint64_t>::buildGPU(const Image&, SatValue);
+template void SummedAreaTable<float>::buildGPU(const Image&, SatValue);
@@ -0,0 +1,189 @@
+/**
+ * @file TemporalProcessor.cpp
+ * @brief Tile change detection and halo-aware partial pipeline execution
+ *
+ * @details
+ * Tile (tx, ty) covers [tx T, min(W, (tx + 1) T)) × [ty T, min(H, (ty + 1) T)).
+ * With halo h, the output of a tile depends on its input widened by h, which
+ * overlaps at most ceil(h / T) tiles on each side: recompute = dirty dilated
+ * by that many tiles. A run of recomputed tiles [a, b] in row ty is filtered
+ * as one crop of the input widened by h (clipped to the frame, so frame
+ * borders behave as in a full pass); the run's interior is copied to the
+ * output and its input becomes the new reference.
+ *
+ * @see TemporalProcessor.hpp for the overall flow
+ * @author Rowan HOUPA
+ * @date January 2026
+ */
+
+#include "TemporalProcessor.hpp"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+TemporalProcessor::TemporalProcessor(const FilterPipeline& pipeline, const TemporalOptions& options)
+    : pipeline(pipeline), options(options),
+      denoiser(options.denoiseStrength, options.motionThreshold),
+      halo(pipeline.getHaloRadius()) {
+    this->options.tileSize = std::max(8, options.tileSize);
+    this->options.changeThreshold = std::clamp(options.changeThreshold, 0, 255);
+}
+
+void TemporalProcessor::reset() {
+    denoiser.reset();
+    reference = Image();
+    output = Image();
+    halo = pipeline.getHaloRadius();
+}
+
+Image TemporalProcessor::process(Image&& frame) {
+    if (options.denoiseStrength > 0.0f) {
+        denoiser.applyInPlace(frame);
+    }
+    ++stats.frames;
+
+    if (halo < 0 || reference.size() == 0 || frame.getWidth() != reference.getWidth() ||
+        frame.getHeight() != reference.getHeight() || frame.getChannels() != reference.getChannels()) {
+        return processFull(std::move(frame));
+    }
+
+    markDirtyTiles(frame);
+
+    // Widen the dirty tiles by the halo
+    const int reach = (halo + options.tileSize - 1) / options.tileSize;
+    #pragma omp parallel for schedule(static)
+    for (int ty = 0; ty < tilesY; ++ty) {
+        for (int tx = 0; tx < tilesX; ++tx) {
+            uint8_t any = 0;
+            for (int y = std::max(0, ty - reach); y <= std::min(tilesY - 1, ty + reach) && !any; ++y) {
+                for (int x = std::max(0, tx - reach); x <= std::min(tilesX - 1, tx + reach); ++x) {
+                    any |= dirty[static_cast<size_t>(y) * tilesX + x];
+                }
+            }
+            recompute[static_cast<size_t>(ty) * tilesX + tx] = any;
+        }
+    }
+
+    // Filter each horizontal run of recomputed tiles as one crop
+    size_t skipped = 0;
+    for (int ty = 0; ty < tilesY; ++ty) {
+        const uint8_t* row = recompute.data() + static_cast<size_t>(ty) * tilesX;
+        int tx = 0;
+        while (tx < tilesX) {
+            if (!row[tx]) {
+                ++skipped;
+                ++tx;
+                continue;
+            }
+            int last = tx;
+            while (last + 1 < tilesX && row[last + 1]) {
+                ++last;
+            }
+            processRun(frame, ty, tx, last);
+            tx = last + 1;
+        }
+    }
+
+    stats.tiles += dirty.size();
+    stats.tilesSkipped += skipped;
+
+    // Hand the result back in the frame's own buffer when the layout allows
+    if (output.getChannels() == frame.getChannels()) {
+        std::memcpy(frame.data(), output.data(), output.size());
+        return std::move(frame);
+    }
+    return output;
+}
+
+Image TemporalProcessor::processFull(Image&& frame) {
+    reference = frame;
+    output = pipeline.apply(std::move(frame));
+
+    // Tiles only work for size-preserving pipelines
+    if (output.getWidth() != reference.getWidth() || output.getHeight() != reference.getHeight()) {
+        halo = -1;
+    }
+
+    tilesX = (reference.getWidth() + options.tileSize - 1) / options.tileSize;
+    tilesY = (reference.getHeight() + options.tileSize - 1) / options.tileSize;
+    dirty.assign(static_cast<size_t>(tilesX) * tilesY, 0);
+    recompute.assign(dirty.size(), 0);
+    stats.tiles += dirty.size();
+    return output;
+}
+
+void TemporalProcessor::markDirtyTiles(const Image& frame) {
+    const int width = frame.getWidth();
+    const int height = frame.getHeight();
+    const int channels = frame.getChannels();
+    const int tile = options.tileSize;
+    const int threshold = options.changeThreshold;
+    const size_t stride = static_cast<size_t>(width) * channels;
+    const uint8_t* current = frame.data();
+    const uint8_t* previous = reference.data();
+
+    #pragma omp parallel for collapse(2) schedule(static)
+    for (int ty = 0; ty < tilesY; ++ty) {
+        for (int tx = 0; tx < tilesX; ++tx) {
+            const int y0 = ty * tile;
+            const int y1 = std::min(height, y0 + tile);
+            const size_t begin = static_cast<size_t>(tx) * tile * channels;
+            const int count = (std::min(width, (tx + 1) * tile) - tx * tile) * channels;
+
+            int largest = 0;
+            for (int y = y0; y < y1 && largest <= threshold; ++y) {
+                const uint8_t* a = current + y * stride + begin;
+                const uint8_t* b = previous + y * stride + begin;
+                #pragma omp simd reduction(max:largest)
+                for (int i = 0; i < count; ++i) {
+                    const int d = a[i] > b[i] ? a[i] - b[i] : b[i] - a[i];
+                    largest = std::max(largest, d);
+                }
+            }
+            dirty[static_cast<size_t>(ty) * tilesX + tx] = largest > threshold;
+        }
+    }
+}
+
+void TemporalProcessor::processRun(const Image& frame, int tileY, int firstTile, int lastTile) {
+    const int width = frame.getWidth();
+    const int height = frame.getHeight();
+    const int channels = frame.getChannels();
+    const int tile = options.tileSize;
+
+    const int x0 = firstTile * tile;
+    const int x1 = std::min(width, (lastTile + 1) * tile);
+    const int y0 = tileY * tile;
+    const int y1 = std::min(height, y0 + tile);
+    const int cropX0 = std::max(0, x0 - halo);
+    const int cropX1 = std::min(width, x1 + halo);
+    const int cropY0 = std::max(0, y0 - halo);
+    const int cropY1 = std::min(height, y1 + halo);
+    const int cropWidth = cropX1 - cropX0;
+    const int cropHeight = cropY1 - cropY0;
+
+    Image crop(cropWidth, cropHeight, channels);
+    for (int y = 0; y < cropHeight; ++y) {
+        std::memcpy(crop.data() + static_cast<size_t>(y) * cropWidth * channels,
+                    frame.data() + (static_cast<size_t>(cropY0 + y) * width + cropX0) * channels,
+                    static_cast<size_t>(cropWidth) * channels);
+    }
+
+    Image result = pipeline.apply(std::move(crop));
+    const int outChannels = output.getChannels();
+    if (result.getWidth() != cropWidth || result.getHeight() != cropHeight ||
+        result.getChannels() != outChannels) {
+        throw std::runtime_error("TemporalProcessor: pipeline changed the tile size");
+    }
+
+    // Interior of the run → output, its input → reference
+    const size_t runValues = static_cast<size_t>(x1 - x0);
+    for (int y = y0; y < y1; ++y) {
+        std::memcpy(output.data() + (static_cast<size_t>(y) * width + x0) * outChannels,
+                    result.data() + (static_cast<size_t>(y - cropY0) * cropWidth + (x0 - cropX0)) * outChannels,
+                    runValues * outChannels);
+        std::memcpy(reference.data() + (static_cast<size_t>(y) * width + x0) * channels,
+                    frame.data() + (static_cast<size_t>(y) * width + x0) * channels,
+                    runValues * channels);
+    }
+}
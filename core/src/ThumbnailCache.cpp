@@ -0,0 +1,189 @@
+/**
+ * @file ThumbnailCache.cpp
+ * @brief Entry naming, (de)serialization and pruning of the thumbnail cache
+ *
+ * @details
+ * Entry names are the 64-bit FNV-1a hash of "absolute path|size|mtime|edge"
+ * in hex. A collision would show the wrong thumbnail, never corrupt data:
+ * the header is checked against the stored pixels.
+ *
+ * @see ThumbnailCache.hpp for the entry layout
+ * @author Rowan HOUPA
+ * @date January 2026
+ */
+
+#include "ThumbnailCache.hpp"
+#include "ContactSheet.hpp"
+#include "LZCodec.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <thread>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+    constexpr char MAGIC[4] = {'I', 'F', 'T', 'N'};
+    constexpr uint32_t VERSION = 1;
+    constexpr int MAX_EDGE = 4096;
+
+    uint64_t fnv1a(const std::string& text) {
+        uint64_t hash = 14695981039346656037ull;
+        for (unsigned char c : text) {
+            hash ^= c;
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    void write32(std::ostream& out, uint32_t value) {
+        char bytes[4];
+        for (int k = 0; k < 4; ++k) {
+            bytes[k] = static_cast<char>(value >> (8 * k));
+        }
+        out.write(bytes, 4);
+    }
+
+    bool read32(std::istream& in, uint32_t& value) {
+        unsigned char bytes[4];
+        if (!in.read(reinterpret_cast<char*>(bytes), 4)) return false;
+        value = 0;
+        for (int k = 0; k < 4; ++k) {
+            value |= static_cast<uint32_t>(bytes[k]) << (8 * k);
+        }
+        return true;
+    }
+}
+
+ThumbnailCache::ThumbnailCache(std::string directory, int thumbnailSize)
+    : directory(std::move(directory)), thumbnailSize(std::max(1, thumbnailSize)) {
+    std::error_code error;
+    fs::create_directories(this->directory, error);
+}
+
+std::string ThumbnailCache::entryPath(const std::string& path) const {
+    std::error_code error;
+    const fs::path absolute = fs::absolute(path, error);
+    if (error) return {};
+    const auto size = fs::file_size(absolute, error);
+    if (error) return {};
+    const auto modified = fs::last_write_time(absolute, error);
+    if (error) return {};
+
+    const std::string key = absolute.string() + "|" + std::to_string(size) + "|" +
+                            std::to_string(modified.time_since_epoch().count()) + "|" +
+                            std::to_string(thumbnailSize);
+    char name[17];
+    std::snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(fnv1a(key)));
+    return (fs::path(directory) / (std::string(name) + ".iftn")).string();
+}
+
+bool ThumbnailCache::load(const std::string& path, Image& thumbnail) const {
+    const std::string entry = entryPath(path);
+    if (entry.empty()) return false;
+    std::ifstream in(entry, std::ios::binary);
+    if (!in) return false;
+
+    char magic[4];
+    uint32_t version, width, height, channels;
+    if (!in.read(magic, 4) || !std::equal(magic, magic + 4, MAGIC) ||
+        !read32(in, version) || version != VERSION ||
+        !read32(in, width) || !read32(in, height) || !read32(in, channels) ||
+        width == 0 || height == 0 || width > MAX_EDGE || height > MAX_EDGE ||
+        channels == 0 || channels > 4) {
+        return false;
+    }
+    std::vector<uint8_t> packed((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+    Image image(static_cast<int>(width), static_cast<int>(height), static_cast<int>(channels));
+    if (!LZCodec::decompress(packed, image.data(), image.size())) {
+        return false;
+    }
+    thumbnail = std::move(image);
+    return true;
+}
+
+bool ThumbnailCache::store(const std::string& path, const Image& thumbnail) const {
+    const std::string entry = entryPath(path);
+    if (entry.empty() || thumbnail.size() == 0) return false;
+
+    // Unique per writer; the rename publishes the entry atomically
+    const std::string temporary = entry + "." +
+        std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id())) + ".tmp";
+    {
+        std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+        if (!out) return false;
+        const std::vector<uint8_t> packed = LZCodec::compress(thumbnail.data(), thumbnail.size());
+        out.write(MAGIC, 4);
+        write32(out, VERSION);
+        write32(out, static_cast<uint32_t>(thumbnail.getWidth()));
+        write32(out, static_cast<uint32_t>(thumbnail.getHeight()));
+        write32(out, static_cast<uint32_t>(thumbnail.getChannels()));
+        out.write(reinterpret_cast<const char*>(packed.data()), static_cast<std::streamsize>(packed.size()));
+        if (!out) {
+            out.close();
+            std::remove(temporary.c_str());
+            return false;
+        }
+    }
+    std::error_code error;
+    fs::rename(temporary, entry, error);
+    if (error) {
+        fs::remove(temporary, error);
+        return false;
+    }
+    return true;
+}
+
+Image ThumbnailCache::makeThumbnail(const std::string& path) const {
+    Image image;
+    if (!image.loadFromFile(path)) {
+        return Image();
+    }
+    return ContactSheet::thumbnail(image, thumbnailSize, thumbnailSize);
+}
+
+Image ThumbnailCache::get(const std::string& path) const {
+    Image thumbnail;
+    if (load(path, thumbnail)) {
+        return thumbnail;
+    }
+    thumbnail = makeThumbnail(path);
+    if (thumbnail.size() > 0) {
+        store(path, thumbnail);
+    }
+    return thumbnail;
+}
+
+size_t ThumbnailCache::prune(size_t maxBytes) const {
+    struct Entry {
+        fs::path path;
+        fs::file_time_type modified;
+        uintmax_t size;
+    };
+    std::vector<Entry> entries;
+    uintmax_t total = 0;
+    std::error_code error;
+    for (const auto& file : fs::directory_iterator(directory, error)) {
+        if (!file.is_regular_file(error) || file.path().extension() != ".iftn") continue;
+        Entry entry{file.path(), file.last_write_time(error), file.file_size(error)};
+        if (error) continue;
+        total += entry.size;
+        entries.push_back(std::move(entry));
+    }
+
+    std::sort(entries.begin(), entries.end(),
+              [](const Entry& a, const Entry& b) { return a.modified < b.modified; });
+    size_t removed = 0;
+    for (const Entry& entry : entries) {
+        if (total <= maxBytes) break;
+        if (fs::remove(entry.path, error)) {
+            total -= entry.size;
+            ++removed;
+        }
+    }
+    return removed;
+}
@@ -0,0 +1,329 @@
+/**
+ * @file TileCache.cpp
+ * @brief Lazy source pyramid, on-demand tile processing and LRU eviction
+ *
+ * @details
+ * tile() looks the key up under the mutex, then (on a miss) computes the
+ * tile without holding it, against the pipeline and level captured at
+ * lookup time. The result is inserted only if setPipeline()/setSource()
+ * did not run in between (same generation). Two threads missing the same
+ * tile may both compute it; the second insert replaces the first.
+ *
+ * Filters keep per-call state (timings, history), so the pipeline copy
+ * held by the cache is never run: each miss borrows an instance from
+ * idlePipelines, or clones one, and returns it afterwards. There are thus
+ * as many instances as threads that ever computed at the same time.
+ *
+ * The processed pyramid of a whole-image pipeline is built under
+ * chainMutex: the first miss runs the pipeline, the threads waiting
+ * behind it find the result, and deeper levels are halved from the
+ * deepest one already built.
+ *
+ * Level sizes: w_L = ceil(w / 2^L), the size repeated halve() calls give.
+ *
+ * @see TileCache.hpp for the tiling scheme
+ * @author Rowan HOUPA
+ * @date January 2026
+ */
+
+#include "TileCache.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+TileCache::TileCache(int tileSize, size_t maxBytes)
+    : tileSize(std::max(16, tileSize)), maxBytes(maxBytes) {}
+
+void TileCache::setSource(std::shared_ptr<const Image> image) {
+    std::lock_guard<std::mutex> lock(mutex);
+    source = std::move(image);
+    levels.clear();
+    if (source) {
+        levels.push_back(source);
+    }
+    processed.clear();
+    tiles.clear();
+    recent.clear();
+    stats.tiles = 0;
+    stats.bytes = 0;
+    ++generation;
+}
+
+void TileCache::setPipeline(const FilterPipeline& newPipeline) {
+    auto copy = std::make_shared<const FilterPipeline>(newPipeline);
+    std::lock_guard<std::mutex> lock(mutex);
+    pipeline = std::move(copy);
+    idlePipelines.clear();
+    processed.clear();
+    tiles.clear();
+    recent.clear();
+    stats.tiles = 0;
+    stats.bytes = 0;
+    ++generation;
+}
+
+void TileCache::clear() {
+    setSource(nullptr);
+}
+
+void TileCache::shareSource(const TileCache& other) {
+    if (&other == this) return;
+    std::scoped_lock lock(mutex, other.mutex);
+    source = other.source;
+    levels = other.levels;
+    processed.clear();
+    tiles.clear();
+    recent.clear();
+    stats.tiles = 0;
+    stats.bytes = 0;
+    ++generation;
+}
+
+size_t TileCache::adoptTiles(const TileCache& other) {
+    if (&other == this) return 0;
+    std::scoped_lock lock(mutex, other.mutex);
+    if (!source || source != other.source) {
+        return 0;
+    }
+    if (processed.empty()) {
+        processed = other.processed;
+    }
+    // Least recently used first, so the other cache's order is kept
+    size_t adopted = 0;
+    for (auto it = other.recent.rbegin(); it != other.recent.rend(); ++it) {
+        if (tiles.find(*it) == tiles.end()) {
+            insertLocked(*it, other.tiles.at(*it).image);
+            ++adopted;
+        }
+    }
+    return adopted;
+}
+
+bool TileCache::hasSource() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return source != nullptr;
+}
+
+uint64_t TileCache::getGeneration() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return generation;
+}
+
+int TileCache::getLevelCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!source) return 0;
+    const int largest = std::max(source->getWidth(), source->getHeight());
+    int level = 0;
+    while ((largest + (1 << level) - 1) >> level > tileSize) {
+        ++level;
+    }
+    return level + 1;
+}
+
+int TileCache::getLevelWidth(int level) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return source ? (source->getWidth() + (1 << level) - 1) >> level : 0;
+}
+
+int TileCache::getLevelHeight(int level) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return source ? (source->getHeight() + (1 << level) - 1) >> level : 0;
+}
+
+int TileCache::levelForZoom(double zoom) {
+    int level = 0;
+    while (level < 16 && zoom * (1 << (level + 1)) <= 1.0) {
+        ++level;
+    }
+    return level;
+}
+
+std::shared_ptr<const Image> TileCache::tile(int level, int tx, int ty, bool runFullImage) {
+    std::shared_ptr<const Image> fullImage;
+    std::shared_ptr<const Image> levelImage;
+    std::shared_ptr<const Image> processedLevel;
+    std::shared_ptr<const FilterPipeline> tilePipeline;
+    std::unique_ptr<FilterPipeline> instance;
+    uint64_t tileGeneration = 0;
+    const uint64_t tileKey = key(level, tx, ty);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!source) return nullptr;
+
+        auto it = tiles.find(tileKey);
+        if (it != tiles.end()) {
+            recent.splice(recent.begin(), recent, it->second.position);
+            ++stats.hits;
+            return it->second.image;
+        }
+        if (!runFullImage && pipeline && !pipeline->empty() && pipeline->getHaloRadius() < 0 &&
+            processed.empty()) {
+            return nullptr;
+        }
+        ++stats.misses;
+
+        fullImage = source;
+        levelImage = levelLocked(level);
+        tilePipeline = pipeline;
+        tileGeneration = generation;
+        if (tilePipeline && tilePipeline->getHaloRadius() < 0 && level < static_cast<int>(processed.size())) {
+            processedLevel = processed[level];
+        }
+        if (!idlePipelines.empty()) {
+            instance = std::move(idlePipelines.back());
+            idlePipelines.pop_back();
+        }
+    }
+
+    const int x = tx * tileSize;
+    const int y = ty * tileSize;
+    if (tx < 0 || ty < 0 || x >= levelImage->getWidth() || y >= levelImage->getHeight()) {
+        throw std::out_of_range("TileCache::tile: tile out of range");
+    }
+    const int width = std::min(tileSize, levelImage->getWidth() - x);
+    const int height = std::min(tileSize, levelImage->getHeight() - y);
+
+    std::shared_ptr<const Image> result;
+    if (!tilePipeline || tilePipeline->empty()) {
+        result = std::make_shared<const Image>(levelImage->crop(x, y, width, height));
+    } else {
+        if (!instance) {
+            instance = std::make_unique<FilterPipeline>(*tilePipeline);
+        }
+        if (tilePipeline->getHaloRadius() >= 0) {
+            result = std::make_shared<const Image>(instance->applyRegion(*levelImage, x, y, width, height));
+        } else {
+            if (!processedLevel) {
+                processedLevel = processedChain(level, tileGeneration, *fullImage, *instance);
+            }
+            result = std::make_shared<const Image>(processedLevel->crop(x, y, width, height));
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (instance && pipeline == tilePipeline) {
+        idlePipelines.push_back(std::move(instance));
+    }
+    if (generation == tileGeneration) {
+        insertLocked(tileKey, result);
+    }
+    return result;
+}
+
+std::shared_ptr<const Image> TileCache::processedChain(int level, uint64_t chainGeneration, const Image& fullImage,
+                                                      FilterPipeline& instance) {
+    std::lock_guard<std::mutex> chainLock(chainMutex);
+    std::vector<std::shared_ptr<const Image>> chain;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (generation == chainGeneration) {
+            chain = processed;
+        }
+    }
+    if (static_cast<int>(chain.size()) > level) {
+        return chain[level];
+    }
+
+    // Whole-image pipeline: full resolution once per generation, then its own pyramid
+    if (chain.empty()) {
+        chain.push_back(std::make_shared<const Image>(instance.apply(fullImage)));
+        if (chain.front()->getWidth() != fullImage.getWidth() ||
+            chain.front()->getHeight() != fullImage.getHeight()) {
+            throw std::invalid_argument("TileCache: pipeline changes the image size");
+        }
+    }
+    while (static_cast<int>(chain.size()) <= level) {
+        chain.push_back(std::make_shared<const Image>(halve(*chain.back())));
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (generation == chainGeneration && chain.size() > processed.size()) {
+        processed = chain;
+    }
+    return chain[level];
+}
+
+std::shared_ptr<const Image> TileCache::sourceTile(int level, int tx, int ty) {
+    std::shared_ptr<const Image> levelImage;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!source) return nullptr;
+        levelImage = levelLocked(level);
+    }
+    const int x = tx * tileSize;
+    const int y = ty * tileSize;
+    if (tx < 0 || ty < 0 || x >= levelImage->getWidth() || y >= levelImage->getHeight()) {
+        throw std::out_of_range("TileCache::sourceTile: tile out of range");
+    }
+    return std::make_shared<const Image>(levelImage->crop(x, y, std::min(tileSize, levelImage->getWidth() - x),
+                                                          std::min(tileSize, levelImage->getHeight() - y)));
+}
+
+std::shared_ptr<const Image> TileCache::find(int level, int tx, int ty) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = tiles.find(key(level, tx, ty));
+    return it != tiles.end() ? it->second.image : nullptr;
+}
+
+TileCache::Stats TileCache::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return stats;
+}
+
+std::shared_ptr<const Image> TileCache::levelLocked(int level) {
+    if (level < 0 || level > 30) {
+        throw std::out_of_range("TileCache: pyramid level out of range");
+    }
+    while (static_cast<int>(levels.size()) <= level) {
+        levels.push_back(std::make_shared<const Image>(halve(*levels.back())));
+    }
+    return levels[level];
+}
+
+void TileCache::insertLocked(uint64_t tileKey, std::shared_ptr<const Image> image) {
+    auto it = tiles.find(tileKey);
+    if (it != tiles.end()) {
+        stats.bytes -= it->second.image->size();
+        recent.erase(it->second.position);
+        tiles.erase(it);
+    }
+
+    recent.push_front(tileKey);
+    stats.bytes += image->size();
+    tiles.emplace(tileKey, Entry{std::move(image), recent.begin()});
+
+    // Keep at least the tile just inserted
+    while (stats.bytes > maxBytes && recent.size() > 1) {
+        auto victim = tiles.find(recent.back());
+        stats.bytes -= victim->second.image->size();
+        tiles.erase(victim);
+        recent.pop_back();
+    }
+    stats.tiles = tiles.size();
+}
+
+Image TileCache::halve(const Image& image) {
+    const int width = image.getWidth();
+    const int height = image.getHeight();
+    const int channels = image.getChannels();
+    const int outWidth = (width + 1) / 2;
+    const int outHeight = (height + 1) / 2;
+    Image result(outWidth, outHeight, channels);
+    const uint8_t* src = image.data();
+    uint8_t* dst = result.data();
+
+    #pragma omp parallel for schedule(static)
+    for (int y = 0; y < outHeight; ++y) {
+        const uint8_t* row0 = src + static_cast<size_t>(2 * y) * width * channels;
+        const uint8_t* row1 = src + static_cast<size_t>(std::min(2 * y + 1, height - 1)) * width * channels;
+        uint8_t* out = dst + static_cast<size_t>(y) * outWidth * channels;
+        for (int x = 0; x < outWidth; ++x) {
+            const int i0 = 2 * x * channels;
+            const int i1 = std::min(2 * x + 1, width - 1) * channels;
+            for (int c = 0; c < channels; ++c) {
+                out[x * channels + c] = static_cast<uint8_t>(
+                    (row0[i0 + c] + row0[i1 + c] + row1[i0 + c] + row1[i1 + c] + 2) >> 2);
+            }
+        }
+    }
+    return result;
+}
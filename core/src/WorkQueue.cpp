@@ -0,0 +1,351 @@
+/**
+ * @file WorkQueue.cpp
+ * @brief Claims, heartbeats and reports of the shared batch queue
+ *
+ * @details
+ * Claim files are only ever opened for update ("r+b"), never created
+ * outside claim(): a heartbeat racing with a requeue then fails to open the
+ * file instead of leaving a stray claim behind. Stats files are written to
+ * a temporary file and renamed, so report() never reads half a line.
+ *
+ * @see WorkQueue.hpp for the directory layout
+ * @author Rowan HOUPA
+ * @date January 2026
+ */
+
+#include "WorkQueue.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <sstream>
+
+namespace fs = std::filesystem;
+
+namespace {
+    constexpr char CLAIM_SEPARATOR = '@';
+
+    double epochSeconds() {
+        return std::chrono::duration<double>(std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+
+    std::string sanitize(const std::string& id) {
+        std::string clean = id.empty() ? std::string("worker") : id;
+        for (char& c : clean) {
+            const bool allowed = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+                                 (c >= '0' && c <= '9') || c == '-' || c == '_' || c == '.';
+            if (!allowed) c = '_';
+        }
+        return clean;
+    }
+
+    // Appends line to an existing file; false if it is gone (never creates it)
+    bool appendExisting(const fs::path& path, const std::string& line) {
+        std::FILE* file = std::fopen(path.string().c_str(), "r+b");
+        if (!file) return false;
+        std::fseek(file, 0, SEEK_END);
+        const bool written = std::fputs(line.c_str(), file) >= 0;
+        return std::fclose(file) == 0 && written;
+    }
+
+    bool writeAtomically(const fs::path& path, const std::string& contents) {
+        const fs::path temporary = path.string() + ".tmp";
+        {
+            std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+            if (!out) return false;
+            out << contents;
+            if (!out) return false;
+        }
+        std::error_code error;
+        fs::rename(temporary, path, error);
+        return !error;
+    }
+
+    size_t countEntries(const fs::path& directory) {
+        std::error_code error;
+        size_t count = 0;
+        for (fs::directory_iterator it(directory, error), end; !error && it != end; it.increment(error)) {
+            ++count;
+        }
+        return count;
+    }
+
+    bool parseStats(const fs::path& path, WorkQueue::WorkerStats& stats) {
+        std::ifstream in(path);
+        return static_cast<bool>(in >> stats.worker >> stats.done >> stats.failed >> stats.lost >> stats.pixels
+                                    >> stats.busyMs >> stats.firstClaim >> stats.lastUpdate);
+    }
+}
+
+double WorkQueue::WorkerStats::itemsPerSecond() const {
+    const double seconds = elapsedSeconds();
+    return seconds > 0.0 ? (done + failed) / seconds : 0.0;
+}
+
+double WorkQueue::WorkerStats::megapixelsPerSecond() const {
+    const double seconds = elapsedSeconds();
+    return seconds > 0.0 ? pixels / 1e6 / seconds : 0.0;
+}
+
+WorkQueue::WorkQueue(std::string directory, std::string workerId)
+    : directory(std::move(directory)), workerId(sanitize(workerId)) {
+    stats.worker = this->workerId;
+    std::error_code error;
+    for (const char* sub : {"claimed", "done", "failed", "workers"}) {
+        fs::create_directories(fs::path(this->directory) / sub, error);
+    }
+}
+
+WorkQueue::~WorkQueue() {
+    stopHeartbeat();
+}
+
+bool WorkQueue::exists() const {
+    std::error_code error;
+    return fs::is_directory(fs::path(directory) / "pending", error);
+}
+
+bool WorkQueue::create(const std::function<std::vector<std::string>()>& listInputs, double waitSeconds) {
+    const fs::path root(directory);
+    if (exists()) return false;
+
+    std::error_code error;
+    if (fs::create_directory(root / "init.lock", error) && !error) {
+        const std::vector<std::string> inputs = listInputs();
+        const fs::path staging = root / "pending.tmp";
+        fs::remove_all(staging, error);
+        fs::create_directory(staging, error);
+
+        std::string manifest;
+        char id[32];
+        for (size_t i = 0; i < inputs.size(); ++i) {
+            const std::string path = fs::absolute(inputs[i], error).lexically_normal().string();
+            std::snprintf(id, sizeof(id), "%08zu", i);
+            std::ofstream(staging / id, std::ios::binary) << path << "\n";
+            manifest += path + "\n";
+        }
+        writeAtomically(root / "manifest.txt", manifest);
+
+        // Workers waiting in create() see all items or none
+        fs::rename(staging, root / "pending", error);
+        return !error;
+    }
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::duration<double>(waitSeconds);
+    while (!exists() && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    }
+    return false;
+}
+
+bool WorkQueue::claim(Item& item) {
+    const fs::path root(directory);
+    bool relisted = false;
+
+    while (true) {
+        if (candidates.empty()) {
+            // A whole fresh listing lost to other workers: let the caller wait
+            if (relisted) return false;
+            std::error_code error;
+            for (fs::directory_iterator it(root / "pending", error), end; !error && it != end; it.increment(error)) {
+                candidates.push_back(it->path().filename().string());
+            }
+            if (candidates.empty()) return false;
+
+            // Start at a different item per worker, then go in manifest order
+            std::sort(candidates.begin(), candidates.end());
+            const size_t start = std::hash<std::string>{}(workerId) % candidates.size();
+            std::rotate(candidates.begin(), candidates.begin() + static_cast<std::ptrdiff_t>(start), candidates.end());
+            std::reverse(candidates.begin(), candidates.end());
+            relisted = true;
+        }
+
+        const std::string name = candidates.back();
+        candidates.pop_back();
+        const std::string claimName = name + CLAIM_SEPARATOR + workerId;
+        const fs::path claimPath = root / "claimed" / claimName;
+
+        std::error_code error;
+        fs::rename(root / "pending" / name, claimPath, error);
+        // Over NFS a retried rename can report an error after succeeding
+        if (error && !fs::exists(claimPath, error)) continue;
+        // A rename keeps the time the item was queued at: touch the claim
+        // now, or requeueStale() would take a fresh claim for a stale one
+        if (!appendExisting(claimPath, "claimed " + workerId + "\n")) continue;
+
+        std::ifstream in(claimPath);
+        item.id = name;
+        if (!std::getline(in, item.path)) item.path.clear();
+
+        std::lock_guard<std::mutex> lock(mutex);
+        claims.insert(claimName);
+        if (stats.firstClaim == 0.0) stats.firstClaim = epochSeconds();
+        return true;
+    }
+}
+
+bool WorkQueue::complete(const Item& item, bool success, double ms, uint64_t pixels) {
+    const fs::path root(directory);
+    const std::string claimName = item.id + CLAIM_SEPARATOR + workerId;
+    const fs::path finished = root / (success ? "done" : "failed") / item.id;
+
+    std::error_code error;
+    fs::rename(root / "claimed" / claimName, finished, error);
+    const bool kept = !error;
+    if (kept) {
+        std::ostringstream line;
+        line << workerId << (success ? " done " : " failed ") << ms << " ms\n";
+        appendExisting(finished, line.str());
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    claims.erase(claimName);
+    if (!kept) {
+        ++stats.lost;
+    } else if (success) {
+        ++stats.done;
+        stats.pixels += pixels;
+    } else {
+        ++stats.failed;
+    }
+    stats.busyMs += ms;
+    stats.lastUpdate = epochSeconds();
+    return kept;
+}
+
+size_t WorkQueue::requeueStale(double timeoutSeconds) {
+    const fs::path root(directory);
+    std::lock_guard<std::mutex> requeueLock(requeueMutex);
+
+    // "Now" on the file server's clock, the one claim times are in
+    const fs::path probe = root / "workers" / (workerId + ".clock");
+    std::ofstream(probe, std::ios::trunc) << epochSeconds() << "\n";
+    std::error_code error;
+    const auto now = fs::last_write_time(probe, error);
+    if (error) return 0;
+    const auto timeout = std::chrono::duration_cast<fs::file_time_type::duration>(
+        std::chrono::duration<double>(timeoutSeconds));
+
+    std::vector<std::string> stale;
+    for (fs::directory_iterator it(root / "claimed", error), end; !error && it != end; it.increment(error)) {
+        std::error_code timeError;
+        const auto modified = it->last_write_time(timeError);
+        if (!timeError && now - modified > timeout) {
+            stale.push_back(it->path().filename().string());
+        }
+    }
+
+    size_t requeued = 0;
+    for (const std::string& claimName : stale) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (claims.count(claimName)) continue;
+        }
+        const size_t separator = claimName.rfind(CLAIM_SEPARATOR);
+        if (separator == std::string::npos) continue;
+        std::error_code renameError;
+        fs::rename(root / "claimed" / claimName, root / "pending" / claimName.substr(0, separator), renameError);
+        if (!renameError) ++requeued;
+    }
+    return requeued;
+}
+
+bool WorkQueue::isFinished() const {
+    const fs::path root(directory);
+    return countEntries(root / "pending") == 0 && countEntries(root / "claimed") == 0;
+}
+
+void WorkQueue::startHeartbeat(double intervalSeconds, double staleSeconds) {
+    stopHeartbeat();
+    heartbeatInterval = std::max(0.1, intervalSeconds);
+    staleTimeout = staleSeconds;
+    heartbeatStop = false;
+    heartbeatThread = std::thread([this] {
+        std::unique_lock<std::mutex> lock(heartbeatMutex);
+        while (!heartbeatWake.wait_for(lock, std::chrono::duration<double>(heartbeatInterval),
+                                       [this] { return heartbeatStop; })) {
+            lock.unlock();
+            heartbeat();
+            lock.lock();
+        }
+    });
+}
+
+void WorkQueue::stopHeartbeat() {
+    if (heartbeatThread.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(heartbeatMutex);
+            heartbeatStop = true;
+        }
+        heartbeatWake.notify_all();
+        heartbeatThread.join();
+    }
+    writeStats();
+}
+
+void WorkQueue::heartbeat() {
+    std::set<std::string> held;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        held = claims;
+    }
+    const fs::path claimed = fs::path(directory) / "claimed";
+    for (const std::string& claimName : held) {
+        appendExisting(claimed / claimName, "heartbeat " + workerId + "\n");
+    }
+    writeStats();
+    if (staleTimeout > 0.0) {
+        requeueStale(staleTimeout);
+    }
+}
+
+void WorkQueue::writeStats() const {
+    const WorkerStats snapshot = getStats();
+    if (snapshot.firstClaim == 0.0) return;
+    std::ostringstream line;
+    line.precision(17);
+    line << snapshot.worker << " " << snapshot.done << " " << snapshot.failed << " " << snapshot.lost << " "
+         << snapshot.pixels << " " << snapshot.busyMs << " " << snapshot.firstClaim << " "
+         << snapshot.lastUpdate << "\n";
+    writeAtomically(fs::path(directory) / "workers" / (workerId + ".stats"), line.str());
+}
+
+WorkQueue::WorkerStats WorkQueue::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return stats;
+}
+
+WorkQueue::Report WorkQueue::report(const std::string& directory) {
+    const fs::path root(directory);
+    Report result;
+    result.pending = countEntries(root / "pending");
+    result.claimed = countEntries(root / "claimed");
+    result.done = countEntries(root / "done");
+    result.failed = countEntries(root / "failed");
+
+    std::error_code error;
+    for (fs::directory_iterator it(root / "workers", error), end; !error && it != end; it.increment(error)) {
+        WorkerStats worker;
+        if (it->path().extension() != ".stats" || !parseStats(it->path(), worker)) continue;
+        result.workers.push_back(worker);
+    }
+    std::sort(result.workers.begin(), result.workers.end(),
+              [](const WorkerStats& a, const WorkerStats& b) { return a.worker < b.worker; });
+
+    WorkerStats& total = result.total;
+    total.worker = "total";
+    for (const WorkerStats& worker : result.workers) {
+        total.done += worker.done;
+        total.failed += worker.failed;
+        total.lost += worker.lost;
+        total.pixels += worker.pixels;
+        total.busyMs += worker.busyMs;
+        if (worker.firstClaim > 0.0 && (total.firstClaim == 0.0 || worker.firstClaim < total.firstClaim)) {
+            total.firstClaim = worker.firstClaim;
+        }
+        total.lastUpdate = std::max(total.lastUpdate, worker.lastUpdate);
+    }
+    return result;
+}
@@ -0,0 +1,178 @@
+/**
+ * @file BlendFilter.cpp
+ * @brief CPU implementation of alpha compositing / blend modes using OpenMP
+ *
+ * Composites the overlay onto the image in place, row by row.
+ *
+ * @details
+ * Per row of the overlay/image intersection:
+ * 1. Source alpha (overlay alpha * opacity), backdrop alpha and result alpha
+ *    are computed once into small per-thread arrays
+ * 2. Each color channel is then processed in a separate `omp simd` loop:
+ *    premultiply, composite (blendmath::compositePremultiplied), and
+ *    unpremultiply only when the image keeps an alpha channel
+ * 3. The result alpha is written last
+ *
+ * All arithmetic is unsigned 32-bit integer with the exact div-255 rounding,
+ * which vectorizes to 16/32-bit SIMD lanes (no float conversions).
+ *
+ * Overlay cache:
+ * - loadOverlayCached() keeps decoded overlays in a process-wide map
+ *   protected by a mutex; a batch run decodes its watermark once
+ *
+ * @see BlendFilterGPU.cpp for the SYCL version
+ * @author Rowan HOUPA
+ * @date January 2026
+ */
+
+#include "filters/BlendFilter.hpp"
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace {
+    std::mutex overlayCacheMutex;
+    std::map<std::string, std::shared_ptr<const Image>> overlayCache;
+}
+
+bool BlendFilter::computePlacement(const Image& image, Placement& placement) const {
+    if (!overlay || overlay->getWidth() == 0 || image.getWidth() == 0) {
+        return false;
+    }
+
+    placement.opacity8 = static_cast<uint32_t>(std::clamp(opacity, 0.0f, 1.0f) * 255.0f + 0.5f);
+    placement.x0 = std::max(0, offsetX);
+    placement.y0 = std::max(0, offsetY);
+    placement.x1 = std::min(image.getWidth(), offsetX + overlay->getWidth());
+    placement.y1 = std::min(image.getHeight(), offsetY + overlay->getHeight());
+
+    return placement.opacity8 > 0 && placement.x0 < placement.x1 && placement.y0 < placement.y1;
+}
+
+void BlendFilter::apply(const Image& input, Image& output) {
+    // Copy first so pixels outside the overlay pass through unchanged
+    output = input;
+    applyInPlace(output);
+}
+
+void BlendFilter::applyInPlace(Image& image) {
+    auto start = std::chrono::high_resolution_clock::now();
+
+    Placement placement;
+    if (!computePlacement(image, placement)) {
+        lastExecutionTime = 0.0;
+        return;
+    }
+
+    const int width = image.getWidth();
+    const int channels = image.getChannels();
+    const bool hasAlpha = (channels == 2 || channels == 4);
+    const int colorChannels = hasAlpha ? channels - 1 : channels;
+
+    const int overlayWidth = overlay->getWidth();
+    const int overlayChannels = overlay->getChannels();
+    const bool overlayHasAlpha = (overlayChannels == 2 || overlayChannels == 4);
+    const int overlayColorChannels = overlayHasAlpha ? overlayChannels - 1 : overlayChannels;
+
+    const int spanWidth = placement.x1 - placement.x0;
+    const uint32_t opacity8 = placement.opacity8;
+    const BlendMode mode = blendMode;
+
+    uint8_t* pixels = image.data();
+    const uint8_t* overlayPixels = overlay->data();
+
+    #pragma omp parallel
+    {
+        std::vector<uint32_t> srcAlpha(spanWidth);
+        std::vector<uint32_t> dstAlpha(spanWidth);
+        std::vector<uint32_t> outAlpha(spanWidth);
+
+        #pragma omp for schedule(static)
+        for (int y = placement.y0; y < placement.y1; ++y) {
+            uint8_t* row = pixels + (static_cast<size_t>(y) * width + placement.x0) * channels;
+            const uint8_t* overlayRow = overlayPixels +
+                (static_cast<size_t>(y - offsetY) * overlayWidth + (placement.x0 - offsetX)) * overlayChannels;
+
+            uint32_t* sa = srcAlpha.data();
+            uint32_t* da = dstAlpha.data();
+            uint32_t* ao = outAlpha.data();
+
+            #pragma omp simd
+            for (int i = 0; i < spanWidth; ++i) {
+                uint32_t a = overlayHasAlpha ? overlayRow[i * overlayChannels + overlayChannels - 1] : 255u;
+                sa[i] = blendmath::div255(a * opacity8);
+                da[i] = hasAlpha ? row[i * channels + channels - 1] : 255u;
+                ao[i] = sa[i] + da[i] - blendmath::div255(sa[i] * da[i]);
+            }
+
+            for (int c = 0; c < colorChannels; ++c) {
+                // Gray overlays feed every channel; gray images take the first overlay channel
+                const int oc = std::min(c, overlayColorChannels - 1);
+
+                #pragma omp simd
+                for (int i = 0; i < spanWidth; ++i) {
+                    uint32_t d = row[i * channels + c];
+                    uint32_t s = overlayRow[i * overlayChannels + oc];
+                    uint32_t result = blendmath::compositePremultiplied(
+                        mode, blendmath::div255(s * sa[i]), sa[i],
+                        blendmath::div255(d * da[i]), da[i], d, s);
+                    if (hasAlpha) {
+                        result = blendmath::unpremultiply(result, ao[i]);
+                    }
+                    row[i * channels + c] = static_cast<uint8_t>(result);
+                }
+            }
+
+            if (hasAlpha) {
+                #pragma omp simd
+                for (int i = 0; i < spanWidth; ++i) {
+                    row[i * channels + channels - 1] = static_cast<uint8_t>(ao[i]);
+                }
+            }
+        }
+    }
+
+    auto end = std::chrono::high_resolution_clock::now();
+    lastExecutionTime = std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+std::shared_ptr<const Image> BlendFilter::loadOverlayCached(const std::string& filepath) {
+    std::lock_guard<std::mutex> lock(overlayCacheMutex);
+
+    auto it = overlayCache.find(filepath);
+    if (it != overlayCache.end()) {
+        return it->second;
+    }
+
+    auto image = std::make_shared<Image>();
+    if (!image->loadFromFile(filepath)) {
+        return nullptr;
+    }
+
+    overlayCache[filepath] = image;
+    return image;
+}
+
+void BlendFilter::clearOverlayCache() {
+    std::lock_guard<std::mutex> lock(overlayCacheMutex);
+    overlayCache.clear();
+}
+
+std::string BlendFilter::modeToString(BlendMode mode) {
+    switch (mode) {
+        case BlendMode::Multiply: return "multiply";
+        case BlendMode::Screen:   return "screen";
+        case BlendMode::Overlay:  return "overlay";
+        case BlendMode::Over:
+        default:                  return "over";
+    }
+}
+
+bool BlendFilter::modeFromString(const std::string& name, BlendMode& mode) {
+    if (name == "over")     { mode = BlendMode::Over;     return true; }
+    if (name == "multiply") { mode = BlendMode::Multiply; return true; }
+    if (name == "screen")   { mode = BlendMode::Screen;   return true; }
+    if (name == "overlay")  { mode = BlendMode::Overlay;  return true; }
+    return false;
+}
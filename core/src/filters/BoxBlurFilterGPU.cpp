@@ -45,6 +45,7 @@ void BoxBlurFilterGPU::apply(const Image& input, Image& output) {
     
     try {
         sycl::queue q(sycl::gpu_selector_v);
+        reportDevice(q.get_device().get_info<sycl::info::device::name>());
         
         std::cout << "BoxBlur GPU sur: " 
                   << q.get_device().get_info<sycl::info::device::name>() 
@@ -106,6 +107,7 @@ void BoxBlurFilterGPU::apply(const Image& input, Image& output) {
     } catch (sycl::exception const& e) {
         std::cerr << "SYCL exception: " << e.what() << std::endl;
         std::cerr << "↩Fallback sur CPU..." << std::endl;
+        reportDevice("CPU");
         
         BoxBlurFilter cpuFallback(blurRadius);
         cpuFallback.apply(input, output);
@@ -15,6 +15,7 @@
  * - Uses OpenMP collapse(2) to parallelize both X and Y loops
  * - Combined iteration space divided among threads
  * - Better load distribution than parallelizing only outer loop
+ * - applyInPlace() uses a flat loop over the buffer (no output allocation)
  *
  * Usage:
  * - factor = 0.5: 50% darker
@@ -50,3 +51,14 @@ void BrightnessFilter::apply(const Image& input, Image& output) {
         }
     }
 }
+
+void BrightnessFilter::applyInPlace(Image& image) {
+    int totalValues = image.getWidth() * image.getHeight() * image.getChannels();
+    uint8_t* pixels = image.data();
+    
+    #pragma omp parallel for schedule(static)
+    for (int i = 0; i < totalValues; ++i) {
+        float pixel = static_cast<float>(pixels[i]) * brightnessFactor;
+        pixels[i] = static_cast<uint8_t>(std::clamp(pixel, 0.0f, 255.0f));
+    }
+}
@@ -0,0 +1,238 @@
+/**
+ * @file DitherFilter.cpp
+ * @brief Ordered and wavefront-parallel Floyd-Steinberg dithering (OpenMP)
+ *
+ * @details
+ * Quantization: value v maps to round(v / step) * step with
+ * step = 255 / (levels - 1), tabulated for error diffusion.
+ *
+ * Ordered:
+ * - v + step * ((bayer + 0.5) / 64 - 0.5) is rounded to the nearest level;
+ *   the Bayer offsets of a row are expanded once so the inner loop is a
+ *   straight `omp simd` float loop
+ *
+ * Floyd-Steinberg (left to right on every row):
+ * - Errors are integers; a pixel's corrected value is
+ *   v + round((incoming 7/16, 3/16, 5/16, 1/16 contributions) / 16)
+ * - Wavefront: thread t processes rows t, t + T, t + 2T... Before handling
+ *   pixels [x0, x1) of row y it waits until row y - 1 has published
+ *   progress >= min(width, x1 + 1). Row y then only reads error slots that
+ *   row y - 1 will never touch again.
+ * - Ring of T + 2 error rows: when a thread starts row y, every row up to
+ *   y - T is finished (row y - T ran on the same thread and could only
+ *   finish after row y - T - 1), so slot (y + 1) mod (T + 2) is free
+ *
+ * @see DitherFilter.hpp for the class interface
+ * @author Rowan HOUPA
+ * @date January 2026
+ */
+
+#include "filters/DitherFilter.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace {
+
+constexpr int PROGRESS_CHUNK = 64;
+
+constexpr std::array<std::array<uint8_t, 8>, 8> BAYER8 = {{
+    {{ 0, 32,  8, 40,  2, 34, 10, 42}},
+    {{48, 16, 56, 24, 50, 18, 58, 26}},
+    {{12, 44,  4, 36, 14, 46,  6, 38}},
+    {{60, 28, 52, 20, 62, 30, 54, 22}},
+    {{ 3, 35, 11, 43,  1, 33,  9, 41}},
+    {{51, 19, 59, 27, 49, 17, 57, 25}},
+    {{15, 47,  7, 39, 13, 45,  5, 37}},
+    {{63, 31, 55, 23, 61, 29, 53, 21}}
+}};
+
+std::array<uint8_t, 256> buildQuantizeTable(int levels) {
+    std::array<uint8_t, 256> table;
+    const float step = 255.0f / (levels - 1);
+    for (int v = 0; v < 256; ++v) {
+        table[v] = static_cast<uint8_t>(std::lround(std::round(v / step) * step));
+    }
+    return table;
+}
+
+} // namespace
+
+void DitherFilter::apply(const Image& input, Image& output) {
+    auto start = std::chrono::high_resolution_clock::now();
+
+    if (ditherMode == DitherMode::Ordered) {
+        applyOrdered(input, output);
+    } else {
+        applyErrorDiffusion(input, output, true);
+    }
+
+    auto end = std::chrono::high_resolution_clock::now();
+    lastExecutionTime = std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+void DitherFilter::applySequential(const Image& input, Image& output) {
+    auto start = std::chrono::high_resolution_clock::now();
+
+    if (ditherMode == DitherMode::Ordered) {
+        applyOrdered(input, output);
+    } else {
+        applyErrorDiffusion(input, output, false);
+    }
+
+    auto end = std::chrono::high_resolution_clock::now();
+    lastExecutionTime = std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+void DitherFilter::applyOrdered(const Image& input, Image& output) const {
+    const int width = input.getWidth();
+    const int height = input.getHeight();
+    const int channels = input.getChannels();
+    const bool hasAlpha = (channels == 2 || channels == 4);
+    const int rowValues = width * channels;
+    output = Image(width, height, channels);
+
+    const float step = 255.0f / (levels - 1);
+    const float invStep = 1.0f / step;
+    const float maxLevel = static_cast<float>(levels - 1);
+    const uint8_t* src = input.data();
+    uint8_t* dst = output.data();
+
+    #pragma omp parallel
+    {
+        std::vector<float> bias(rowValues);
+
+        #pragma omp for schedule(static)
+        for (int y = 0; y < height; ++y) {
+            const auto& pattern = BAYER8[y & 7];
+            for (int x = 0; x < width; ++x) {
+                const float offset = step * ((pattern[x & 7] + 0.5f) / 64.0f - 0.5f);
+                for (int c = 0; c < channels; ++c) {
+                    bias[x * channels + c] = offset;
+                }
+            }
+            if (hasAlpha) {
+                for (int x = 0; x < width; ++x) {
+                    bias[x * channels + channels - 1] = 0.0f;
+                }
+            }
+
+            const uint8_t* in = src + static_cast<size_t>(y) * rowValues;
+            uint8_t* out = dst + static_cast<size_t>(y) * rowValues;
+            const float* b = bias.data();
+
+            #pragma omp simd
+            for (int i = 0; i < rowValues; ++i) {
+                float level = std::floor((in[i] + b[i]) * invStep + 0.5f);
+                level = std::min(std::max(level, 0.0f), maxLevel);
+                out[i] = static_cast<uint8_t>(level * step + 0.5f);
+            }
+
+            if (hasAlpha) {
+                for (int x = 0; x < width; ++x) {
+                    out[x * channels + channels - 1] = in[x * channels + channels - 1];
+                }
+            }
+        }
+    }
+}
+
+void DitherFilter::applyErrorDiffusion(const Image& input, Image& output, bool parallel) const {
+    const int width = input.getWidth();
+    const int height = input.getHeight();
+    const int channels = input.getChannels();
+    const bool hasAlpha = (channels == 2 || channels == 4);
+    const int colorChannels = hasAlpha ? channels - 1 : channels;
+    const size_t rowValues = static_cast<size_t>(width) * channels;
+    output = Image(width, height, channels);
+
+    const std::array<uint8_t, 256> quantize = buildQuantizeTable(levels);
+    const uint8_t* src = input.data();
+    uint8_t* dst = output.data();
+
+    int threads = 1;
+#ifdef _OPENMP
+    if (parallel) threads = std::max(1, std::min(omp_get_max_threads(), height));
+#endif
+
+    // Error rows hold 16 × error; one spare column on each side
+    const int ringSize = threads + 2;
+    const size_t errStride = static_cast<size_t>(width + 2) * channels;
+    std::vector<int32_t> errors(errStride * ringSize, 0);
+    std::vector<std::atomic<int>> progress(height);
+
+    auto errorRow = [&](int y) {
+        return errors.data() + static_cast<size_t>(y % ringSize) * errStride + channels;
+    };
+
+    auto waitFor = [&](int y, int needed) {
+        if (y < 0) return;
+        while (progress[y].load(std::memory_order_acquire) < needed) {
+            std::this_thread::yield();
+        }
+    };
+
+    auto processRow = [&](int y) {
+        const uint8_t* in = src + static_cast<size_t>(y) * rowValues;
+        uint8_t* out = dst + static_cast<size_t>(y) * rowValues;
+        const int32_t* incoming = errorRow(y);
+        int32_t* below = errorRow(y + 1);
+        std::fill(below - channels, below - channels + errStride, 0);
+
+        int32_t carry[4] = {0, 0, 0, 0};
+
+        for (int x0 = 0; x0 < width; x0 += PROGRESS_CHUNK) {
+            const int x1 = std::min(width, x0 + PROGRESS_CHUNK);
+            waitFor(y - 1, std::min(width, x1 + 1));
+
+            for (int x = x0; x < x1; ++x) {
+                const size_t i = static_cast<size_t>(x) * channels;
+                for (int c = 0; c < colorChannels; ++c) {
+                    const int32_t contribution = incoming[i + c] + carry[c];
+                    int32_t corrected = in[i + c] + ((contribution + 8) >> 4);
+                    corrected = std::clamp(corrected, 0, 255);
+                    const uint8_t q = quantize[corrected];
+                    const int32_t e = corrected - q;
+                    out[i + c] = q;
+
+                    carry[c] = 7 * e;
+                    below[i - channels + c] += 3 * e;
+                    below[i + c] += 5 * e;
+                    below[i + channels + c] += e;
+                }
+                if (hasAlpha) {
+                    out[i + channels - 1] = in[i + channels - 1];
+                }
+            }
+            progress[y].store(x1, std::memory_order_release);
+        }
+    };
+
+    if (threads == 1) {
+        for (int y = 0; y < height; ++y) {
+            processRow(y);
+        }
+        return;
+    }
+
+    #pragma omp parallel num_threads(threads)
+    {
+        // The runtime may grant fewer threads; rows are dealt over the real team
+        int tid = 0;
+        int team = 1;
+#ifdef _OPENMP
+        tid = omp_get_thread_num();
+        team = omp_get_num_threads();
+#endif
+        for (int y = tid; y < height; y += team) {
+            processRow(y);
+        }
+    }
+}
@@ -42,6 +42,7 @@ void GrayscaleFilterGPU::apply(const Image& input, Image& output) {
     
     try {
         sycl::queue q(sycl::gpu_selector_v);
+        reportDevice(q.get_device().get_info<sycl::info::device::name>());
         
         std::cout << " Exécution GPU sur: " 
                   << q.get_device().get_info<sycl::info::device::name>() 
@@ -82,6 +83,7 @@ void GrayscaleFilterGPU::apply(const Image& input, Image& output) {
     } catch (sycl::exception const& e) {
         std::cerr << "SYCL exception: " << e.what() << std::endl;
         std::cerr << "↩Fallback sur CPU..." << std::endl;
+        reportDevice("CPU");
         
         GrayscaleFilter cpuFallback;
         cpuFallback.apply(input, output);
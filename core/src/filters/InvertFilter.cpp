@@ -21,6 +21,7 @@
  * - Memory-bound operation (simple arithmetic)
  * - Scales well with core count
  * - Debug mode prints thread count and pixel count
+ * - applyInPlace() rewrites the buffer directly (no output allocation)
  *
  * @author Rowan HOUPA
  * @date January 2026
@@ -49,3 +50,14 @@ void InvertFilter::apply(const Image& input, Image& output) {
               << ", Pixels: " << totalPixels << std::endl;
     #endif
 }
+
+
+void InvertFilter::applyInPlace(Image& image) {
+    int totalPixels = image.getWidth() * image.getHeight() * image.getChannels();
+    uint8_t* pixels = image.data();
+    
+    #pragma omp parallel for schedule(dynamic, 256)
+    for (int i = 0; i < totalPixels; ++i) {
+        pixels[i] = 255 - pixels[i];
+    }
+}
@@ -0,0 +1,169 @@
+/**
+ * @file NLMeansFilter.cpp
+ * @brief CPU implementation of non-local means denoising using OpenMP
+ *
+ * @details
+ * Algorithm (per 64x64 output tile, per search offset d):
+ * 1. Squared-difference image D(p) = sum_c (I(p) - I(p + d))² over the tile
+ *    extended by the patch radius, accumulated into an integral image
+ * 2. Patch distance of every tile pixel = one rectangle sum of D
+ * 3. weight = exp(-distance / (patchArea * channels) / h²), read from a
+ *    table; offsets whose weight falls below ~1e-3 are skipped
+ * 4. weightSum(p) += weight, acc(p) += weight * I(p + d)
+ * Output = acc / weightSum. Borders are handled by clamping coordinates.
+ *
+ * Integral Image Precision:
+ * - The integral image is uint32 and may wrap around on large tiles; the
+ *   rectangle sums stay exact because a single patch sum never exceeds
+ *   2^32 (at most 255² * 4 channels * 11² values)
+ *
+ * Parallelization Strategy:
+ * - collapse(2) over tiles with dynamic scheduling
+ * - Each thread owns its integral image and accumulators (no sharing)
+ *
+ * @see NLMeansFilterGPU.cpp for the SYCL version
+ * @author Rowan HOUPA
+ * @date January 2026
+ */
+
+#include "filters/NLMeansFilter.hpp"
+#include <cmath>
+#include <vector>
+
+namespace {
+    constexpr int TILE_SIZE = 64;
+    constexpr float WEIGHT_CUTOFF = 6.9f; // exp(-6.9) ≈ 1e-3
+}
+
+void NLMeansFilter::apply(const Image& input, Image& output) {
+    auto start = std::chrono::high_resolution_clock::now();
+
+    const int width = input.getWidth();
+    const int height = input.getHeight();
+    const int channels = input.getChannels();
+    output = Image(width, height, channels);
+
+    const int pr = patchRadius;
+    const int sr = getEffectiveSearchRadius();
+    const int patchSide = 2 * pr + 1;
+    const float norm = 1.0f / static_cast<float>(patchSide * patchSide * channels);
+    const float h2 = strength * strength;
+
+    // exp(-d / h²) for every normalized distance below the cutoff
+    const int maxIndex = std::min(255 * 255, static_cast<int>(std::ceil(WEIGHT_CUTOFF * h2)));
+    std::vector<float> weightLut(maxIndex + 1);
+    for (int i = 0; i <= maxIndex; ++i) {
+        weightLut[i] = std::exp(-static_cast<float>(i) / h2);
+    }
+
+    const uint8_t* src = input.data();
+    uint8_t* dst = output.data();
+    const int tilesX = (width + TILE_SIZE - 1) / TILE_SIZE;
+    const int tilesY = (height + TILE_SIZE - 1) / TILE_SIZE;
+    const int maxRegion = TILE_SIZE + 2 * pr;
+
+    #pragma omp parallel
+    {
+        std::vector<uint32_t> integral(static_cast<size_t>(maxRegion + 1) * (maxRegion + 1), 0);
+        std::vector<float> acc(static_cast<size_t>(TILE_SIZE) * TILE_SIZE * channels);
+        std::vector<float> weightSum(static_cast<size_t>(TILE_SIZE) * TILE_SIZE);
+        std::vector<int> colP(maxRegion);
+        std::vector<int> colQ(maxRegion);
+        std::vector<int> colCenter(TILE_SIZE);
+
+        #pragma omp for collapse(2) schedule(dynamic)
+        for (int ty = 0; ty < tilesY; ++ty) {
+            for (int tx = 0; tx < tilesX; ++tx) {
+                const int x0 = tx * TILE_SIZE;
+                const int y0 = ty * TILE_SIZE;
+                const int tileW = std::min(width, x0 + TILE_SIZE) - x0;
+                const int tileH = std::min(height, y0 + TILE_SIZE) - y0;
+                const int regionW = tileW + 2 * pr;
+                const int regionH = tileH + 2 * pr;
+                const int stride = regionW + 1;
+
+                std::fill(acc.begin(), acc.end(), 0.0f);
+                std::fill(weightSum.begin(), weightSum.end(), 0.0f);
+                std::fill(integral.begin(), integral.begin() + stride, 0u);
+
+                for (int rx = 0; rx < regionW; ++rx) {
+                    colP[rx] = std::clamp(x0 - pr + rx, 0, width - 1) * channels;
+                }
+
+                for (int dy = -sr; dy <= sr; ++dy) {
+                    for (int dx = -sr; dx <= sr; ++dx) {
+                        for (int rx = 0; rx < regionW; ++rx) {
+                            colQ[rx] = std::clamp(x0 - pr + rx + dx, 0, width - 1) * channels;
+                        }
+                        for (int x = 0; x < tileW; ++x) {
+                            colCenter[x] = colQ[x + pr];
+                        }
+
+                        // 1. Integral image of squared differences
+                        for (int ry = 0; ry < regionH; ++ry) {
+                            const int py = std::clamp(y0 - pr + ry, 0, height - 1);
+                            const int qy = std::clamp(y0 - pr + ry + dy, 0, height - 1);
+                            const uint8_t* pRow = src + static_cast<size_t>(py) * width * channels;
+                            const uint8_t* qRow = src + static_cast<size_t>(qy) * width * channels;
+                            const uint32_t* prev = integral.data() + static_cast<size_t>(ry) * stride;
+                            uint32_t* cur = integral.data() + static_cast<size_t>(ry + 1) * stride;
+
+                            uint32_t rowSum = 0;
+                            cur[0] = 0;
+                            for (int rx = 0; rx < regionW; ++rx) {
+                                uint32_t d = 0;
+                                for (int c = 0; c < channels; ++c) {
+                                    int diff = pRow[colP[rx] + c] - qRow[colQ[rx] + c];
+                                    d += static_cast<uint32_t>(diff * diff);
+                                }
+                                rowSum += d;
+                                cur[rx + 1] = prev[rx + 1] + rowSum;
+                            }
+                        }
+
+                        // 2-4. Patch distances, weights and accumulation
+                        for (int y = 0; y < tileH; ++y) {
+                            const int qy = std::clamp(y0 + y + dy, 0, height - 1);
+                            const uint8_t* qRow = src + static_cast<size_t>(qy) * width * channels;
+                            const uint32_t* top = integral.data() + static_cast<size_t>(y) * stride;
+                            const uint32_t* bottom = integral.data() + static_cast<size_t>(y + patchSide) * stride;
+                            float* accRow = acc.data() + static_cast<size_t>(y) * TILE_SIZE * channels;
+                            float* weightRow = weightSum.data() + static_cast<size_t>(y) * TILE_SIZE;
+
+                            for (int x = 0; x < tileW; ++x) {
+                                const uint32_t distance = bottom[x + patchSide] - top[x + patchSide]
+                                                        - bottom[x] + top[x];
+                                const int index = static_cast<int>(static_cast<float>(distance) * norm);
+                                if (index > maxIndex) continue;
+
+                                const float w = weightLut[index];
+                                const uint8_t* q = qRow + colCenter[x];
+                                weightRow[x] += w;
+                                for (int c = 0; c < channels; ++c) {
+                                    accRow[x * channels + c] += w * q[c];
+                                }
+                            }
+                        }
+                    }
+                }
+
+                for (int y = 0; y < tileH; ++y) {
+                    uint8_t* outRow = dst + (static_cast<size_t>(y0 + y) * width + x0) * channels;
+                    const float* accRow = acc.data() + static_cast<size_t>(y) * TILE_SIZE * channels;
+                    const float* weightRow = weightSum.data() + static_cast<size_t>(y) * TILE_SIZE;
+                    for (int x = 0; x < tileW; ++x) {
+                        // The zero offset always contributes weight 1, so weightRow[x] >= 1
+                        const float inv = 1.0f / weightRow[x];
+                        for (int c = 0; c < channels; ++c) {
+                            float v = accRow[x * channels + c] * inv + 0.5f;
+                            outRow[x * channels + c] = static_cast<uint8_t>(std::min(v, 255.0f));
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    auto end = std::chrono::high_resolution_clock::now();
+    lastExecutionTime = std::chrono::duration<double, std::milli>(end - start).count();
+}
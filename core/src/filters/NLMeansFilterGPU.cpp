@@ -0,0 +1,151 @@
+/**
+ * @file NLMeansFilterGPU.cpp
+ * @brief GPU implementation of non-local means denoising using SYCL
+ *
+ * @details
+ * SYCL Implementation:
+ * - nd_range with 16x16 work-groups, global size rounded up to the block
+ * - Each work-group cooperatively loads a (16 + 2*(search + patch))² tile
+ *   (clamped at the image borders) into a local_accessor, then synchronizes
+ * - Each work-item loops over its search window, computes the patch
+ *   distance from local memory and accumulates exp(-d/h²) weighted pixels
+ * - Work-items outside the image take part in the load but write nothing
+ *
+ * Error Handling:
+ * - Catches sycl::exception and falls back to the CPU NLMeansFilter
+ *
+ * @see NLMeansFilter.cpp for the CPU version
+ * @author Rowan HOUPA
+ * @date January 2026
+ */
+
+#include "filters/NLMeansFilterGPU.hpp"
+#include <iostream>
+
+namespace {
+    constexpr int BLOCK_SIZE = 16;
+    constexpr float WEIGHT_CUTOFF = 6.9f; // Same cutoff as the CPU table
+}
+
+void NLMeansFilterGPU::apply(const Image& input, Image& output) {
+    auto start = std::chrono::high_resolution_clock::now();
+
+    try {
+        sycl::queue q(sycl::gpu_selector_v);
+        reportDevice(q.get_device().get_info<sycl::info::device::name>());
+
+        std::cout << "NL-Means GPU sur: "
+                  << q.get_device().get_info<sycl::info::device::name>()
+                  << std::endl;
+
+        const int width = input.getWidth();
+        const int height = input.getHeight();
+        const int channels = input.getChannels();
+        output = Image(width, height, channels);
+
+        const int pr = patchRadius;
+        const int sr = getEffectiveSearchRadius();
+        const int halo = sr + pr;
+        const int tileSide = BLOCK_SIZE + 2 * halo;
+        const int patchSide = 2 * pr + 1;
+        const float norm = 1.0f / static_cast<float>(patchSide * patchSide * channels);
+        const float invH2 = 1.0f / (strength * strength);
+
+        const size_t globalX = (static_cast<size_t>(width) + BLOCK_SIZE - 1) / BLOCK_SIZE * BLOCK_SIZE;
+        const size_t globalY = (static_cast<size_t>(height) + BLOCK_SIZE - 1) / BLOCK_SIZE * BLOCK_SIZE;
+
+        {
+            sycl::buffer<uint8_t, 1> bufIn(input.data(), sycl::range<1>(input.size()));
+            sycl::buffer<uint8_t, 1> bufOut(output.data(), sycl::range<1>(output.size()));
+
+            q.submit([&](sycl::handler& h) {
+                auto in = bufIn.get_access<sycl::access::mode::read>(h);
+                auto out = bufOut.get_access<sycl::access::mode::write>(h);
+                sycl::local_accessor<uint8_t, 1> tile(
+                    sycl::range<1>(static_cast<size_t>(tileSide) * tileSide * channels), h);
+
+                h.parallel_for(
+                    sycl::nd_range<2>(sycl::range<2>(globalY, globalX),
+                                      sycl::range<2>(BLOCK_SIZE, BLOCK_SIZE)),
+                    [=](sycl::nd_item<2> item) {
+                        const int ly = static_cast<int>(item.get_local_id(0));
+                        const int lx = static_cast<int>(item.get_local_id(1));
+                        const int originY = static_cast<int>(item.get_group(0)) * BLOCK_SIZE - halo;
+                        const int originX = static_cast<int>(item.get_group(1)) * BLOCK_SIZE - halo;
+
+                        // 1. Cooperative load of the block's neighbourhood
+                        for (int i = ly * BLOCK_SIZE + lx; i < tileSide * tileSide;
+                             i += BLOCK_SIZE * BLOCK_SIZE) {
+                            const int ty = i / tileSide;
+                            const int tx = i % tileSide;
+                            const int gy = sycl::clamp(originY + ty, 0, height - 1);
+                            const int gx = sycl::clamp(originX + tx, 0, width - 1);
+                            const size_t src = (static_cast<size_t>(gy) * width + gx) * channels;
+                            for (int c = 0; c < channels; ++c) {
+                                tile[static_cast<size_t>(i) * channels + c] = in[src + c];
+                            }
+                        }
+                        sycl::group_barrier(item.get_group());
+
+                        const int y = static_cast<int>(item.get_global_id(0));
+                        const int x = static_cast<int>(item.get_global_id(1));
+                        if (x >= width || y >= height) return;
+
+                        // 2. Weighted average over the search window
+                        const int cy = ly + halo;
+                        const int cx = lx + halo;
+                        float acc[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+                        float weightSum = 0.0f;
+
+                        for (int dy = -sr; dy <= sr; ++dy) {
+                            for (int dx = -sr; dx <= sr; ++dx) {
+                                int distance = 0;
+                                for (int py = -pr; py <= pr; ++py) {
+                                    const int rowP = (cy + py) * tileSide;
+                                    const int rowQ = (cy + dy + py) * tileSide;
+                                    for (int px = -pr; px <= pr; ++px) {
+                                        const size_t p = static_cast<size_t>(rowP + cx + px) * channels;
+                                        const size_t q = static_cast<size_t>(rowQ + cx + dx + px) * channels;
+                                        for (int c = 0; c < channels; ++c) {
+                                            const int diff = tile[p + c] - tile[q + c];
+                                            distance += diff * diff;
+                                        }
+                                    }
+                                }
+
+                                const float d = static_cast<float>(distance) * norm * invH2;
+                                if (d > WEIGHT_CUTOFF) continue;
+
+                                const float w = sycl::exp(-d);
+                                const size_t q = static_cast<size_t>((cy + dy) * tileSide + cx + dx) * channels;
+                                weightSum += w;
+                                for (int c = 0; c < channels; ++c) {
+                                    acc[c] += w * tile[q + c];
+                                }
+                            }
+                        }
+
+                        const size_t dst = (static_cast<size_t>(y) * width + x) * channels;
+                        for (int c = 0; c < channels; ++c) {
+                            const float v = acc[c] / weightSum + 0.5f;
+                            out[dst + c] = static_cast<uint8_t>(v > 255.0f ? 255.0f : v);
+                        }
+                    });
+            }).wait();
+        }
+
+        auto end = std::chrono::high_resolution_clock::now();
+        lastExecutionTime = std::chrono::duration<double, std::milli>(end - start).count();
+
+        std::cout << "GPU NL-Means terminé en " << lastExecutionTime << " ms" << std::endl;
+
+    } catch (sycl::exception const& e) {
+        std::cerr << "SYCL exception: " << e.what() << std::endl;
+        std::cerr << "↩Fallback sur CPU..." << std::endl;
+        reportDevice("CPU");
+
+        NLMeansFilter cpuFallback(strength, patchRadius, searchRadius, fastMode);
+        cpuFallback.apply(input, output);
+        lastExecutionTime = cpuFallback.getLastExecutionTime();
+    }
+}
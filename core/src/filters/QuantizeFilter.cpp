@@ -0,0 +1,350 @@
+/**
+ * @file QuantizeFilter.cpp
+ * @brief Median-cut / k-means palette quantization with a 32³ cube cache (OpenMP)
+ *
+ * @details
+ * Pipeline:
+ * 1. Exact shortcut: IndexedImage::fromImage() when the image has at most
+ *    N distinct colors
+ * 2. Histogram of a subsampled grid (step = ceil(sqrt(pixels / 2^20)) in
+ *    both directions): one 32³ histogram per thread, merged cell by cell
+ * 3. Median cut over the non-empty cells (each cell is a point at its mean
+ *    color, weighted by its count)
+ * 4. K-means (optional): Lloyd iterations seeded with the median-cut
+ *    palette; assignment runs in parallel and the per-cluster sums are an
+ *    OpenMP array reduction. Stops when no center moves by more than half
+ *    a level or after 10 iterations
+ * 5. Cube cache: nearest palette entry of every cell (its mean color when
+ *    sampled, its center otherwise), computed in parallel
+ * 6. Mapping: one cache lookup per pixel, OpenMP over rows
+ *
+ * @see QuantizeFilter.hpp for the method overview
+ * @author Rowan HOUPA
+ * @date January 2026
+ */
+
+#include "filters/QuantizeFilter.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace {
+
+constexpr int CELL_COUNT = 32 * 32 * 32;
+constexpr double MAX_SAMPLES = 1 << 20;
+constexpr int KMEANS_ITERATIONS = 10;
+constexpr float KMEANS_TOLERANCE = 0.25f; // Squared distance (half a level)
+
+struct Bin {
+    uint32_t count = 0;
+    uint32_t r = 0, g = 0, b = 0;
+};
+
+struct WeightedColor {
+    std::array<float, 3> color;
+    float weight;
+};
+
+using Center = std::array<float, 3>;
+
+inline int cellOf(int r, int g, int b) {
+    return ((r >> 3) << 10) | ((g >> 3) << 5) | (b >> 3);
+}
+
+inline void readColor(const uint8_t* p, int channels, int& r, int& g, int& b) {
+    if (channels < 3) {
+        r = g = b = p[0];
+    } else {
+        r = p[0]; g = p[1]; b = p[2];
+    }
+}
+
+inline float distance2(const std::array<float, 3>& a, const std::array<float, 3>& b) {
+    const float dr = a[0] - b[0];
+    const float dg = a[1] - b[1];
+    const float db = a[2] - b[2];
+    return dr * dr + dg * dg + db * db;
+}
+
+inline int nearest(const std::vector<Center>& centers, const std::array<float, 3>& color) {
+    int best = 0;
+    float bestDistance = std::numeric_limits<float>::max();
+    for (size_t j = 0; j < centers.size(); ++j) {
+        const float d = distance2(centers[j], color);
+        if (d < bestDistance) {
+            bestDistance = d;
+            best = static_cast<int>(j);
+        }
+    }
+    return best;
+}
+
+std::vector<Center> medianCut(std::vector<WeightedColor>& points, int k) {
+    struct Box {
+        size_t begin, end;
+        double weight;
+        std::array<float, 3> lo, hi;
+    };
+
+    auto makeBox = [&](size_t begin, size_t end) {
+        Box box{begin, end, 0.0, {255.0f, 255.0f, 255.0f}, {0.0f, 0.0f, 0.0f}};
+        for (size_t i = begin; i < end; ++i) {
+            box.weight += points[i].weight;
+            for (int a = 0; a < 3; ++a) {
+                box.lo[a] = std::min(box.lo[a], points[i].color[a]);
+                box.hi[a] = std::max(box.hi[a], points[i].color[a]);
+            }
+        }
+        return box;
+    };
+
+    std::vector<Box> boxes{makeBox(0, points.size())};
+
+    while (static_cast<int>(boxes.size()) < k) {
+        // Box with the largest weight × extent along its longest axis
+        int best = -1;
+        double bestScore = 0.0;
+        for (size_t i = 0; i < boxes.size(); ++i) {
+            const Box& box = boxes[i];
+            if (box.end - box.begin < 2) continue;
+            float extent = 0.0f;
+            for (int a = 0; a < 3; ++a) extent = std::max(extent, box.hi[a] - box.lo[a]);
+            const double score = box.weight * extent;
+            if (score > bestScore) {
+                bestScore = score;
+                best = static_cast<int>(i);
+            }
+        }
+        if (best < 0) break;
+
+        const Box box = boxes[best];
+        int axis = 0;
+        for (int a = 1; a < 3; ++a) {
+            if (box.hi[a] - box.lo[a] > box.hi[axis] - box.lo[axis]) axis = a;
+        }
+        std::sort(points.begin() + box.begin, points.begin() + box.end,
+                  [axis](const WeightedColor& a, const WeightedColor& b) {
+                      return a.color[axis] < b.color[axis];
+                  });
+
+        // Weighted median, keeping at least one point on each side
+        const double half = box.weight / 2.0;
+        double accumulated = 0.0;
+        size_t split = box.begin + 1;
+        for (size_t i = box.begin; i + 1 < box.end; ++i) {
+            accumulated += points[i].weight;
+            split = i + 1;
+            if (accumulated >= half) break;
+        }
+
+        boxes[best] = makeBox(box.begin, split);
+        boxes.push_back(makeBox(split, box.end));
+    }
+
+    std::vector<Center> centers;
+    centers.reserve(boxes.size());
+    for (const Box& box : boxes) {
+        Center sum = {0.0f, 0.0f, 0.0f};
+        for (size_t i = box.begin; i < box.end; ++i) {
+            for (int a = 0; a < 3; ++a) sum[a] += points[i].color[a] * points[i].weight;
+        }
+        for (int a = 0; a < 3; ++a) sum[a] /= static_cast<float>(box.weight);
+        centers.push_back(sum);
+    }
+    return centers;
+}
+
+void kMeans(const std::vector<WeightedColor>& points, std::vector<Center>& centers) {
+    const int k = static_cast<int>(centers.size());
+    const int n = static_cast<int>(points.size());
+    std::vector<double> sums(static_cast<size_t>(k) * 4);
+
+    for (int iteration = 0; iteration < KMEANS_ITERATIONS; ++iteration) {
+        std::fill(sums.begin(), sums.end(), 0.0);
+        double* s = sums.data();
+
+        #pragma omp parallel for reduction(+:s[:k * 4]) schedule(static)
+        for (int i = 0; i < n; ++i) {
+            const WeightedColor& p = points[i];
+            const int j = nearest(centers, p.color);
+            s[j * 4 + 0] += p.color[0] * p.weight;
+            s[j * 4 + 1] += p.color[1] * p.weight;
+            s[j * 4 + 2] += p.color[2] * p.weight;
+            s[j * 4 + 3] += p.weight;
+        }
+
+        float moved = 0.0f;
+        for (int j = 0; j < k; ++j) {
+            const double weight = sums[j * 4 + 3];
+            if (weight <= 0.0) continue; // Empty cluster keeps its center
+            const Center updated = {static_cast<float>(sums[j * 4 + 0] / weight),
+                                    static_cast<float>(sums[j * 4 + 1] / weight),
+                                    static_cast<float>(sums[j * 4 + 2] / weight)};
+            moved = std::max(moved, distance2(updated, centers[j]));
+            centers[j] = updated;
+        }
+        if (moved < KMEANS_TOLERANCE) break;
+    }
+}
+
+} // namespace
+
+void QuantizeFilter::apply(const Image& input, Image& output) {
+    auto start = std::chrono::high_resolution_clock::now();
+
+    IndexedImage indexed = quantize(input);
+    output = indexed.toImage(input.getChannels());
+
+    auto end = std::chrono::high_resolution_clock::now();
+    lastExecutionTime = std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+IndexedImage QuantizeFilter::quantize(const Image& input) {
+    auto start = std::chrono::high_resolution_clock::now();
+    auto finish = [&](IndexedImage result) {
+        auto end = std::chrono::high_resolution_clock::now();
+        lastExecutionTime = std::chrono::duration<double, std::milli>(end - start).count();
+        return result;
+    };
+
+    // 1. Few colors already: exact palette
+    IndexedImage exact = IndexedImage::fromImage(input, colors);
+    if (!exact.empty()) return finish(std::move(exact));
+
+    const int width = input.getWidth();
+    const int height = input.getHeight();
+    const int channels = input.getChannels();
+    const bool hasAlpha = (channels == 2 || channels == 4);
+    const uint8_t* src = input.data();
+    const size_t rowValues = static_cast<size_t>(width) * channels;
+
+    bool transparent = false;
+    if (hasAlpha) {
+        #pragma omp parallel for reduction(||:transparent) schedule(static)
+        for (int y = 0; y < height; ++y) {
+            const uint8_t* in = src + y * rowValues;
+            for (int x = 0; x < width; ++x) {
+                transparent = transparent || in[x * channels + channels - 1] < 128;
+            }
+        }
+    }
+    const int opaqueColors = transparent ? colors - 1 : colors;
+
+    // 2. Subsampled histogram, one per thread
+    const double pixelCount = static_cast<double>(width) * height;
+    const int step = std::max(1, static_cast<int>(std::ceil(std::sqrt(pixelCount / MAX_SAMPLES))));
+    const int sampledRows = (height + step - 1) / step;
+
+    int threads = 1;
+#ifdef _OPENMP
+    threads = omp_get_max_threads();
+#endif
+    std::vector<Bin> partial(static_cast<size_t>(threads) * CELL_COUNT);
+
+    #pragma omp parallel
+    {
+        int tid = 0;
+#ifdef _OPENMP
+        tid = omp_get_thread_num();
+#endif
+        Bin* local = partial.data() + static_cast<size_t>(tid) * CELL_COUNT;
+
+        #pragma omp for schedule(static)
+        for (int sy = 0; sy < sampledRows; ++sy) {
+            const uint8_t* in = src + static_cast<size_t>(sy) * step * rowValues;
+            for (int x = 0; x < width; x += step) {
+                const uint8_t* p = in + x * channels;
+                if (hasAlpha && p[channels - 1] < 128) continue;
+                int r, g, b;
+                readColor(p, channels, r, g, b);
+                Bin& bin = local[cellOf(r, g, b)];
+                ++bin.count;
+                bin.r += r; bin.g += g; bin.b += b;
+            }
+        }
+    }
+
+    std::vector<Bin> histogram(CELL_COUNT);
+    #pragma omp parallel for schedule(static)
+    for (int cell = 0; cell < CELL_COUNT; ++cell) {
+        Bin total;
+        for (int t = 0; t < threads; ++t) {
+            const Bin& bin = partial[static_cast<size_t>(t) * CELL_COUNT + cell];
+            total.count += bin.count;
+            total.r += bin.r; total.g += bin.g; total.b += bin.b;
+        }
+        histogram[cell] = total;
+    }
+
+    // 3-4. Palette from the non-empty cells
+    std::vector<WeightedColor> points;
+    for (const Bin& bin : histogram) {
+        if (!bin.count) continue;
+        const float inv = 1.0f / bin.count;
+        points.push_back({{bin.r * inv, bin.g * inv, bin.b * inv}, static_cast<float>(bin.count)});
+    }
+
+    std::vector<Center> centers;
+    if (points.empty()) {
+        centers.push_back({0.0f, 0.0f, 0.0f});
+    } else {
+        centers = medianCut(points, opaqueColors);
+        if (method == QuantizeMethod::KMeans) {
+            kMeans(points, centers);
+        }
+    }
+
+    IndexedImage result(width, height);
+    std::vector<PaletteColor>& palette = result.palette();
+    if (transparent) {
+        palette.push_back({0, 0, 0, 0});
+    }
+    const int firstOpaque = static_cast<int>(palette.size());
+    for (const Center& c : centers) {
+        palette.push_back({static_cast<uint8_t>(std::lround(std::clamp(c[0], 0.0f, 255.0f))),
+                           static_cast<uint8_t>(std::lround(std::clamp(c[1], 0.0f, 255.0f))),
+                           static_cast<uint8_t>(std::lround(std::clamp(c[2], 0.0f, 255.0f))), 255});
+    }
+
+    // 5. Cube cache: nearest palette entry of every cell
+    std::vector<uint8_t> cache(CELL_COUNT);
+    #pragma omp parallel for schedule(static)
+    for (int cell = 0; cell < CELL_COUNT; ++cell) {
+        const Bin& bin = histogram[cell];
+        std::array<float, 3> reference;
+        if (bin.count) {
+            const float inv = 1.0f / bin.count;
+            reference = {bin.r * inv, bin.g * inv, bin.b * inv};
+        } else {
+            reference = {static_cast<float>(((cell >> 10) << 3) + 4),
+                         static_cast<float>((((cell >> 5) & 31) << 3) + 4),
+                         static_cast<float>(((cell & 31) << 3) + 4)};
+        }
+        cache[cell] = static_cast<uint8_t>(firstOpaque + nearest(centers, reference));
+    }
+
+    // 6. Pixel mapping
+    #pragma omp parallel for schedule(static)
+    for (int y = 0; y < height; ++y) {
+        const uint8_t* in = src + y * rowValues;
+        uint8_t* out = result.row(y);
+        for (int x = 0; x < width; ++x) {
+            const uint8_t* p = in + x * channels;
+            if (hasAlpha && p[channels - 1] < 128) {
+                out[x] = 0;
+                continue;
+            }
+            int r, g, b;
+            readColor(p, channels, r, g, b);
+            out[x] = cache[cellOf(r, g, b)];
+        }
+    }
+
+    return finish(std::move(result));
+}
@@ -0,0 +1,221 @@
+/**
+ * @file ThresholdFilter.cpp
+ * @brief CPU implementation of fixed, Otsu and adaptive thresholding
+ *
+ * @details
+ * Shared driver (ThresholdFilter::binarize):
+ * 1. Luma plane (skipped for 1-channel input)
+ * 2. prepare(): Otsu histogram / adaptive summed-area tables
+ * 3. Per row (OpenMP): rowThresholds() fills an int16 threshold row, then
+ *    an `omp simd` loop compares luma against it and writes 0/255 bytes
+ *    and/or 8 decisions per packed byte
+ *
+ * Otsu:
+ * - Histogram with an OpenMP array reduction (one private copy per thread)
+ * - Exhaustive search of the 256 candidates with running class sums
+ *
+ * Adaptive:
+ * - Window sums of luma and luma² from two uint32 SummedAreaTables, so
+ *   every pixel costs O(1) regardless of the window size
+ * - Windows are clipped at the borders (mean over the pixels inside)
+ *
+ * @see ThresholdFilterGPU.cpp for the SYCL versions
+ * @author Rowan HOUPA
+ * @date January 2026
+ */
+
+#include "filters/ThresholdFilter.hpp"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+void ThresholdFilter::computeLuma(const Image& input, Image& luma) {
+    const int width = input.getWidth();
+    const int height = input.getHeight();
+    const int channels = input.getChannels();
+    luma = Image(width, height, 1);
+
+    const uint8_t* src = input.data();
+    uint8_t* dst = luma.data();
+
+    #pragma omp parallel for schedule(static)
+    for (int y = 0; y < height; ++y) {
+        const uint8_t* in = src + static_cast<size_t>(y) * width * channels;
+        uint8_t* out = dst + static_cast<size_t>(y) * width;
+        if (channels >= 3) {
+            #pragma omp simd
+            for (int x = 0; x < width; ++x) {
+                const uint8_t* p = in + x * channels;
+                out[x] = static_cast<uint8_t>((77 * p[0] + 150 * p[1] + 29 * p[2] + 128) >> 8);
+            }
+        } else {
+            for (int x = 0; x < width; ++x) {
+                out[x] = in[x * channels];
+            }
+        }
+    }
+}
+
+void ThresholdFilter::apply(const Image& input, Image& output) {
+    binarize(input, &output, nullptr);
+}
+
+void ThresholdFilter::applyPacked(const Image& input, BinaryImage& output) {
+    binarize(input, nullptr, &output);
+}
+
+void ThresholdFilter::rowThresholds(int y, int width, int16_t* thresholds) const {
+    (void)y;
+    std::fill(thresholds, thresholds + width, static_cast<int16_t>(threshold));
+}
+
+void ThresholdFilter::binarize(const Image& input, Image* unpacked, BinaryImage* packed) {
+    auto start = std::chrono::high_resolution_clock::now();
+
+    Image lumaStorage;
+    const Image* luma = &input;
+    if (input.getChannels() != 1) {
+        computeLuma(input, lumaStorage);
+        luma = &lumaStorage;
+    }
+
+    prepare(*luma);
+
+    const int width = luma->getWidth();
+    const int height = luma->getHeight();
+    if (unpacked) *unpacked = Image(width, height, 1);
+    if (packed) *packed = BinaryImage(width, height);
+
+    const uint8_t* src = luma->data();
+    const uint8_t flip = inverted ? 1 : 0;
+
+    #pragma omp parallel
+    {
+        std::vector<int16_t> thresholds(width);
+        std::vector<uint8_t> decisions(width);
+
+        #pragma omp for schedule(static)
+        for (int y = 0; y < height; ++y) {
+            rowThresholds(y, width, thresholds.data());
+            const uint8_t* row = src + static_cast<size_t>(y) * width;
+            const int16_t* t = thresholds.data();
+            uint8_t* d = decisions.data();
+
+            #pragma omp simd
+            for (int x = 0; x < width; ++x) {
+                d[x] = static_cast<uint8_t>((row[x] > t[x]) ^ flip);
+            }
+
+            if (unpacked) {
+                uint8_t* out = unpacked->data() + static_cast<size_t>(y) * width;
+                #pragma omp simd
+                for (int x = 0; x < width; ++x) {
+                    out[x] = static_cast<uint8_t>(0 - d[x]);
+                }
+            }
+
+            if (packed) {
+                uint8_t* bits = packed->row(y);
+                const int fullBytes = width / 8;
+                for (int bx = 0; bx < fullBytes; ++bx) {
+                    const uint8_t* b = d + bx * 8;
+                    bits[bx] = static_cast<uint8_t>((b[0] << 7) | (b[1] << 6) | (b[2] << 5) | (b[3] << 4) |
+                                                    (b[4] << 3) | (b[5] << 2) | (b[6] << 1) | b[7]);
+                }
+                if (width % 8) {
+                    uint8_t last = 0;
+                    for (int x = fullBytes * 8; x < width; ++x) {
+                        last |= static_cast<uint8_t>(d[x] << (7 - (x & 7)));
+                    }
+                    bits[fullBytes] = last;
+                }
+            }
+        }
+    }
+
+    release();
+
+    auto end = std::chrono::high_resolution_clock::now();
+    lastExecutionTime = std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+int OtsuThresholdFilter::otsuThreshold(const std::array<uint64_t, 256>& histogram) {
+    double total = 0.0;
+    double weightedTotal = 0.0;
+    for (int i = 0; i < 256; ++i) {
+        total += static_cast<double>(histogram[i]);
+        weightedTotal += static_cast<double>(i) * histogram[i];
+    }
+    if (total == 0.0) return 128;
+
+    double weightBelow = 0.0;
+    double sumBelow = 0.0;
+    double bestVariance = -1.0;
+    int best = 0;
+
+    for (int t = 0; t < 256; ++t) {
+        weightBelow += static_cast<double>(histogram[t]);
+        sumBelow += static_cast<double>(t) * histogram[t];
+        const double weightAbove = total - weightBelow;
+        if (weightBelow == 0.0) continue;
+        if (weightAbove == 0.0) break;
+
+        const double meanBelow = sumBelow / weightBelow;
+        const double meanAbove = (weightedTotal - sumBelow) / weightAbove;
+        const double variance = weightBelow * weightAbove * (meanBelow - meanAbove) * (meanBelow - meanAbove);
+        if (variance > bestVariance) {
+            bestVariance = variance;
+            best = t;
+        }
+    }
+    return best;
+}
+
+void OtsuThresholdFilter::prepare(const Image& luma) {
+    uint64_t counts[256] = {};
+    const uint8_t* src = luma.data();
+    const size_t size = luma.size();
+
+    #pragma omp parallel for reduction(+:counts[:256]) schedule(static)
+    for (size_t i = 0; i < size; ++i) {
+        counts[src[i]]++;
+    }
+
+    std::array<uint64_t, 256> histogram;
+    std::copy(counts, counts + 256, histogram.begin());
+    threshold = otsuThreshold(histogram);
+}
+
+void AdaptiveThresholdFilter::prepare(const Image& luma) {
+    sumTable.build(luma);
+    if (method == AdaptiveMethod::Sauvola) {
+        squareTable.build(luma, SatValue::Squared);
+    }
+}
+
+void AdaptiveThresholdFilter::rowThresholds(int y, int width, int16_t* thresholds) const {
+    const int height = sumTable.getHeight();
+    const int y0 = std::max(0, y - windowRadius);
+    const int y1 = std::min(height, y + windowRadius + 1);
+    const bool sauvola = (method == AdaptiveMethod::Sauvola);
+
+    for (int x = 0; x < width; ++x) {
+        const int x0 = std::max(0, x - windowRadius);
+        const int x1 = std::min(width, x + windowRadius + 1);
+        const float count = static_cast<float>((x1 - x0) * (y1 - y0));
+        const float mean = sumTable.rectSum(x0, y0, x1, y1) / count;
+
+        if (sauvola) {
+            const float meanSquare = squareTable.rectSum(x0, y0, x1, y1) / count;
+            const float stddev = std::sqrt(std::max(0.0f, meanSquare - mean * mean));
+            thresholds[x] = thresholdmath::sauvola(mean, stddev, k);
+        } else {
+            thresholds[x] = thresholdmath::bradley(mean, k);
+        }
+    }
+}
+
+void AdaptiveThresholdFilter::release() {
+    sumTable = SummedAreaTable<uint32_t>();
+    squareTable = SummedAreaTable<uint32_t>();
+}
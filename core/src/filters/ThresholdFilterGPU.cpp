@@ -0,0 +1,290 @@
+/**
+ * @file ThresholdFilterGPU.cpp
+ * @brief GPU implementation of fixed, Otsu and adaptive thresholding using SYCL
+ *
+ * @details
+ * SYCL Implementation:
+ * - Luma: one work-item per pixel (skipped for 1-channel input)
+ * - Binarization: one work-item per pixel (0/255 output) or per packed
+ *   byte (8 pixels, BinaryImage output); the threshold of each pixel comes
+ *   from a device functor built per filter inside the command group
+ * - Otsu histogram: grid-stride nd_range; each work-group accumulates a
+ *   256-bin histogram in local memory with work-group atomics, then adds it
+ *   to the global histogram with device atomics. The 256-candidate search
+ *   runs on the host (OtsuThresholdFilter::otsuThreshold)
+ * - Adaptive: sum and square tables from SummedAreaTable::buildGPU(), then
+ *   4 lookups per table per pixel in the binarization kernel
+ *
+ * Error Handling:
+ * - Catches sycl::exception and falls back to the CPU filter
+ *
+ * @see ThresholdFilter.cpp for the CPU versions
+ * @author Rowan HOUPA
+ * @date January 2026
+ */
+
+#include "filters/ThresholdFilterGPU.hpp"
+#include <array>
+#include <iostream>
+
+namespace {
+
+constexpr int HISTOGRAM_GROUP_SIZE = 256;
+constexpr size_t MAX_HISTOGRAM_GROUPS = 1024;
+
+// Luma plane computed on the device; 1-channel input is returned as is
+const Image& lumaOnDevice(sycl::queue& q, const Image& input, Image& storage) {
+    if (input.getChannels() == 1) return input;
+
+    const int width = input.getWidth();
+    const int height = input.getHeight();
+    const int channels = input.getChannels();
+    storage = Image(width, height, 1);
+
+    {
+        sycl::buffer<uint8_t, 1> bufIn(input.data(), sycl::range<1>(input.size()));
+        sycl::buffer<uint8_t, 1> bufLuma(storage.data(), sycl::range<1>(storage.size()));
+
+        q.submit([&](sycl::handler& h) {
+            auto in = bufIn.get_access<sycl::access::mode::read>(h);
+            auto out = bufLuma.get_access<sycl::access::mode::write>(h);
+
+            h.parallel_for(sycl::range<1>(storage.size()), [=](sycl::id<1> idx) {
+                const size_t i = idx[0];
+                const size_t p = i * channels;
+                out[i] = channels >= 3
+                    ? static_cast<uint8_t>((77 * in[p] + 150 * in[p + 1] + 29 * in[p + 2] + 128) >> 8)
+                    : in[p];
+            });
+        }).wait();
+    }
+    return storage;
+}
+
+/**
+ * Compares luma against per-pixel thresholds on the device.
+ * makeThreshold(handler) is called inside the command group and returns a
+ * device callable threshold(x, y) -> int (foreground when luma > threshold).
+ */
+template<typename MakeThreshold>
+void binarizeOnDevice(sycl::queue& q, const Image& luma, bool inverted,
+                      Image* unpacked, BinaryImage* packed, MakeThreshold makeThreshold) {
+    const int width = luma.getWidth();
+    const int height = luma.getHeight();
+    const int flip = inverted ? 1 : 0;
+
+    if (unpacked) *unpacked = Image(width, height, 1);
+    if (packed) *packed = BinaryImage(width, height);
+
+    sycl::buffer<uint8_t, 1> bufLuma(luma.data(), sycl::range<1>(luma.size()));
+
+    if (unpacked) {
+        sycl::buffer<uint8_t, 1> bufOut(unpacked->data(), sycl::range<1>(unpacked->size()));
+        q.submit([&](sycl::handler& h) {
+            auto in = bufLuma.get_access<sycl::access::mode::read>(h);
+            auto out = bufOut.get_access<sycl::access::mode::write>(h);
+            auto threshold = makeThreshold(h);
+
+            h.parallel_for(sycl::range<2>(height, width), [=](sycl::id<2> idx) {
+                const int y = static_cast<int>(idx[0]);
+                const int x = static_cast<int>(idx[1]);
+                const size_t i = static_cast<size_t>(y) * width + x;
+                const int on = (in[i] > threshold(x, y)) ^ flip;
+                out[i] = static_cast<uint8_t>(on ? 255 : 0);
+            });
+        }).wait();
+    }
+
+    if (packed) {
+        const int rowBytes = packed->getRowBytes();
+        sycl::buffer<uint8_t, 1> bufBits(packed->data(), sycl::range<1>(packed->size()));
+        q.submit([&](sycl::handler& h) {
+            auto in = bufLuma.get_access<sycl::access::mode::read>(h);
+            auto bits = bufBits.get_access<sycl::access::mode::write>(h);
+            auto threshold = makeThreshold(h);
+
+            h.parallel_for(sycl::range<2>(height, rowBytes), [=](sycl::id<2> idx) {
+                const int y = static_cast<int>(idx[0]);
+                const int bx = static_cast<int>(idx[1]);
+                const size_t rowStart = static_cast<size_t>(y) * width;
+                int byte = 0;
+                for (int i = 0; i < 8; ++i) {
+                    const int x = bx * 8 + i;
+                    if (x >= width) break;
+                    const int on = (in[rowStart + x] > threshold(x, y)) ^ flip;
+                    byte |= on << (7 - i);
+                }
+                bits[static_cast<size_t>(y) * rowBytes + bx] = static_cast<uint8_t>(byte);
+            });
+        }).wait();
+    }
+}
+
+void printDevice(sycl::queue& q, const char* label) {
+    std::cout << label << " GPU sur: "
+              << q.get_device().get_info<sycl::info::device::name>()
+              << std::endl;
+}
+
+} // namespace
+
+void ThresholdFilterGPU::binarize(const Image& input, Image* unpacked, BinaryImage* packed) {
+    auto start = std::chrono::high_resolution_clock::now();
+
+    try {
+        sycl::queue q(sycl::gpu_selector_v);
+        reportDevice(q.get_device().get_info<sycl::info::device::name>());
+        printDevice(q, "Seuil");
+
+        Image lumaStorage;
+        const Image& luma = lumaOnDevice(q, input, lumaStorage);
+        const int t = threshold;
+
+        binarizeOnDevice(q, luma, inverted, unpacked, packed, [t](sycl::handler&) {
+            return [t](int, int) { return t; };
+        });
+
+        auto end = std::chrono::high_resolution_clock::now();
+        lastExecutionTime = std::chrono::duration<double, std::milli>(end - start).count();
+
+    } catch (sycl::exception const& e) {
+        std::cerr << "SYCL exception: " << e.what() << std::endl;
+        std::cerr << "↩Fallback sur CPU..." << std::endl;
+        reportDevice("CPU");
+        ThresholdFilter::binarize(input, unpacked, packed);
+    }
+}
+
+void OtsuThresholdFilterGPU::binarize(const Image& input, Image* unpacked, BinaryImage* packed) {
+    auto start = std::chrono::high_resolution_clock::now();
+
+    try {
+        sycl::queue q(sycl::gpu_selector_v);
+        reportDevice(q.get_device().get_info<sycl::info::device::name>());
+        printDevice(q, "Seuil Otsu");
+
+        Image lumaStorage;
+        const Image& luma = lumaOnDevice(q, input, lumaStorage);
+        const size_t size = luma.size();
+
+        std::array<uint32_t, 256> counts{};
+        {
+            sycl::buffer<uint8_t, 1> bufLuma(luma.data(), sycl::range<1>(size));
+            sycl::buffer<uint32_t, 1> bufHist(counts.data(), sycl::range<1>(256));
+
+            const size_t groups = std::min(MAX_HISTOGRAM_GROUPS,
+                                           (size + HISTOGRAM_GROUP_SIZE - 1) / HISTOGRAM_GROUP_SIZE);
+            const size_t globalSize = groups * HISTOGRAM_GROUP_SIZE;
+
+            q.submit([&](sycl::handler& h) {
+                auto in = bufLuma.get_access<sycl::access::mode::read>(h);
+                auto hist = bufHist.get_access<sycl::access::mode::read_write>(h);
+                sycl::local_accessor<uint32_t, 1> localHist(sycl::range<1>(256), h);
+
+                h.parallel_for(
+                    sycl::nd_range<1>(sycl::range<1>(globalSize), sycl::range<1>(HISTOGRAM_GROUP_SIZE)),
+                    [=](sycl::nd_item<1> item) {
+                        const size_t lid = item.get_local_id(0);
+                        localHist[lid] = 0;
+                        sycl::group_barrier(item.get_group());
+
+                        for (size_t i = item.get_global_id(0); i < size; i += globalSize) {
+                            sycl::atomic_ref<uint32_t, sycl::memory_order::relaxed,
+                                             sycl::memory_scope::work_group,
+                                             sycl::access::address_space::local_space> bin(localHist[in[i]]);
+                            bin.fetch_add(1u);
+                        }
+                        sycl::group_barrier(item.get_group());
+
+                        sycl::atomic_ref<uint32_t, sycl::memory_order::relaxed,
+                                         sycl::memory_scope::device,
+                                         sycl::access::address_space::global_space> total(hist[lid]);
+                        total.fetch_add(localHist[lid]);
+                    });
+            }).wait();
+        }
+
+        std::array<uint64_t, 256> histogram;
+        std::copy(counts.begin(), counts.end(), histogram.begin());
+        threshold = otsuThreshold(histogram);
+        const int t = threshold;
+
+        binarizeOnDevice(q, luma, inverted, unpacked, packed, [t](sycl::handler&) {
+            return [t](int, int) { return t; };
+        });
+
+        auto end = std::chrono::high_resolution_clock::now();
+        lastExecutionTime = std::chrono::duration<double, std::milli>(end - start).count();
+
+    } catch (sycl::exception const& e) {
+        std::cerr << "SYCL exception: " << e.what() << std::endl;
+        std::cerr << "↩Fallback sur CPU..." << std::endl;
+        reportDevice("CPU");
+        OtsuThresholdFilter::binarize(input, unpacked, packed);
+    }
+}
+
+void AdaptiveThresholdFilterGPU::binarize(const Image& input, Image* unpacked, BinaryImage* packed) {
+    auto start = std::chrono::high_resolution_clock::now();
+
+    try {
+        sycl::queue q(sycl::gpu_selector_v);
+        reportDevice(q.get_device().get_info<sycl::info::device::name>());
+        printDevice(q, "Seuil adaptatif");
+
+        Image lumaStorage;
+        const Image& luma = lumaOnDevice(q, input, lumaStorage);
+        const bool sauvola = (method == AdaptiveMethod::Sauvola);
+
+        SummedAreaTable<uint32_t> sums;
+        SummedAreaTable<uint32_t> squares;
+        sums.buildGPU(luma);
+        if (sauvola) {
+            squares.buildGPU(luma, SatValue::Squared);
+        }
+        // Bradley never reads the square table; bind the sum table instead
+        const SummedAreaTable<uint32_t>& squareSource = sauvola ? squares : sums;
+
+        const int width = luma.getWidth();
+        const int height = luma.getHeight();
+        const int radius = windowRadius;
+        const float kValue = k;
+        const size_t stride = static_cast<size_t>(width) + 1;
+
+        sycl::buffer<uint32_t, 1> bufSums(sums.data(), sycl::range<1>(sums.size()));
+        sycl::buffer<uint32_t, 1> bufSquares(squareSource.data(), sycl::range<1>(squareSource.size()));
+
+        binarizeOnDevice(q, luma, inverted, unpacked, packed, [&](sycl::handler& h) {
+            auto s = bufSums.get_access<sycl::access::mode::read>(h);
+            auto sq = bufSquares.get_access<sycl::access::mode::read>(h);
+
+            return [=](int x, int y) {
+                const int x0 = x - radius < 0 ? 0 : x - radius;
+                const int y0 = y - radius < 0 ? 0 : y - radius;
+                const int x1 = x + radius + 1 > width ? width : x + radius + 1;
+                const int y1 = y + radius + 1 > height ? height : y + radius + 1;
+                const size_t a = y0 * stride + x0, b = y0 * stride + x1;
+                const size_t c = y1 * stride + x0, d = y1 * stride + x1;
+
+                const float count = static_cast<float>((x1 - x0) * (y1 - y0));
+                const float mean = static_cast<uint32_t>(s[d] - s[b] - s[c] + s[a]) / count;
+                if (!sauvola) {
+                    return static_cast<int>(thresholdmath::bradley(mean, kValue));
+                }
+                const float meanSquare = static_cast<uint32_t>(sq[d] - sq[b] - sq[c] + sq[a]) / count;
+                const float variance = meanSquare - mean * mean;
+                const float stddev = sycl::sqrt(variance > 0.0f ? variance : 0.0f);
+                return static_cast<int>(thresholdmath::sauvola(mean, stddev, kValue));
+            };
+        });
+
+        auto end = std::chrono::high_resolution_clock::now();
+        lastExecutionTime = std::chrono::duration<double, std::milli>(end - start).count();
+
+    } catch (sycl::exception const& e) {
+        std::cerr << "SYCL exception: " << e.what() << std::endl;
+        std::cerr << "↩Fallback sur CPU..." << std::endl;
+        reportDevice("CPU");
+        AdaptiveThresholdFilter::binarize(input, unpacked, packed);
+    }
+}
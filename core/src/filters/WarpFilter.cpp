@@ -0,0 +1,377 @@
+/**
+ * @file WarpFilter.cpp
+ * @brief CPU implementation of geometric warps using OpenMP
+ *
+ * @details
+ * Processing per output tile (64 rows x 256 columns):
+ * 1. Generate the 16.16 fixed-point source position of every pixel of a
+ *    tile row into a small per-thread buffer:
+ *    - affine: one matrix product per row, then integer increments
+ *    - projective: X/Y/W incremented per pixel, one division per pixel
+ *    - remap/lens: read from the RemapTable
+ * 2. Sample the row (warpmath::sampleBilinear / sampleBicubic)
+ *
+ * Tiles are distributed with collapse(2) + dynamic scheduling, which keeps
+ * the source reads of a thread spatially close (rotations and perspective
+ * warps read diagonally through the source image).
+ *
+ * Remap Cache:
+ * - Lens undistortion tables are keyed by every LensModel parameter and the
+ *   image size; the last MAX_CACHED_TABLES tables are kept (LRU), so batch
+ *   runs from one camera build the table once
+ *
+ * @see WarpFilterGPU.cpp for the SYCL version
+ * @author Rowan HOUPA
+ * @date January 2026
+ */
+
+#include "filters/WarpFilter.hpp"
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <iomanip>
+#include <stdexcept>
+#include <tuple>
+
+namespace {
+    constexpr int TILE_HEIGHT = 64;
+    constexpr int TILE_WIDTH = 256;
+    constexpr size_t MAX_CACHED_TABLES = 4;
+
+    using LensKey = std::tuple<double, double, double, double, double,
+                               double, double, double, double, int, int>;
+
+    struct CachedTable {
+        uint64_t lastUse = 0;
+        std::shared_ptr<const RemapTable> table;
+    };
+
+    std::mutex remapCacheMutex;
+    std::map<LensKey, CachedTable> remapCache;
+    uint64_t remapCacheClock = 0;
+
+    bool isAffine(const std::array<double, 9>& m) {
+        return m[6] == 0.0 && m[7] == 0.0 && m[8] == 1.0;
+    }
+}
+
+WarpFilter WarpFilter::affine(const std::array<double, 6>& forward, WarpInterpolation interpolation) {
+    WarpFilter filter;
+    filter.kind = Kind::Projective;
+    filter.forwardMatrix = {forward[0], forward[1], forward[2],
+                            forward[3], forward[4], forward[5],
+                            0.0, 0.0, 1.0};
+    filter.interpolation = interpolation;
+    return filter;
+}
+
+WarpFilter WarpFilter::homography(const std::array<double, 9>& forward, WarpInterpolation interpolation) {
+    WarpFilter filter;
+    filter.kind = Kind::Projective;
+    filter.forwardMatrix = forward;
+    filter.interpolation = interpolation;
+    return filter;
+}
+
+WarpFilter WarpFilter::rotation(double degrees, WarpInterpolation interpolation) {
+    WarpFilter filter;
+    filter.kind = Kind::Rotation;
+    filter.angleDegrees = degrees;
+    filter.interpolation = interpolation;
+    return filter;
+}
+
+WarpFilter WarpFilter::remap(std::shared_ptr<const RemapTable> table, WarpInterpolation interpolation) {
+    if (!table || table->width <= 0 || table->height <= 0 ||
+        table->mapX.size() != static_cast<size_t>(table->width) * table->height ||
+        table->mapY.size() != table->mapX.size()) {
+        throw std::invalid_argument("WarpFilter::remap: invalid remap table");
+    }
+    WarpFilter filter;
+    filter.kind = Kind::Remap;
+    filter.remapTable = std::move(table);
+    filter.interpolation = interpolation;
+    return filter;
+}
+
+WarpFilter WarpFilter::lensCorrection(const LensModel& lens, WarpInterpolation interpolation) {
+    WarpFilter filter;
+    filter.kind = Kind::Lens;
+    filter.lensModel = lens;
+    filter.interpolation = interpolation;
+    return filter;
+}
+
+bool WarpFilter::invertMatrix(const std::array<double, 9>& m, std::array<double, 9>& inverse) {
+    const double c00 = m[4] * m[8] - m[5] * m[7];
+    const double c01 = m[5] * m[6] - m[3] * m[8];
+    const double c02 = m[3] * m[7] - m[4] * m[6];
+    const double det = m[0] * c00 + m[1] * c01 + m[2] * c02;
+
+    if (std::fabs(det) < 1e-12) {
+        return false;
+    }
+
+    inverse = {c00, m[2] * m[7] - m[1] * m[8], m[1] * m[5] - m[2] * m[4],
+               c01, m[0] * m[8] - m[2] * m[6], m[2] * m[3] - m[0] * m[5],
+               c02, m[1] * m[6] - m[0] * m[7], m[0] * m[4] - m[1] * m[3]};
+
+    // Normalize so that inverse[8] == 1 (keeps affine inverses exactly affine)
+    const double scale = std::fabs(inverse[8]) > 1e-12 ? inverse[8] : det;
+    for (double& v : inverse) {
+        v /= scale;
+    }
+    if (m[6] == 0.0 && m[7] == 0.0) {
+        inverse[6] = 0.0;
+        inverse[7] = 0.0;
+        inverse[8] = 1.0;
+    }
+    return true;
+}
+
+WarpFilter::ResolvedMapping WarpFilter::resolve(const Image& input) const {
+    ResolvedMapping mapping;
+    mapping.width = outputWidth > 0 ? outputWidth : input.getWidth();
+    mapping.height = outputHeight > 0 ? outputHeight : input.getHeight();
+
+    switch (kind) {
+        case Kind::Projective:
+            if (!invertMatrix(forwardMatrix, mapping.sourceFromDest)) {
+                throw std::invalid_argument("WarpFilter: singular transformation matrix");
+            }
+            break;
+
+        case Kind::Rotation: {
+            // src = R(-angle) * (dst - outputCenter) + inputCenter
+            const double radians = angleDegrees * 3.14159265358979323846 / 180.0;
+            const double c = std::cos(radians);
+            const double s = std::sin(radians);
+            const double inCx = input.getWidth() / 2.0;
+            const double inCy = input.getHeight() / 2.0;
+            const double outCx = mapping.width / 2.0;
+            const double outCy = mapping.height / 2.0;
+            mapping.sourceFromDest = { c, s, inCx - c * outCx - s * outCy,
+                                      -s, c, inCy + s * outCx - c * outCy,
+                                      0.0, 0.0, 1.0};
+            break;
+        }
+
+        case Kind::Remap:
+            mapping.table = remapTable;
+            mapping.width = remapTable->width;
+            mapping.height = remapTable->height;
+            break;
+
+        case Kind::Lens:
+            mapping.width = input.getWidth();
+            mapping.height = input.getHeight();
+            mapping.table = getLensRemapTable(lensModel, mapping.width, mapping.height);
+            break;
+    }
+
+    return mapping;
+}
+
+void WarpFilter::apply(const Image& input, Image& output) {
+    auto start = std::chrono::high_resolution_clock::now();
+
+    const ResolvedMapping mapping = resolve(input);
+    const int srcWidth = input.getWidth();
+    const int srcHeight = input.getHeight();
+    const int channels = input.getChannels();
+    const int width = mapping.width;
+    const int height = mapping.height;
+
+    output = Image(width, height, channels);
+
+    const uint8_t* src = input.data();
+    uint8_t* dst = output.data();
+    const bool replicate = (border == WarpBorder::Replicate);
+    const bool bicubic = (interpolation == WarpInterpolation::Bicubic);
+    const RemapTable* table = mapping.table.get();
+    const std::array<double, 9>& m = mapping.sourceFromDest;
+    const bool affineMapping = !table && isAffine(m);
+
+    const int tilesY = (height + TILE_HEIGHT - 1) / TILE_HEIGHT;
+    const int tilesX = (width + TILE_WIDTH - 1) / TILE_WIDTH;
+
+    // Affine row increments in 16.16 fixed point
+    const int32_t stepX = static_cast<int32_t>(std::lround(m[0] * warpmath::FIXED_ONE));
+    const int32_t stepY = static_cast<int32_t>(std::lround(m[3] * warpmath::FIXED_ONE));
+
+    #pragma omp parallel
+    {
+        std::vector<int32_t> coordX(TILE_WIDTH);
+        std::vector<int32_t> coordY(TILE_WIDTH);
+
+        #pragma omp for collapse(2) schedule(dynamic)
+        for (int ty = 0; ty < tilesY; ++ty) {
+            for (int tx = 0; tx < tilesX; ++tx) {
+                const int xBegin = tx * TILE_WIDTH;
+                const int span = std::min(width, xBegin + TILE_WIDTH) - xBegin;
+                const int yEnd = std::min(height, (ty + 1) * TILE_HEIGHT);
+
+                for (int y = ty * TILE_HEIGHT; y < yEnd; ++y) {
+                    if (table) {
+                        const size_t rowOffset = static_cast<size_t>(y) * width + xBegin;
+                        const float* mapX = table->mapX.data() + rowOffset;
+                        const float* mapY = table->mapY.data() + rowOffset;
+                        for (int i = 0; i < span; ++i) {
+                            coordX[i] = warpmath::toFixed(mapX[i]);
+                            coordY[i] = warpmath::toFixed(mapY[i]);
+                        }
+                    } else if (affineMapping) {
+                        // Pixel centers: source = M * (x + 0.5, y + 0.5) - 0.5
+                        const double px = xBegin + 0.5;
+                        const double py = y + 0.5;
+                        const double u0 = m[0] * px + m[1] * py + m[2] - 0.5;
+                        const double v0 = m[3] * px + m[4] * py + m[5] - 0.5;
+                        const double u1 = u0 + m[0] * span;
+                        const double v1 = v0 + m[3] * span;
+                        const double limit = warpmath::FIXED_LIMIT;
+
+                        if (std::fabs(u0) < limit && std::fabs(v0) < limit &&
+                            std::fabs(u1) < limit && std::fabs(v1) < limit) {
+                            int32_t sx = warpmath::toFixed(static_cast<float>(u0));
+                            int32_t sy = warpmath::toFixed(static_cast<float>(v0));
+                            for (int i = 0; i < span; ++i) {
+                                coordX[i] = sx;
+                                coordY[i] = sy;
+                                sx += stepX;
+                                sy += stepY;
+                            }
+                        } else {
+                            for (int i = 0; i < span; ++i) {
+                                coordX[i] = warpmath::toFixed(static_cast<float>(u0 + m[0] * i));
+                                coordY[i] = warpmath::toFixed(static_cast<float>(v0 + m[3] * i));
+                            }
+                        }
+                    } else {
+                        const double px = xBegin + 0.5;
+                        const double py = y + 0.5;
+                        double X = m[0] * px + m[1] * py + m[2];
+                        double Y = m[3] * px + m[4] * py + m[5];
+                        double W = m[6] * px + m[7] * py + m[8];
+                        for (int i = 0; i < span; ++i) {
+                            if (W > 1e-12) {
+                                const double inv = 1.0 / W;
+                                coordX[i] = warpmath::toFixed(static_cast<float>(X * inv - 0.5));
+                                coordY[i] = warpmath::toFixed(static_cast<float>(Y * inv - 0.5));
+                            } else {
+                                // Behind the projection plane: always outside the source
+                                coordX[i] = warpmath::toFixed(-warpmath::FIXED_LIMIT);
+                                coordY[i] = warpmath::toFixed(-warpmath::FIXED_LIMIT);
+                            }
+                            X += m[0];
+                            Y += m[3];
+                            W += m[6];
+                        }
+                    }
+
+                    uint8_t* outRow = dst + static_cast<size_t>(y) * width * channels;
+                    for (int i = 0; i < span; ++i) {
+                        const size_t dstIndex = static_cast<size_t>(xBegin + i) * channels;
+                        if (bicubic) {
+                            warpmath::sampleBicubic(src, srcWidth, srcHeight, channels,
+                                                    coordX[i], coordY[i], replicate, outRow, dstIndex);
+                        } else {
+                            warpmath::sampleBilinear(src, srcWidth, srcHeight, channels,
+                                                     coordX[i], coordY[i], replicate, outRow, dstIndex);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    auto end = std::chrono::high_resolution_clock::now();
+    lastExecutionTime = std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+std::shared_ptr<const RemapTable> WarpFilter::getLensRemapTable(const LensModel& lens, int width, int height) {
+    const LensKey key{lens.fx, lens.fy, lens.cx, lens.cy, lens.k1, lens.k2, lens.k3,
+                      lens.p1, lens.p2, width, height};
+
+    {
+        std::lock_guard<std::mutex> lock(remapCacheMutex);
+        auto it = remapCache.find(key);
+        if (it != remapCache.end()) {
+            it->second.lastUse = ++remapCacheClock;
+            return it->second.table;
+        }
+    }
+
+    // Build outside the lock: other sizes/cameras stay available meanwhile
+    auto table = std::make_shared<RemapTable>();
+    table->width = width;
+    table->height = height;
+    table->mapX.resize(static_cast<size_t>(width) * height);
+    table->mapY.resize(static_cast<size_t>(width) * height);
+
+    const double fx = lens.fx > 0.0 ? lens.fx : std::max(width, height);
+    const double fy = lens.fy > 0.0 ? lens.fy : fx;
+    const double cx = lens.cx != 0.0 ? lens.cx : (width - 1) / 2.0;
+    const double cy = lens.cy != 0.0 ? lens.cy : (height - 1) / 2.0;
+
+    #pragma omp parallel for schedule(static)
+    for (int y = 0; y < height; ++y) {
+        const double yn = (y - cy) / fy;
+        for (int x = 0; x < width; ++x) {
+            const double xn = (x - cx) / fx;
+            const double r2 = xn * xn + yn * yn;
+            const double radial = 1.0 + r2 * (lens.k1 + r2 * (lens.k2 + r2 * lens.k3));
+            const double xd = xn * radial + 2.0 * lens.p1 * xn * yn + lens.p2 * (r2 + 2.0 * xn * xn);
+            const double yd = yn * radial + lens.p1 * (r2 + 2.0 * yn * yn) + 2.0 * lens.p2 * xn * yn;
+
+            const size_t i = static_cast<size_t>(y) * width + x;
+            table->mapX[i] = static_cast<float>(xd * fx + cx);
+            table->mapY[i] = static_cast<float>(yd * fy + cy);
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(remapCacheMutex);
+
+    // Another thread may have built the same table meanwhile
+    auto it = remapCache.find(key);
+    if (it != remapCache.end()) {
+        it->second.lastUse = ++remapCacheClock;
+        return it->second.table;
+    }
+
+    if (remapCache.size() >= MAX_CACHED_TABLES) {
+        auto oldest = std::min_element(remapCache.begin(), remapCache.end(),
+            [](const auto& a, const auto& b) { return a.second.lastUse < b.second.lastUse; });
+        remapCache.erase(oldest);
+    }
+
+    remapCache[key] = CachedTable{++remapCacheClock, table};
+    return table;
+}
+
+void WarpFilter::clearRemapCache() {
+    std::lock_guard<std::mutex> lock(remapCacheMutex);
+    remapCache.clear();
+}
+
+std::string WarpFilter::getName() const {
+    std::ostringstream oss;
+    oss << "Warp (";
+    switch (kind) {
+        case Kind::Projective:
+            oss << (isAffine(forwardMatrix) ? "affine" : "perspective");
+            break;
+        case Kind::Rotation:
+            oss << "rotation " << std::fixed << std::setprecision(2) << angleDegrees << " deg";
+            break;
+        case Kind::Remap:
+            oss << "remap";
+            break;
+        case Kind::Lens:
+            oss << "lens correction";
+            break;
+    }
+    oss << (interpolation == WarpInterpolation::Bicubic ? ", bicubic" : ", bilinear") << ")";
+    return oss.str();
+}
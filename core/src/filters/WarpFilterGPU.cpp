@@ -0,0 +1,128 @@
+/**
+ * @file WarpFilterGPU.cpp
+ * @brief GPU implementation of geometric warps using SYCL
+ *
+ * @details
+ * SYCL Implementation:
+ * - 2D range over the output image (rows x columns)
+ * - Matrix warps: the 3x3 inverse matrix is passed as floats (no fp64
+ *   requirement on the device)
+ * - Remap/lens warps: mapX/mapY are uploaded as read-only buffers
+ * - Sampling: warpmath::sampleBilinear / sampleBicubic on accessors
+ *
+ * Error Handling:
+ * - Catches sycl::exception and falls back to the CPU WarpFilter
+ *
+ * @see WarpFilter.cpp for the CPU version
+ * @author Rowan HOUPA
+ * @date January 2026
+ */
+
+#include "filters/WarpFilterGPU.hpp"
+#include <iostream>
+
+void WarpFilterGPU::apply(const Image& input, Image& output) {
+    auto start = std::chrono::high_resolution_clock::now();
+
+    const ResolvedMapping mapping = resolve(input);
+    output = Image(mapping.width, mapping.height, input.getChannels());
+
+    try {
+        sycl::queue q(sycl::gpu_selector_v);
+        reportDevice(q.get_device().get_info<sycl::info::device::name>());
+
+        std::cout << "Warp GPU sur: "
+                  << q.get_device().get_info<sycl::info::device::name>()
+                  << std::endl;
+
+        const int srcWidth = input.getWidth();
+        const int srcHeight = input.getHeight();
+        const int channels = input.getChannels();
+        const int width = mapping.width;
+        const int height = mapping.height;
+        const bool replicate = (border == WarpBorder::Replicate);
+        const bool bicubic = (interpolation == WarpInterpolation::Bicubic);
+
+        {
+            sycl::buffer<uint8_t, 1> bufIn(input.data(), sycl::range<1>(input.size()));
+            sycl::buffer<uint8_t, 1> bufOut(output.data(), sycl::range<1>(output.size()));
+
+            if (mapping.table) {
+                const RemapTable& table = *mapping.table;
+                sycl::buffer<float, 1> bufMapX(table.mapX.data(), sycl::range<1>(table.mapX.size()));
+                sycl::buffer<float, 1> bufMapY(table.mapY.data(), sycl::range<1>(table.mapY.size()));
+
+                q.submit([&](sycl::handler& h) {
+                    auto accIn = bufIn.get_access<sycl::access::mode::read>(h);
+                    auto accOut = bufOut.get_access<sycl::access::mode::write>(h);
+                    auto accMapX = bufMapX.get_access<sycl::access::mode::read>(h);
+                    auto accMapY = bufMapY.get_access<sycl::access::mode::read>(h);
+
+                    h.parallel_for(sycl::range<2>(height, width), [=](sycl::id<2> idx) {
+                        const size_t i = idx[0] * width + idx[1];
+                        const int32_t sx = warpmath::toFixed(accMapX[i]);
+                        const int32_t sy = warpmath::toFixed(accMapY[i]);
+                        if (bicubic) {
+                            warpmath::sampleBicubic(accIn, srcWidth, srcHeight, channels,
+                                                    sx, sy, replicate, accOut, i * channels);
+                        } else {
+                            warpmath::sampleBilinear(accIn, srcWidth, srcHeight, channels,
+                                                     sx, sy, replicate, accOut, i * channels);
+                        }
+                    });
+                }).wait();
+            } else {
+                float m[9];
+                for (int k = 0; k < 9; ++k) {
+                    m[k] = static_cast<float>(mapping.sourceFromDest[k]);
+                }
+                const float m0 = m[0], m1 = m[1], m2 = m[2];
+                const float m3 = m[3], m4 = m[4], m5 = m[5];
+                const float m6 = m[6], m7 = m[7], m8 = m[8];
+
+                q.submit([&](sycl::handler& h) {
+                    auto accIn = bufIn.get_access<sycl::access::mode::read>(h);
+                    auto accOut = bufOut.get_access<sycl::access::mode::write>(h);
+
+                    h.parallel_for(sycl::range<2>(height, width), [=](sycl::id<2> idx) {
+                        const float px = static_cast<float>(idx[1]) + 0.5f;
+                        const float py = static_cast<float>(idx[0]) + 0.5f;
+                        const float W = m6 * px + m7 * py + m8;
+                        const size_t i = idx[0] * width + idx[1];
+
+                        int32_t sx = warpmath::toFixed(-warpmath::FIXED_LIMIT);
+                        int32_t sy = sx;
+                        if (W > 1e-12f) {
+                            sx = warpmath::toFixed((m0 * px + m1 * py + m2) / W - 0.5f);
+                            sy = warpmath::toFixed((m3 * px + m4 * py + m5) / W - 0.5f);
+                        }
+
+                        if (bicubic) {
+                            warpmath::sampleBicubic(accIn, srcWidth, srcHeight, channels,
+                                                    sx, sy, replicate, accOut, i * channels);
+                        } else {
+                            warpmath::sampleBilinear(accIn, srcWidth, srcHeight, channels,
+                                                     sx, sy, replicate, accOut, i * channels);
+                        }
+                    });
+                }).wait();
+            }
+        }
+
+        auto end = std::chrono::high_resolution_clock::now();
+        lastExecutionTime = std::chrono::duration<double, std::milli>(end - start).count();
+
+        std::cout << "GPU Warp terminé en " << lastExecutionTime << " ms" << std::endl;
+
+    } catch (sycl::exception const& e) {
+        std::cerr << "SYCL exception: " << e.what() << std::endl;
+        std::cerr << "↩Fallback sur CPU..." << std::endl;
+        reportDevice("CPU");
+
+        WarpFilter cpuFallback(*this);
+        cpuFallback.apply(input, output);
+
+        auto end = std::chrono::high_resolution_clock::now();
+        lastExecutionTime = std::chrono::duration<double, std::milli>(end - start).count();
+    }
+}
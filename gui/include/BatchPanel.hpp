@@ -0,0 +1,165 @@
+/**
+ * @file BatchPanel.hpp
+ * @brief Folder browser with thumbnails and concurrent batch processing
+ *
+ * Lists the images of a folder as a grid of thumbnails and applies the
+ * editor's current pipeline to the selected ones, writing
+ * <stem>_batch<ext> into the output folder (the CLI batch naming).
+ *
+ * Thumbnails:
+ * - The grid is a QListView over BatchModel with uniform item sizes: the
+ *   view only lays out and paints the cells on screen, and asks the model
+ *   for the decoration of those cells only. That request is what queues a
+ *   decode, so a folder of ten thousand images costs ten thousand file
+ *   names until it is scrolled.
+ * - Decodes run on a small background pool, JPEG at a reduced size, and
+ *   go through the on-disk ThumbnailCache: a folder seen before shows at
+ *   once. Scrolling drops the queued decodes of the cells that left the
+ *   screen (the cells now visible ask again).
+ * - Converted pixmaps are kept in a memory-bounded QCache.
+ *
+ * Processing:
+ * - A pool runs several images at once (idealThreadCount / 4, 2 to 4):
+ *   the filters are already parallel inside an image, while decoding and
+ *   encoding are not, so a few images in flight keep the cores busy
+ * - Every image gets its own copy of the pipeline, taken when the batch
+ *   starts; editing in the main window does not affect a running batch
+ * - Per image: queued, progress while filtering (from applyWithProgress),
+ *   done or failed, drawn over its cell by BatchItemDelegate
+ * - Stop drops the queued images; the running ones complete
+ *
+ * @see ThumbnailCache for the disk cache
+ * @author Rowan HOUPA
+ * @date January 2026
+ */
+
+#ifndef BATCHPANEL_HPP
+#define BATCHPANEL_HPP
+
+#include <QAbstractListModel>
+#include <QCache>
+#include <QLabel>
+#include <QListView>
+#include <QPixmap>
+#include <QProgressBar>
+#include <QPushButton>
+#include <QSet>
+#include <QString>
+#include <QStyledItemDelegate>
+#include <QThreadPool>
+#include <QVector>
+#include <QWidget>
+
+#include <atomic>
+#include <functional>
+#include <memory>
+
+#include "FilterPipeline.hpp"
+#include "ThumbnailCache.hpp"
+
+class BatchModel : public QAbstractListModel {
+    Q_OBJECT
+
+public:
+    enum class Status { Idle, Queued, Running, Done, Failed };
+    enum Role { StatusRole = Qt::UserRole + 1, ProgressRole, PathRole };
+
+    explicit BatchModel(int thumbnailSize, QObject *parent = nullptr);
+
+    void setFiles(const QStringList &paths);
+    QString path(int row) const { return items[row].path; }
+
+    void setThumbnail(int row, const QImage &thumbnail);
+    // Forget pending requests (their decodes were dropped)
+    void clearPending() { pending.clear(); }
+
+    void setStatus(int row, Status status, int progress = 0, const QString &message = QString());
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+
+signals:
+    // A visible cell has no thumbnail yet and none is being decoded
+    void thumbnailNeeded(int row) const;
+
+private:
+    struct Item {
+        QString path;
+        Status status = Status::Idle;
+        int progress = 0;
+        QString message;
+    };
+
+    QVector<Item> items;
+    int thumbnailSize;
+    mutable QCache<int, QPixmap> thumbnails;    // Cost in KB
+    mutable QSet<int> pending;
+    QPixmap placeholder;
+};
+
+class BatchItemDelegate : public QStyledItemDelegate {
+    Q_OBJECT
+
+public:
+    using QStyledItemDelegate::QStyledItemDelegate;
+    void paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const override;
+};
+
+class BatchPanel : public QWidget {
+    Q_OBJECT
+
+public:
+    explicit BatchPanel(QWidget *parent = nullptr);
+    ~BatchPanel();
+
+    // Called when a batch starts, on the GUI thread: the pipeline to apply
+    void setPipelineSource(std::function<FilterPipeline()> source);
+    void setFolder(const QString &folder);
+    bool isRunning() const { return remaining > 0; }
+    // Drops the queued work and waits for the running jobs
+    void stop();
+
+signals:
+    void openRequested(const QString &path);
+    void batchFinished(int succeeded, int failed);
+
+private slots:
+    void onChooseFolder();
+    void onChooseOutput();
+    void onProcessSelected();
+    void onStop();
+    void onScrolled();
+    void requestThumbnail(int row);
+
+private:
+    void thumbnailReady(quint64 folderRequest, int row, const QImage &thumbnail);
+    void imageProgress(quint64 batch, int row, int percent);
+    // status: Done, Failed, or Idle for an image skipped by Stop
+    void imageFinished(quint64 batch, int row, BatchModel::Status status, const QString &message);
+    void updateSummary();
+
+    BatchModel *model;
+    QListView *view;
+    QLabel *folderLabel;
+    QLabel *outputLabel;
+    QLabel *summaryLabel;
+    QPushButton *processButton;
+    QPushButton *stopButton;
+    QProgressBar *batchProgress;
+
+    QString folder;
+    QString outputFolder;           // Empty: next to the inputs
+    std::function<FilterPipeline()> pipelineSource;
+    std::shared_ptr<ThumbnailCache> diskCache;
+
+    QThreadPool thumbnailPool;
+    QThreadPool processingPool;
+    quint64 folderRequest = 0;      // Thumbnails of an older listing are dropped
+    quint64 batchRequest = 0;
+    std::atomic<quint64> liveBatch{0};  // Read by queued jobs: stopped batches skip them
+    int remaining = 0;
+    int succeeded = 0;
+    int failed = 0;
+};
+
+#endif
@@ -0,0 +1,153 @@
+/**
+ * @file ImageViewport.hpp
+ * @brief Zoomable, pannable image view drawing pipeline tiles on demand
+ *
+ * Replaces the fixed 400x300 preview labels. The view only requests the
+ * tiles it can see, at the pyramid level matching its zoom, from a
+ * TileCache; tiles already computed are reused while panning and zooming.
+ *
+ * Progressive refinement, so an edit is visible at once and sharpens after:
+ * 1. Coarse: two pyramid levels below the display resolution (1/16 of the
+ *    pixels), computed synchronously while painting. A pipeline with a
+ *    whole-image filter needs a full-resolution run first: that run goes to
+ *    the background thread and the unfiltered level is shown until it ends
+ * 2. Display resolution, once the view has been still for 150 ms
+ * 3. Full resolution (level 0), tile by tile
+ * Stages 2 and 3 run on a background thread, in that order; each finished
+ * tile is swapped in by a repaint (finer levels are drawn over coarser
+ * ones). An edit, pan or zoom cancels the queued refinements immediately;
+ * a tile already being filtered completes but its result is dropped when
+ * the pipeline changed (TileCache generation).
+ *
+ * Interaction:
+ * - Mouse wheel: zoom around the cursor (x1.25 per notch, 1/64 to 32x)
+ * - Left drag: pan
+ * - Double click: fit to window / 100% toggle
+ *
+ * @details
+ * - View model: source pixel at the widget center + zoom (screen pixels per
+ *   source pixel); setView()/viewChanged() keep two viewports in sync
+ * - Converted tiles are kept as QPixmaps in a QCache keyed by (cache
+ *   generation, level, tile), so repaints do not convert again
+ * - Magnified tiles are drawn with nearest-neighbour sampling (pixels stay
+ *   sharp for inspection), reduced ones with smoothing
+ * - One refinement thread: filters already spread each tile over the cores
+ *   with OpenMP, concurrent tiles would only oversubscribe them
+ * - The painting thread (coarse stage) and the refinement thread may miss
+ *   tiles at the same time; TileCache::tile() gives each its own copy of
+ *   the pipeline, so no filter instance is ever run by both
+ *
+ * @see TileCache for the tiling scheme
+ * @author Rowan HOUPA
+ * @date January 2026
+ */
+
+#ifndef IMAGEVIEWPORT_HPP
+#define IMAGEVIEWPORT_HPP
+
+#include <QWidget>
+#include <QCache>
+#include <QThreadPool>
+#include <QTimer>
+#include <QPixmap>
+#include <QImage>
+#include <QPointF>
+#include <QString>
+
+class QPainter;
+
+#include <atomic>
+#include <vector>
+
+#include "Image.hpp"
+#include "TileCache.hpp"
+
+class ImageViewport : public QWidget {
+    Q_OBJECT
+
+public:
+    explicit ImageViewport(QWidget *parent = nullptr);
+    ~ImageViewport();
+
+    // Tile source (not owned); nullptr shows the placeholder text
+    void setTileCache(TileCache *cache);
+    void setPlaceholderText(const QString &text);
+
+    double getZoom() const { return zoom; }
+    QPointF getCenter() const { return center; }
+    // Visible part of the source, in source pixels
+    QRectF visibleSourceRect() const;
+    // Visible tiles of the coarse and display stages (what an edit shows first)
+    std::vector<TileIndex> previewTiles() const;
+
+    // Deep copy of an Image as a QImage (gray, gray + alpha, RGB, RGBA)
+    static QImage toQImage(const Image &image);
+    // And back: gray, RGB or RGBA depending on the QImage
+    static Image fromQImage(const QImage &image);
+
+public slots:
+    void setView(double zoom, const QPointF &center);
+    void fitToWindow();
+    // Tiles changed (new pipeline or image): cancel refinements, repaint coarse
+    void refresh();
+    // Drops queued refinements and waits for the running tile (before the
+    // TileCache goes away)
+    void stopRendering();
+
+signals:
+    void viewChanged(double zoom, const QPointF &center);
+    void renderError(const QString &message);
+    // Background refinement: tiles done out of those queued by the last request
+    void refinementProgress(int done, int total);
+    // Every visible tile is at full resolution (the view has nothing left to compute)
+    void refinementIdle();
+    // A repaint finished drawing tiles of the current pipeline (latency measurement)
+    void framePresented();
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void wheelEvent(QWheelEvent *event) override;
+    void mousePressEvent(QMouseEvent *event) override;
+    void mouseMoveEvent(QMouseEvent *event) override;
+    void mouseReleaseEvent(QMouseEvent *event) override;
+    void mouseDoubleClickEvent(QMouseEvent *event) override;
+    void resizeEvent(QResizeEvent *event) override;
+
+private slots:
+    void scheduleRefinement();
+
+private:
+    struct TileRange {
+        int tx0, ty0, tx1, ty1;
+    };
+
+    double fitZoom() const;
+    void applyView(double newZoom, const QPointF &newCenter);
+    void cancelRefinement();
+    int displayLevel() const;
+    int coarseLevel() const;
+    TileRange visibleTiles(int level) const;
+    // Draws the level's visible tiles; computes missing ones when compute is
+    // set (unfiltered: some were drawn unfiltered, see tilePixmap)
+    bool drawLevel(QPainter &painter, int level, bool compute, bool *unfiltered = nullptr);
+    // With compute, a tile of a whole-image pipeline not run yet is the
+    // unfiltered level and sets *unfiltered
+    const QPixmap *tilePixmap(int level, int tx, int ty, bool compute, bool *unfiltered = nullptr);
+
+    TileCache *tileCache = nullptr;
+    QString placeholder;
+    double zoom = 1.0;
+    QPointF center;
+    bool fitted = true;             // Keep fitting on resize until the user zooms
+    bool dragging = false;
+    QPointF lastMousePosition;
+    uint64_t pixmapGeneration = 0;
+    uint64_t failedGeneration = UINT64_MAX;
+    QCache<quint64, QPixmap> pixmaps;
+
+    QTimer settleTimer;                 // Starts stage 2 once the view is still
+    QThreadPool refinementPool;         // One thread, FIFO
+    std::atomic<uint64_t> refinementEpoch{0};
+};
+
+#endif
@@ -8,17 +8,33 @@
  *
  * @details
  * GUI Architecture:
- * - Left panel: Original and processed image display (QLabel with QPixmap)
+ * - Left panel: Original and processed image views (ImageViewport: zoom and
+ *   pan kept in sync, tiles processed on demand through a TileCache)
  * - Right panel: Filter pipeline management, parameters, GPU toggle
- * - Menu bar: File operations (open, save, exit), Help (about)
+ * - Menu bar: File operations (open, save, batch panel, exit), Edit (undo, redo),
+ *   View (performance HUD), Help (about)
  * - Status bar: Current operation status and image info
  *
  * Key Features:
- * - Real-time preview with debounced timer (100ms delay)
+ * - Real-time preview: only the visible tiles are processed, first at a
+ *   coarse level (immediately), then at display and full resolution in the
+ *   background. The full image is processed on explicit Apply, or on Save
+ *   when the result is out of date
+ * - Speculative preview: while idle, the previews of the next values of the
+ *   last moved parameter control are precomputed (PreviewSpeculator), so
+ *   the next slider step shows at once
+ * - Undo/redo of every pipeline edit (EditHistory: filter diffs, compressed
+ *   snapshots of applied results, bounded memory); a slider drag is one step
  * - Dynamic filter menu built from FilterFactory registry
  * - GPU acceleration toggle (SYCL-based)
  * - Progress bar for long-running pipeline operations
+ * - Asynchronous open (reduced JPEG decode shown first) and save (the
+ *   worker gets a copy of the result, the window stays responsive)
  * - Parameter sliders for brightness and blur radius
+ * - Performance HUD: per-filter time and device, pipeline time, preview
+ *   latency and memory, over the processed view (PerformanceHud)
+ * - Batch panel (dock, File menu): thumbnail grid of a folder, current
+ *   pipeline applied to the selected images on a background pool
  *
  * Qt Components Used:
  * - QMainWindow: Main application window framework
@@ -60,12 +76,27 @@
 #include <QFileInfo>
 #include <QStandardPaths>
 #include <QCloseEvent>
+#include <QThreadPool>
+#include <QDockWidget>
+#include <QElapsedTimer>
+
+#include <memory>
 
 #include "Image.hpp"
 #include "FilterPipeline.hpp"
+#include "TileCache.hpp"
+#include "EditHistory.hpp"
+#include "ImageViewport.hpp"
+#include "PreviewSpeculator.hpp"
+#include "BatchPanel.hpp"
+#include "PerformanceHud.hpp"
+#include "PipelineProfile.hpp"
 #include "FilterFactory.hpp"
 #include "filters/BrightnessFilter.hpp"
 #include "filters/BoxBlurFilter.hpp"
+#include "filters/BlendFilter.hpp"
+#include "filters/WarpFilter.hpp"
+#include "filters/ThresholdFilter.hpp"
 
 QT_BEGIN_NAMESPACE
 namespace Ui { class MainWindow; }
@@ -86,6 +117,10 @@ private slots:
     void onFileSave();
     void onFileExit();
 
+    void onUndo();
+    void onRedo();
+    void onPerformanceHudToggle(bool visible);
+
     void onAddFilter();
     void onRemoveFilter();
     void onMoveFilterUp();
@@ -101,6 +136,8 @@ private slots:
     void onBlurRadiusChanged(int value);
 
     void updatePreview();
+    void onRenderError(const QString &message);
+    void speculateNeighbours();
 
     void onAbout();
     void onAboutQt();
@@ -113,27 +150,56 @@ private:
     void createCentralWidget();
     void createFilterPanel();
     void createImagePanel();
+    void createBatchPanel();
 
+    // Both return once the work is handed to a background thread
     bool loadImage(const QString &filepath);
     bool saveImage(const QString &filepath);
+    void showLoadPreview(quint64 request, std::shared_ptr<const Image> preview, const QSize &fullSize);
+    void finishLoading(quint64 request, const QString &filepath, std::shared_ptr<Image> newImage);
+    // percent: share of the file decoded, -1 keeps the current value
+    void updateIoProgress(int percent = -1);
     void updateImageDisplays();
     void updateFilterList();
     void applyFilters(bool preview = false);
+    void pipelineChanged();
+    // Records the edit just made to pipeline (see EditHistory::record)
+    void recordEdit(size_t position, size_t removed, size_t inserted, const QString &label,
+                    const std::string &mergeKey = "");
+    void restoreHistoryState();
+    void updateHistoryActions();
+    // Position of filter in the pipeline, pipeline.size() when absent
+    size_t filterIndex(const Filter *filter) const;
+    // Value of a tracked parameter control changed (keeps its speculation)
+    void parameterChanged(const QString &control, int value);
+    void schedulePreview();
+    // New profile for the pipeline as just edited (the HUD shows it)
+    void resetProfile();
+    void onFramePresented();
+    void onPreviewComplete();
+    bool hasImage() const { return originalImage != nullptr; }
 
-    QPixmap imageToPixmap(const Image &img) const;
     void showStatusMessage(const QString &message, int timeout = 5000);
     void showErrorMessage(const QString &title, const QString &message);
     void setControlsEnabled(bool enabled);
     
-    Image originalImage;
-    Image processedImage;
+    std::shared_ptr<const Image> originalImage;
+    Image processedImage;           // Full-resolution result of the last Apply
+    bool processedStale = true;     // Pipeline edited since processedImage was computed
     FilterPipeline pipeline;
+    TileCache originalTiles;        // Pyramid of the original (empty pipeline)
+    TileCache processedTiles;       // Preview tiles of the current pipeline
+    EditHistory history;            // Undo/redo of pipeline edits
+    PreviewSpeculator speculator;   // Previews of the neighbouring parameter values
+    QString speculatedControl;      // Last moved control ("brightness", "blur"), empty after other edits
+    int speculatedValue = 0;
+    int speculationStep = 1;        // Direction of its last move, speculated first
     
     BrightnessFilter* brightnessFilter = nullptr;
-    BoxBlurFilter* blurFilter = nullptr;
+    Filter* blurFilter = nullptr;   // CPU or GPU box blur, both a BoxBlurRadius
     
-    QLabel *originalImageLabel;
-    QLabel *processedImageLabel;
+    ImageViewport *originalView;
+    ImageViewport *processedView;
     QListWidget *filterListWidget;
     
     QPushButton *addFilterButton;
@@ -157,6 +223,9 @@ private:
     QAction *fileOpenAction;
     QAction *fileSaveAction;
     QAction *fileExitAction;
+    QAction *editUndoAction;
+    QAction *editRedoAction;
+    QAction *viewPerformanceAction;
     QAction *helpAboutAction;
     QAction *helpAboutQtAction;
     
@@ -164,6 +233,22 @@ private:
     bool previewEnabled = true;
     bool gpuEnabled = false;
     bool isProcessing = false;
+    
+    QThreadPool ioPool;             // Background open/save
+    quint64 loadRequest = 0;        // Latest open; results of older ones are dropped
+    bool loading = false;
+    int pendingSaves = 0;
+    QProgressBar *ioProgressBar;
+    
+    BatchPanel *batchPanel;         // Folder thumbnails and batch processing (dock)
+    QDockWidget *batchDock;
+    
+    PerformanceHud *performanceHud; // Over the processed view, hidden by default
+    std::shared_ptr<PipelineProfile> profile;   // Timings of the current pipeline and its copies
+    QElapsedTimer latencyClock;     // Since the oldest edit not yet on screen
+    bool latencyPending = false;    // An edit waits for its preview
+    bool latencyArmed = false;      // Its pipeline is in the tile cache: the next repaint shows it
+    double firstLatencyMs = -1.0;
 
     QTimer previewTimer;
 };
@@ -0,0 +1,78 @@
+/**
+ * @file PerformanceHud.hpp
+ * @brief Optional overlay with live pipeline timings, preview latency and memory
+ *
+ * Shown over the processed view (Affichage > Performances, F12). Lines:
+ * - One per filter: device of its last call (CPU or the SYCL device name),
+ *   time per megapixel, share of the pipeline time, last call
+ * - Pipeline: time per megapixel, last run, last Apply
+ * - Preview latency: from the edit to the first repaint with the new
+ *   pipeline (coarse tiles), and to the full-resolution preview
+ * - Memory: resident set of the process, plus the figures MainWindow
+ *   reports (tile caches, history, images)
+ *
+ * @details
+ * - The figures come from the PipelineProfile every copy of the pipeline
+ *   reports into (preview tiles on the refinement thread, Apply on the GUI
+ *   thread). A 250 ms timer copies them out (PipelineProfile::getStats holds
+ *   its lock for a copy, never while a filter runs) and repaints: the GUI
+ *   thread never waits for a filter or a tile
+ * - Opaque, so repainting it does not repaint the view below (which would
+ *   redraw tiles and count as a presented frame)
+ * - The timer only runs while the HUD is visible
+ *
+ * @see PipelineProfile for the collection
+ * @author Rowan HOUPA
+ * @date January 2026
+ */
+
+#ifndef PERFORMANCEHUD_HPP
+#define PERFORMANCEHUD_HPP
+
+#include <QString>
+#include <QStringList>
+#include <QTimer>
+#include <QWidget>
+
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "PipelineProfile.hpp"
+
+class PerformanceHud : public QWidget {
+    Q_OBJECT
+
+public:
+    explicit PerformanceHud(QWidget *parent = nullptr);
+
+    void setProfile(std::shared_ptr<const PipelineProfile> profile);
+    // Edit to first repaint and to full-resolution preview, in ms (< 0: pending)
+    void setPreviewLatency(double firstMs, double completeMs);
+    void setApplyTime(double ms);
+    // (label, bytes) figures sampled with each refresh, on the GUI thread
+    void setMemoryProbe(std::function<std::vector<std::pair<QString, size_t>>()> probe);
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void showEvent(QShowEvent *event) override;
+    void hideEvent(QHideEvent *event) override;
+
+private slots:
+    void refreshStats();
+
+private:
+    // Resident set size of this process, 0 when unknown
+    static size_t residentBytes();
+
+    std::shared_ptr<const PipelineProfile> profile;
+    std::function<std::vector<std::pair<QString, size_t>>()> memoryProbe;
+    double firstLatencyMs = -1.0;
+    double completeLatencyMs = -1.0;
+    double applyMs = -1.0;
+    QStringList lines;
+    QTimer refreshTimer;
+};
+
+#endif
@@ -0,0 +1,89 @@
+/**
+ * @file PreviewSpeculator.hpp
+ * @brief Idle-time precomputation of previews for the next parameter steps
+ *
+ * A slider or spin box moves one step at a time, so the next preview the
+ * user asks for is almost always value ± 1 of the control that last
+ * changed. While the viewport has nothing left to refine, MainWindow hands
+ * the speculator one pipeline per neighbouring value; the speculator
+ * filters the tiles the viewport would show first (coarse and display
+ * levels, see ImageViewport::previewTiles) into a side TileCache per value.
+ * When the control then reaches one of those values, take() moves the
+ * tiles into the live cache and the view repaints without filtering.
+ *
+ * @details
+ * - Entries are keyed by (control, value) and kept in a small LRU
+ *   (6 entries: both neighbours of the last three values); a slider
+ *   swept back and forth keeps hitting them
+ * - Entries only describe the pipeline around the tracked parameter:
+ *   MainWindow calls invalidate() on any other edit
+ * - Side caches share the live cache's source pyramid (shareSource), so
+ *   speculation never downscales the image again
+ * - One background thread, lowest priority; cancel() drops queued work
+ *   through an epoch counter as soon as real work arrives (an edit, a pan,
+ *   a zoom), a tile already being filtered completes and is kept
+ *
+ * @see TileCache::adoptTiles for the hand-over
+ * @author Rowan HOUPA
+ * @date January 2026
+ */
+
+#ifndef PREVIEWSPECULATOR_HPP
+#define PREVIEWSPECULATOR_HPP
+
+#include <QObject>
+#include <QString>
+#include <QThreadPool>
+
+#include <atomic>
+#include <list>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "FilterPipeline.hpp"
+#include "TileCache.hpp"
+
+class PreviewSpeculator : public QObject {
+    Q_OBJECT
+
+public:
+    explicit PreviewSpeculator(size_t capacity = 6, QObject *parent = nullptr);
+    ~PreviewSpeculator();
+
+    // Queues the tiles of each (value, pipeline) variant of control that
+    // are not cached yet; base provides the source pyramid
+    void speculate(const QString &control, const std::vector<std::pair<int, FilterPipeline>> &variants,
+                   const TileCache &base, const std::vector<TileIndex> &tiles);
+    // Moves the precomputed tiles of (control, value) into target, whose
+    // pipeline must be the matching one; false when nothing was ready
+    bool take(const QString &control, int value, TileCache &target);
+
+    // Drops queued work, keeps the entries
+    void cancel();
+    // Drops queued work and every entry (the rest of the pipeline changed)
+    void invalidate();
+    // cancel() and waits for the running tile
+    void stop();
+
+    size_t getHits() const { return hits; }
+    size_t getMisses() const { return misses; }
+
+private:
+    struct Entry {
+        QString control;
+        int value;
+        std::shared_ptr<TileCache> tiles;
+    };
+
+    std::list<Entry>::iterator findEntry(const QString &control, int value);
+
+    size_t capacity;
+    std::list<Entry> entries;       // Most recently used first
+    size_t hits = 0;
+    size_t misses = 0;
+    QThreadPool pool;               // One thread, FIFO
+    std::atomic<uint64_t> epoch{0};
+};
+
+#endif
@@ -0,0 +1,435 @@
+/**
+ * @file BatchPanel.cpp
+ * @brief Thumbnail model, per-image status drawing and the batch workers
+ *
+ * @details
+ * Thread rules: workers never touch the model. Thumbnail decodes and batch
+ * jobs post their results back with QMetaObject::invokeMethod (queued, on
+ * this panel), tagged with the listing or batch they belong to; results of
+ * an older listing are dropped.
+ *
+ * A batch job checks liveBatch when it starts: after Stop, queued jobs
+ * only report themselves skipped, so every started image is accounted for
+ * and the panel knows when the running ones are done.
+ *
+ * @see BatchPanel.hpp for the overall design
+ * @author Rowan HOUPA
+ * @date January 2026
+ */
+
+#include "BatchPanel.hpp"
+#include "ContactSheet.hpp"
+#include "ImageViewport.hpp"
+#include <QDir>
+#include <QFileDialog>
+#include <QFileInfo>
+#include <QHBoxLayout>
+#include <QImageReader>
+#include <QItemSelectionModel>
+#include <QMetaObject>
+#include <QPainter>
+#include <QScrollBar>
+#include <QStandardPaths>
+#include <QThread>
+#include <QVBoxLayout>
+#include <algorithm>
+
+namespace {
+    constexpr int THUMBNAIL_EDGE = 160;
+    constexpr int PIXMAP_CACHE_KB = 64 * 1024;
+    constexpr size_t DISK_CACHE_BYTES = size_t(256) << 20;
+    const QStringList IMAGE_PATTERNS = {"*.png", "*.jpg", "*.jpeg", "*.bmp", "*.tga"};
+}
+
+// ==================== MODEL ====================
+
+BatchModel::BatchModel(int thumbnailSize, QObject *parent)
+    : QAbstractListModel(parent), thumbnailSize(thumbnailSize), placeholder(thumbnailSize, thumbnailSize) {
+    thumbnails.setMaxCost(PIXMAP_CACHE_KB);
+    placeholder.fill(QColor(60, 60, 60));
+}
+
+void BatchModel::setFiles(const QStringList &paths) {
+    beginResetModel();
+    items.clear();
+    items.reserve(paths.size());
+    for (const QString &path : paths) {
+        items.push_back({path});
+    }
+    thumbnails.clear();
+    pending.clear();
+    endResetModel();
+}
+
+void BatchModel::setThumbnail(int row, const QImage &thumbnail) {
+    if (row < 0 || row >= items.size()) {
+        return;
+    }
+    pending.remove(row);
+    // An undecodable file keeps the placeholder instead of asking again
+    auto *pixmap = new QPixmap(thumbnail.isNull() ? placeholder : QPixmap::fromImage(thumbnail));
+    thumbnails.insert(row, pixmap, std::max(1, pixmap->width() * pixmap->height() * 4 / 1024));
+    const QModelIndex cell = index(row);
+    emit dataChanged(cell, cell, {Qt::DecorationRole});
+}
+
+void BatchModel::setStatus(int row, Status status, int progress, const QString &message) {
+    if (row < 0 || row >= items.size()) {
+        return;
+    }
+    Item &item = items[row];
+    item.status = status;
+    item.progress = progress;
+    item.message = message;
+    const QModelIndex cell = index(row);
+    emit dataChanged(cell, cell, {StatusRole, ProgressRole, Qt::ToolTipRole});
+}
+
+int BatchModel::rowCount(const QModelIndex &parent) const {
+    return parent.isValid() ? 0 : items.size();
+}
+
+QVariant BatchModel::data(const QModelIndex &index, int role) const {
+    if (!index.isValid() || index.row() >= items.size()) {
+        return QVariant();
+    }
+    const int row = index.row();
+    const Item &item = items[row];
+
+    switch (role) {
+    case Qt::DisplayRole:
+        return QFileInfo(item.path).fileName();
+    case Qt::DecorationRole:
+        // Only asked for the cells the view paints: this is the lazy part
+        if (const QPixmap *pixmap = thumbnails.object(row)) {
+            return *pixmap;
+        }
+        if (!pending.contains(row)) {
+            pending.insert(row);
+            emit thumbnailNeeded(row);
+        }
+        return placeholder;
+    case Qt::ToolTipRole:
+        return item.message.isEmpty() ? item.path : item.path + "\n" + item.message;
+    case StatusRole:
+        return static_cast<int>(item.status);
+    case ProgressRole:
+        return item.progress;
+    case PathRole:
+        return item.path;
+    default:
+        return QVariant();
+    }
+}
+
+// ==================== DELEGATE ====================
+
+void BatchItemDelegate::paint(QPainter *painter, const QStyleOptionViewItem &option,
+                              const QModelIndex &index) const {
+    QStyledItemDelegate::paint(painter, option, index);
+
+    const auto status = static_cast<BatchModel::Status>(index.data(BatchModel::StatusRole).toInt());
+    if (status == BatchModel::Status::Idle) {
+        return;
+    }
+
+    // Thin bar along the top of the cell
+    const QRect bar(option.rect.left() + 6, option.rect.top() + 4, option.rect.width() - 12, 6);
+    int percent = index.data(BatchModel::ProgressRole).toInt();
+    QColor color = option.palette.highlight().color();
+    if (status == BatchModel::Status::Queued) {
+        percent = 0;
+    } else if (status == BatchModel::Status::Done) {
+        percent = 100;
+        color = QColor(60, 170, 80);
+    } else if (status == BatchModel::Status::Failed) {
+        percent = 100;
+        color = QColor(200, 60, 50);
+    }
+
+    painter->save();
+    painter->fillRect(bar, QColor(30, 30, 30, 200));
+    painter->fillRect(QRect(bar.left(), bar.top(), bar.width() * std::clamp(percent, 0, 100) / 100, bar.height()), color);
+    painter->restore();
+}
+
+// ==================== PANEL ====================
+
+BatchPanel::BatchPanel(QWidget *parent) : QWidget(parent) {
+    const QString cacheDirectory =
+        QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/thumbnails";
+    diskCache = std::make_shared<ThumbnailCache>(cacheDirectory.toStdString(), THUMBNAIL_EDGE);
+
+    thumbnailPool.setMaxThreadCount(2);
+    thumbnailPool.setThreadPriority(QThread::LowPriority);
+    processingPool.setMaxThreadCount(std::clamp(QThread::idealThreadCount() / 4, 2, 4));
+
+    auto *layout = new QVBoxLayout(this);
+
+    auto *folderRow = new QHBoxLayout();
+    auto *folderButton = new QPushButton("Dossier...");
+    folderLabel = new QLabel("Aucun dossier");
+    auto *outputButton = new QPushButton("Sortie...");
+    outputLabel = new QLabel("Sortie: dossier des images");
+    folderRow->addWidget(folderButton);
+    folderRow->addWidget(folderLabel, 1);
+    folderRow->addWidget(outputButton);
+    folderRow->addWidget(outputLabel);
+    layout->addLayout(folderRow);
+
+    model = new BatchModel(THUMBNAIL_EDGE, this);
+    view = new QListView();
+    view->setModel(model);
+    view->setItemDelegate(new BatchItemDelegate(view));
+    view->setViewMode(QListView::IconMode);
+    view->setMovement(QListView::Static);
+    view->setResizeMode(QListView::Adjust);
+    view->setUniformItemSizes(true);    // Layout without asking every item for its size
+    view->setIconSize(QSize(THUMBNAIL_EDGE, THUMBNAIL_EDGE));
+    view->setGridSize(QSize(THUMBNAIL_EDGE + 24, THUMBNAIL_EDGE + 36));
+    view->setSelectionMode(QAbstractItemView::ExtendedSelection);
+    view->setTextElideMode(Qt::ElideMiddle);
+    layout->addWidget(view, 1);
+
+    auto *actionRow = new QHBoxLayout();
+    processButton = new QPushButton("Traiter la sélection");
+    processButton->setToolTip("Applique le pipeline courant aux images sélectionnées");
+    stopButton = new QPushButton("Arrêter");
+    stopButton->setEnabled(false);
+    batchProgress = new QProgressBar();
+    batchProgress->setVisible(false);
+    summaryLabel = new QLabel();
+    actionRow->addWidget(processButton);
+    actionRow->addWidget(stopButton);
+    actionRow->addWidget(batchProgress, 1);
+    actionRow->addWidget(summaryLabel);
+    layout->addLayout(actionRow);
+
+    connect(folderButton, &QPushButton::clicked, this, &BatchPanel::onChooseFolder);
+    connect(outputButton, &QPushButton::clicked, this, &BatchPanel::onChooseOutput);
+    connect(processButton, &QPushButton::clicked, this, &BatchPanel::onProcessSelected);
+    connect(stopButton, &QPushButton::clicked, this, &BatchPanel::onStop);
+    connect(model, &BatchModel::thumbnailNeeded, this, &BatchPanel::requestThumbnail);
+    connect(view->verticalScrollBar(), &QScrollBar::valueChanged, this, &BatchPanel::onScrolled);
+    connect(view, &QListView::doubleClicked, this, [this](const QModelIndex &index) {
+        emit openRequested(model->path(index.row()));
+    });
+
+    // Old entries are never read again; keep the directory bounded
+    thumbnailPool.start([cache = diskCache] { cache->prune(DISK_CACHE_BYTES); });
+}
+
+BatchPanel::~BatchPanel() {
+    stop();
+}
+
+void BatchPanel::setPipelineSource(std::function<FilterPipeline()> source) {
+    pipelineSource = std::move(source);
+}
+
+void BatchPanel::setFolder(const QString &newFolder) {
+    if (isRunning()) {
+        // Running jobs report by row of the current listing
+        summaryLabel->setText("Traitement en cours");
+        return;
+    }
+    folder = newFolder;
+    ++folderRequest;
+    thumbnailPool.clear();
+
+    QStringList paths;
+    const QDir directory(folder);
+    for (const QFileInfo &info : directory.entryInfoList(IMAGE_PATTERNS, QDir::Files,
+                                                         QDir::Name | QDir::IgnoreCase)) {
+        paths.push_back(info.absoluteFilePath());
+    }
+    model->setFiles(paths);
+    folderLabel->setText(QDir::toNativeSeparators(folder) + " (" + QString::number(paths.size()) + " images)");
+    summaryLabel->clear();
+}
+
+void BatchPanel::stop() {
+    liveBatch = 0;
+    thumbnailPool.clear();
+    processingPool.waitForDone();
+    thumbnailPool.waitForDone();
+}
+
+void BatchPanel::onChooseFolder() {
+    const QString chosen = QFileDialog::getExistingDirectory(this, "Dossier d'images", folder);
+    if (!chosen.isEmpty()) {
+        setFolder(chosen);
+    }
+}
+
+void BatchPanel::onChooseOutput() {
+    const QString chosen = QFileDialog::getExistingDirectory(this, "Dossier de sortie",
+                                                             outputFolder.isEmpty() ? folder : outputFolder);
+    if (!chosen.isEmpty()) {
+        outputFolder = chosen;
+        outputLabel->setText("Sortie: " + QDir::toNativeSeparators(outputFolder));
+    }
+}
+
+void BatchPanel::onScrolled() {
+    // Queued decodes are for cells that may have left the screen; the
+    // repaint makes the visible ones ask again
+    thumbnailPool.clear();
+    model->clearPending();
+    view->viewport()->update();
+}
+
+void BatchPanel::requestThumbnail(int row) {
+    const QString path = model->path(row);
+    const quint64 request = folderRequest;
+
+    thumbnailPool.start([this, cache = diskCache, path, row, request] {
+        const std::string file = path.toStdString();
+        const int edge = cache->getThumbnailSize();
+        Image thumbnail;
+        if (!cache->load(file, thumbnail)) {
+            // Same reduced JPEG decode as MainWindow::loadImage; Qt does
+            // not read TGA, stb does
+            QImageReader reader(path);
+            const QSize size = reader.size();
+            if (reader.format() == "jpeg" && size.isValid() && std::max(size.width(), size.height()) > edge) {
+                reader.setScaledSize(size.scaled(edge * 2, edge * 2, Qt::KeepAspectRatio));
+            }
+            const QImage decoded = reader.read();
+            thumbnail = decoded.isNull() ? cache->makeThumbnail(file)
+                                         : ContactSheet::thumbnail(ImageViewport::fromQImage(decoded), edge, edge);
+            if (thumbnail.size() > 0) {
+                cache->store(file, thumbnail);
+            }
+        }
+        const QImage result = thumbnail.size() > 0 ? ImageViewport::toQImage(thumbnail) : QImage();
+        QMetaObject::invokeMethod(this, [this, request, row, result] {
+            thumbnailReady(request, row, result);
+        }, Qt::QueuedConnection);
+    });
+}
+
+void BatchPanel::thumbnailReady(quint64 request, int row, const QImage &thumbnail) {
+    if (request == folderRequest) {
+        model->setThumbnail(row, thumbnail);
+    }
+}
+
+void BatchPanel::onProcessSelected() {
+    QModelIndexList selected = view->selectionModel()->selectedIndexes();
+    if (selected.isEmpty()) {
+        summaryLabel->setText("Sélectionnez des images");
+        return;
+    }
+    const FilterPipeline pipeline = pipelineSource ? pipelineSource() : FilterPipeline();
+    if (pipeline.empty()) {
+        summaryLabel->setText("Le pipeline est vide");
+        return;
+    }
+    std::sort(selected.begin(), selected.end(),
+              [](const QModelIndex &a, const QModelIndex &b) { return a.row() < b.row(); });
+
+    const quint64 batch = ++batchRequest;
+    liveBatch = batch;
+    remaining = selected.size();
+    succeeded = 0;
+    failed = 0;
+    batchProgress->setRange(0, remaining);
+    batchProgress->setValue(0);
+    batchProgress->setVisible(true);
+    processButton->setEnabled(false);
+    stopButton->setEnabled(true);
+    updateSummary();
+
+    for (const QModelIndex &index : selected) {
+        const int row = index.row();
+        const QFileInfo input(model->path(row));
+        const QDir outputDirectory(outputFolder.isEmpty() ? input.absolutePath() : outputFolder);
+        const QString output = outputDirectory.filePath(input.completeBaseName() + "_batch." + input.suffix());
+        model->setStatus(row, BatchModel::Status::Queued);
+
+        // The lambda's copy of the pipeline is this image's own
+        processingPool.start([this, pipeline, batch, row, input = input.absoluteFilePath(), output] {
+            auto finish = [this, batch, row](BatchModel::Status status, const QString &message) {
+                QMetaObject::invokeMethod(this, [this, batch, row, status, message] {
+                    imageFinished(batch, row, status, message);
+                }, Qt::QueuedConnection);
+            };
+            if (liveBatch.load() != batch) {
+                finish(BatchModel::Status::Idle, QString());
+                return;
+            }
+            auto progress = [this, batch, row](int percent) {
+                QMetaObject::invokeMethod(this, [this, batch, row, percent] {
+                    imageProgress(batch, row, percent);
+                }, Qt::QueuedConnection);
+            };
+            progress(0);
+
+            Image image;
+            if (!image.loadFromFile(input.toStdString())) {
+                finish(BatchModel::Status::Failed, "Lecture impossible");
+                return;
+            }
+            try {
+                const Image result = pipeline.applyWithProgress(image, [&](float percent, const std::string &) {
+                    progress(static_cast<int>(percent));
+                });
+                if (!result.saveToFile(output.toStdString())) {
+                    finish(BatchModel::Status::Failed, "Écriture impossible: " + output);
+                    return;
+                }
+            } catch (const std::exception &e) {
+                finish(BatchModel::Status::Failed, QString::fromStdString(e.what()));
+                return;
+            }
+            finish(BatchModel::Status::Done, "→ " + output);
+        });
+    }
+}
+
+void BatchPanel::onStop() {
+    liveBatch = 0;
+    stopButton->setEnabled(false);
+    summaryLabel->setText("Arrêt après les images en cours...");
+}
+
+void BatchPanel::imageProgress(quint64 batch, int row, int percent) {
+    if (batch == batchRequest) {
+        model->setStatus(row, BatchModel::Status::Running, percent);
+    }
+}
+
+void BatchPanel::imageFinished(quint64 batch, int row, BatchModel::Status status, const QString &message) {
+    if (batch != batchRequest) {
+        return;
+    }
+    model->setStatus(row, status, status == BatchModel::Status::Done ? 100 : 0, message);
+    if (status == BatchModel::Status::Done) {
+        ++succeeded;
+    } else if (status == BatchModel::Status::Failed) {
+        ++failed;
+    }
+    --remaining;
+    batchProgress->setValue(batchProgress->maximum() - remaining);
+    updateSummary();
+
+    if (remaining == 0) {
+        liveBatch = 0;
+        processButton->setEnabled(true);
+        stopButton->setEnabled(false);
+        batchProgress->setVisible(false);
+        emit batchFinished(succeeded, failed);
+    }
+}
+
+void BatchPanel::updateSummary() {
+    QString text = QString::number(succeeded) + " traitée(s)";
+    if (failed > 0) {
+        text += ", " + QString::number(failed) + " échec(s)";
+    }
+    if (remaining > 0) {
+        text += ", " + QString::number(remaining) + " restante(s)";
+    }
+    summaryLabel->setText(text);
+}
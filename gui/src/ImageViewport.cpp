@@ -0,0 +1,447 @@
+/**
+ * @file ImageViewport.cpp
+ * @brief Tile drawing, zoom and pan handling of the image views
+ *
+ * @details
+ * Widget point p and source point s are related by
+ *   p = (s - center) × zoom + widgetCenter
+ * The pyramid level is the coarsest one still at least as detailed as the
+ * screen (TileCache::levelForZoom), so a zoomed-out view of a 24 MP photo
+ * only processes about a screenful of pixels. Tile (tx, ty) of level L
+ * covers source pixels [tx T 2^L, ...) and is drawn scaled by zoom × 2^L.
+ *
+ * Refinement requests carry an epoch; cancelling bumps the epoch and
+ * clears the pool's queue, and a job whose epoch is outdated returns
+ * without computing. Jobs and their repaint notifications only touch the
+ * viewport through queued calls, and the destructor waits for the pool.
+ * Jobs never touch the pipeline themselves: they go through
+ * TileCache::tile(), which runs each concurrent miss on a separate
+ * pipeline copy, like the coarse tiles computed while painting.
+ *
+ * @see ImageViewport.hpp for the interaction model
+ * @author Rowan HOUPA
+ * @date January 2026
+ */
+
+#include "ImageViewport.hpp"
+#include <QPainter>
+#include <QWheelEvent>
+#include <QMouseEvent>
+#include <QResizeEvent>
+#include <QMetaObject>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+    constexpr double MIN_ZOOM = 1.0 / 64.0;
+    constexpr double MAX_ZOOM = 32.0;
+    constexpr int PIXMAP_CACHE_KB = 128 * 1024;
+    constexpr int SETTLE_DELAY_MS = 150;
+    constexpr int COARSE_LEVELS = 2;    // Coarse stage: 2^-2 of the display resolution per axis
+    constexpr quint64 UNFILTERED_KEY = quint64(1) << 63;    // Pixmap of an unfiltered stand-in tile
+}
+
+ImageViewport::ImageViewport(QWidget *parent)
+    : QWidget(parent), pixmaps(PIXMAP_CACHE_KB) {
+    setMinimumSize(400, 300);
+    setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
+    setMouseTracking(false);
+    setToolTip("Molette: zoom, glisser: déplacer, double-clic: ajuster / 100%");
+
+    settleTimer.setSingleShot(true);
+    settleTimer.setInterval(SETTLE_DELAY_MS);
+    connect(&settleTimer, &QTimer::timeout, this, &ImageViewport::scheduleRefinement);
+    refinementPool.setMaxThreadCount(1);
+}
+
+ImageViewport::~ImageViewport() {
+    stopRendering();
+}
+
+void ImageViewport::setTileCache(TileCache *cache) {
+    stopRendering();
+    tileCache = cache;
+    refresh();
+}
+
+void ImageViewport::setPlaceholderText(const QString &text) {
+    placeholder = text;
+    update();
+}
+
+QRectF ImageViewport::visibleSourceRect() const {
+    const QPointF halfSize(width() / (2.0 * zoom), height() / (2.0 * zoom));
+    return QRectF(center - halfSize, center + halfSize);
+}
+
+QImage ImageViewport::toQImage(const Image &image) {
+    const int width = image.getWidth();
+    const int height = image.getHeight();
+    const uchar *data = image.data();
+
+    switch (image.getChannels()) {
+    case 1:
+        return QImage(data, width, height, width, QImage::Format_Grayscale8).copy();
+    case 3:
+        return QImage(data, width, height, width * 3, QImage::Format_RGB888).copy();
+    case 4:
+        return QImage(data, width, height, width * 4, QImage::Format_RGBA8888).copy();
+    case 2: {
+        QImage result(width, height, QImage::Format_RGBA8888);
+        for (int y = 0; y < height; ++y) {
+            const uchar *in = data + static_cast<size_t>(y) * width * 2;
+            uchar *out = result.scanLine(y);
+            for (int x = 0; x < width; ++x) {
+                out[4 * x] = out[4 * x + 1] = out[4 * x + 2] = in[2 * x];
+                out[4 * x + 3] = in[2 * x + 1];
+            }
+        }
+        return result;
+    }
+    default:
+        return QImage();
+    }
+}
+
+Image ImageViewport::fromQImage(const QImage &image) {
+    if (image.isNull()) {
+        return Image();
+    }
+    const bool alpha = image.hasAlphaChannel();
+    const bool gray = image.isGrayscale() && !alpha;
+    const int channels = gray ? 1 : (alpha ? 4 : 3);
+    const QImage converted = image.convertToFormat(
+        gray ? QImage::Format_Grayscale8 : (alpha ? QImage::Format_RGBA8888 : QImage::Format_RGB888));
+
+    Image result(converted.width(), converted.height(), channels);
+    const size_t rowBytes = static_cast<size_t>(converted.width()) * channels;
+    for (int y = 0; y < converted.height(); ++y) {
+        std::memcpy(result.data() + y * rowBytes, converted.constScanLine(y), rowBytes);
+    }
+    return result;
+}
+
+void ImageViewport::setView(double newZoom, const QPointF &newCenter) {
+    if (newZoom == zoom && newCenter == center) {
+        return;
+    }
+    zoom = newZoom;
+    center = newCenter;
+    cancelRefinement();
+    settleTimer.start();
+    update();
+}
+
+void ImageViewport::fitToWindow() {
+    if (!tileCache || !tileCache->hasSource()) {
+        return;
+    }
+    zoom = fitZoom();
+    center = QPointF(tileCache->getLevelWidth(0) / 2.0, tileCache->getLevelHeight(0) / 2.0);
+    fitted = true;
+    cancelRefinement();
+    settleTimer.start();
+    update();
+    emit viewChanged(zoom, center);
+}
+
+void ImageViewport::refresh() {
+    cancelRefinement();
+    pixmaps.clear();
+    settleTimer.start();
+    update();
+}
+
+void ImageViewport::stopRendering() {
+    settleTimer.stop();
+    cancelRefinement();
+    refinementPool.waitForDone();
+}
+
+void ImageViewport::cancelRefinement() {
+    ++refinementEpoch;
+    refinementPool.clear();
+}
+
+double ImageViewport::fitZoom() const {
+    const int sourceWidth = tileCache ? tileCache->getLevelWidth(0) : 0;
+    const int sourceHeight = tileCache ? tileCache->getLevelHeight(0) : 0;
+    if (sourceWidth == 0 || sourceHeight == 0) {
+        return 1.0;
+    }
+    return std::clamp(std::min(static_cast<double>(width()) / sourceWidth,
+                               static_cast<double>(height()) / sourceHeight), MIN_ZOOM, MAX_ZOOM);
+}
+
+void ImageViewport::applyView(double newZoom, const QPointF &newCenter) {
+    zoom = std::clamp(newZoom, MIN_ZOOM, MAX_ZOOM);
+    center = newCenter;
+    fitted = false;
+    cancelRefinement();
+    settleTimer.start();
+    update();
+    emit viewChanged(zoom, center);
+}
+
+std::vector<TileIndex> ImageViewport::previewTiles() const {
+    std::vector<TileIndex> result;
+    if (!tileCache || !tileCache->hasSource()) {
+        return result;
+    }
+    const int level = displayLevel();
+    for (int stage : {coarseLevel(), level}) {
+        const TileRange range = visibleTiles(stage);
+        for (int ty = range.ty0; ty <= range.ty1; ++ty) {
+            for (int tx = range.tx0; tx <= range.tx1; ++tx) {
+                result.push_back({stage, tx, ty});
+            }
+        }
+        if (stage == level) break;  // Coarse and display levels coincide
+    }
+    return result;
+}
+
+int ImageViewport::displayLevel() const {
+    return std::min(TileCache::levelForZoom(zoom), tileCache->getLevelCount() - 1);
+}
+
+int ImageViewport::coarseLevel() const {
+    return std::min(displayLevel() + COARSE_LEVELS, tileCache->getLevelCount() - 1);
+}
+
+ImageViewport::TileRange ImageViewport::visibleTiles(int level) const {
+    const int tileSize = tileCache->getTileSize();
+    const double tileSpan = tileSize * static_cast<double>(1 << level);
+    const QRectF visible = visibleSourceRect().intersected(
+        QRectF(0, 0, tileCache->getLevelWidth(0), tileCache->getLevelHeight(0)));
+    if (visible.isEmpty()) {
+        return {0, 0, -1, -1};
+    }
+    return {std::max(0, static_cast<int>(std::floor(visible.left() / tileSpan))),
+            std::max(0, static_cast<int>(std::floor(visible.top() / tileSpan))),
+            std::min((tileCache->getLevelWidth(level) - 1) / tileSize,
+                     static_cast<int>(std::ceil(visible.right() / tileSpan)) - 1),
+            std::min((tileCache->getLevelHeight(level) - 1) / tileSize,
+                     static_cast<int>(std::ceil(visible.bottom() / tileSpan)) - 1)};
+}
+
+const QPixmap *ImageViewport::tilePixmap(int level, int tx, int ty, bool compute, bool *unfiltered) {
+    quint64 pixmapKey = (static_cast<quint64>(level) << 48) | (static_cast<quint64>(tx) << 24) |
+                        static_cast<quint64>(ty);
+    if (QPixmap *cached = pixmaps.object(pixmapKey)) {
+        return cached;
+    }
+
+    std::shared_ptr<const Image> tile;
+    if (compute) {
+        try {
+            // Never the full-resolution run of a whole-image pipeline here:
+            // the refinement thread does it, the unfiltered level shows meanwhile
+            tile = tileCache->tile(level, tx, ty, false);
+            if (!tile) {
+                pixmapKey |= UNFILTERED_KEY;
+                if (unfiltered) *unfiltered = true;
+                if (QPixmap *cached = pixmaps.object(pixmapKey)) {
+                    return cached;
+                }
+                tile = tileCache->sourceTile(level, tx, ty);
+            }
+        } catch (const std::exception &e) {
+            // Report once per pipeline, not once per tile and repaint
+            if (failedGeneration != pixmapGeneration) {
+                failedGeneration = pixmapGeneration;
+                emit renderError(QString::fromStdString(e.what()));
+            }
+            return nullptr;
+        }
+    } else {
+        tile = tileCache->find(level, tx, ty);
+    }
+    if (!tile) {
+        return nullptr;
+    }
+
+    auto *pixmap = new QPixmap(QPixmap::fromImage(toQImage(*tile)));
+    const int cost = std::max(1, static_cast<int>(tile->getWidth() * tile->getHeight() * 4 / 1024));
+    pixmaps.insert(pixmapKey, pixmap, cost);
+    return pixmaps.object(pixmapKey);
+}
+
+bool ImageViewport::drawLevel(QPainter &painter, int level, bool compute, bool *unfiltered) {
+    const TileRange range = visibleTiles(level);
+    const double levelScale = static_cast<double>(1 << level);
+    const double tileSpan = tileCache->getTileSize() * levelScale;
+    const QPointF widgetCenter(width() / 2.0, height() / 2.0);
+
+    painter.setRenderHint(QPainter::SmoothPixmapTransform, zoom * levelScale < 1.0);
+    for (int ty = range.ty0; ty <= range.ty1; ++ty) {
+        for (int tx = range.tx0; tx <= range.tx1; ++tx) {
+            const QPixmap *pixmap = tilePixmap(level, tx, ty, compute, unfiltered);
+            if (!pixmap) {
+                if (compute) return false;
+                continue;
+            }
+            const QPointF sourceTopLeft(tx * tileSpan, ty * tileSpan);
+            const QRectF target((sourceTopLeft - center) * zoom + widgetCenter,
+                                QSizeF(pixmap->width(), pixmap->height()) * (levelScale * zoom));
+            if (!compute) {
+                // Hide the coarser tile below (it would show through alpha)
+                painter.fillRect(target, QColor(0x2d, 0x2d, 0x2d));
+            }
+            painter.drawPixmap(target, *pixmap, QRectF(pixmap->rect()));
+        }
+    }
+    return true;
+}
+
+void ImageViewport::paintEvent(QPaintEvent *event) {
+    Q_UNUSED(event);
+    QPainter painter(this);
+    painter.fillRect(rect(), QColor(0x2d, 0x2d, 0x2d));
+
+    if (!tileCache || !tileCache->hasSource()) {
+        painter.setPen(QColor(0x88, 0x88, 0x88));
+        painter.drawText(rect(), Qt::AlignCenter, placeholder);
+        return;
+    }
+
+    const uint64_t generation = tileCache->getGeneration();
+    if (generation != pixmapGeneration) {
+        pixmaps.clear();
+        pixmapGeneration = generation;
+    }
+
+    // Stage 1 (always available), then whatever finer tiles are cached
+    const int coarse = coarseLevel();
+    bool unfiltered = false;
+    if (!drawLevel(painter, coarse, true, &unfiltered)) {
+        return;
+    }
+    for (int level = coarse - 1; level >= 0; --level) {
+        drawLevel(painter, level, false);
+    }
+    if (!unfiltered) {
+        emit framePresented();
+    }
+}
+
+void ImageViewport::scheduleRefinement() {
+    if (!tileCache || !tileCache->hasSource()) {
+        return;
+    }
+    cancelRefinement();
+
+    // Stage 2 (display level), then stage 3 (full resolution); cached tiles
+    // skipped. Coarse tiles are only missing for whole-image pipelines, whose
+    // full-resolution run painting leaves to this thread: they go first.
+    struct Job { int level, tx, ty; };
+    std::vector<Job> jobs;
+    std::vector<int> stages{coarseLevel(), displayLevel()};
+    if (stages.back() == stages.front()) {
+        stages.pop_back();
+    }
+    if (stages.back() > 0) {
+        stages.push_back(0);
+    }
+    for (int level : stages) {
+        const TileRange range = visibleTiles(level);
+        for (int ty = range.ty0; ty <= range.ty1; ++ty) {
+            for (int tx = range.tx0; tx <= range.tx1; ++tx) {
+                if (!tileCache->find(level, tx, ty)) {
+                    jobs.push_back({level, tx, ty});
+                }
+            }
+        }
+    }
+    if (jobs.empty()) {
+        emit refinementIdle();
+        return;
+    }
+
+    const uint64_t epoch = refinementEpoch.load();
+    const int total = static_cast<int>(jobs.size());
+    TileCache *cache = tileCache;
+    for (int i = 0; i < total; ++i) {
+        const Job job = jobs[i];
+        refinementPool.start([this, cache, job, epoch, i, total] {
+            if (refinementEpoch.load() != epoch) {
+                return;
+            }
+            try {
+                cache->tile(job.level, job.tx, job.ty);
+            } catch (const std::exception &) {
+                return;     // Reported by the coarse stage
+            }
+            QMetaObject::invokeMethod(this, [this, epoch, i, total] {
+                if (refinementEpoch.load() == epoch) {
+                    update();
+                    emit refinementProgress(i + 1, total);
+                    if (i + 1 == total) {
+                        emit refinementIdle();
+                    }
+                }
+            }, Qt::QueuedConnection);
+        });
+    }
+}
+
+void ImageViewport::wheelEvent(QWheelEvent *event) {
+    if (!tileCache || !tileCache->hasSource()) {
+        return;
+    }
+    const double steps = event->angleDelta().y() / 120.0;
+    const double newZoom = std::clamp(zoom * std::pow(1.25, steps), MIN_ZOOM, MAX_ZOOM);
+
+    // Keep the source point under the cursor in place
+    const QPointF offset = event->position() - QPointF(width() / 2.0, height() / 2.0);
+    const QPointF anchor = center + offset / zoom;
+    applyView(newZoom, anchor - offset / newZoom);
+    event->accept();
+}
+
+void ImageViewport::mousePressEvent(QMouseEvent *event) {
+    if (event->button() == Qt::LeftButton) {
+        dragging = true;
+        lastMousePosition = event->position();
+        setCursor(Qt::ClosedHandCursor);
+    }
+}
+
+void ImageViewport::mouseMoveEvent(QMouseEvent *event) {
+    if (!dragging) {
+        return;
+    }
+    const QPointF delta = event->position() - lastMousePosition;
+    lastMousePosition = event->position();
+    applyView(zoom, center - delta / zoom);
+}
+
+void ImageViewport::mouseReleaseEvent(QMouseEvent *event) {
+    if (event->button() == Qt::LeftButton) {
+        dragging = false;
+        unsetCursor();
+    }
+}
+
+void ImageViewport::mouseDoubleClickEvent(QMouseEvent *event) {
+    if (!tileCache || !tileCache->hasSource()) {
+        return;
+    }
+    if (std::abs(zoom - 1.0) < 1e-9) {
+        fitToWindow();
+    } else {
+        const QPointF offset = event->position() - QPointF(width() / 2.0, height() / 2.0);
+        applyView(1.0, center + offset / zoom);
+    }
+}
+
+void ImageViewport::resizeEvent(QResizeEvent *event) {
+    QWidget::resizeEvent(event);
+    if (fitted && tileCache && tileCache->hasSource()) {
+        zoom = fitZoom();
+        center = QPointF(tileCache->getLevelWidth(0) / 2.0, tileCache->getLevelHeight(0) / 2.0);
+    }
+    cancelRefinement();
+    settleTimer.start();
+}
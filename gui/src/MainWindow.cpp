@@ -4,15 +4,21 @@
  *
  * This file implements all GUI functionality including:
  * - Window setup and layout construction
- * - Image loading/saving with Qt file dialogs
- * - Filter pipeline management (add, remove, reorder)
- * - Real-time preview with timer-based debouncing
+ * - Image loading/saving with Qt file dialogs, decoded and encoded on
+ *   background threads (reduced JPEG preview first, progress in the status bar)
+ * - Filter pipeline management (add, remove, reorder) with undo/redo
+ * - Real-time preview with timer-based debouncing, limited to the visible
+ *   tiles of the processed view at its zoom level (TileCache)
  * - CPU/GPU processing mode selection
+ * - Performance HUD: the pipeline gets a fresh PipelineProfile on every
+ *   edit; preview latency runs from the oldest edit not yet shown to the
+ *   first repaint with its pipeline, then to the end of the refinement
  *
  * @details
  * Event Handling:
  * - Uses Qt's signal/slot mechanism (SIGNAL/SLOT macros for Qt5 compat)
- * - Preview timer prevents excessive reprocessing during slider moves
+ * - Preview timer coalesces the edits of one event-loop pass; the
+ *   processed view refines progressively (coarse, display, full resolution)
  * - Progress callback updates QProgressBar during pipeline execution
  *
  * Filter Integration:
@@ -20,10 +26,14 @@
  * - Builds filter menu at runtime (no hardcoded filter list)
  * - Only brightness/blur have parameter UI (design choice)
  *
- * Image Conversion:
- * - imageToPixmap(): Converts Image class to Qt's QPixmap
- * - Handles both RGB (3 channel) and grayscale (1 channel)
- * - Scales to 400x300 for display while preserving aspect ratio
+ * Image Display:
+ * - Two ImageViewports (original / processed) with synchronized zoom and pan
+ * - Preview: the processed TileCache receives a copy of the pipeline and the
+ *   view recomputes only the tiles it shows; panning reuses cached tiles
+ * - Apply (and Save of an out-of-date result) runs the full-resolution
+ *   pipeline with progress, starting from the closest result the edit
+ *   history still holds (EditHistory::replayBase); the result becomes a
+ *   history snapshot
  *
  * @see MainWindow.hpp for class declaration
  * @author Rowan HOUPA
@@ -50,6 +60,15 @@
 #include <QFrame>
 #include <QCheckBox>
 #include <QDebug>
+#include <QInputDialog>
+#include <QSignalBlocker>
+#include <QImageReader>
+#include <QMetaObject>
+#include <algorithm>
+
+namespace {
+    constexpr int LOAD_PREVIEW_EDGE = 1600;    // Longest side of the reduced decode shown while opening
+}
 
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent) {
@@ -58,21 +77,32 @@ MainWindow::MainWindow(QWidget *parent)
     setMinimumSize(1200, 700);
     
     createActions();
+    createBatchPanel();
     createMenus();
     createToolbars();
     createStatusBar();
     createCentralWidget();
     
+    // Coalesces the edits of one event-loop pass; the view itself shows a
+    // coarse preview at once and debounces the finer refinement stages
     previewTimer.setSingleShot(true);
-    previewTimer.setInterval(100);
+    previewTimer.setInterval(0);
     connect(&previewTimer, SIGNAL(timeout()), this, SLOT(updatePreview()));
     
+    // One open and one save may run at the same time
+    ioPool.setMaxThreadCount(2);
+    
     showStatusMessage("Prêt. Chargez une image pour commencer.");
     
     qDebug() << "MainWindow créée avec succès";
 }
 
 MainWindow::~MainWindow() {
+    // Background refinements use the tile caches, which are destroyed first
+    originalView->stopRendering();
+    processedView->stopRendering();
+    speculator.stop();
+    ioPool.waitForDone();
     qDebug() << "MainWindow détruite";
 }
 
@@ -96,6 +126,24 @@ void MainWindow::createActions() {
     fileExitAction->setStatusTip("Quitter l'application");
     connect(fileExitAction, SIGNAL(triggered()), this, SLOT(onFileExit()));
 
+    editUndoAction = new QAction("&Annuler", this);
+    editUndoAction->setShortcut(QKeySequence::Undo);
+    editUndoAction->setStatusTip("Annuler la dernière modification du pipeline");
+    editUndoAction->setEnabled(false);
+    connect(editUndoAction, SIGNAL(triggered()), this, SLOT(onUndo()));
+
+    editRedoAction = new QAction("&Rétablir", this);
+    editRedoAction->setShortcut(QKeySequence::Redo);
+    editRedoAction->setStatusTip("Rétablir la modification annulée");
+    editRedoAction->setEnabled(false);
+    connect(editRedoAction, SIGNAL(triggered()), this, SLOT(onRedo()));
+
+    viewPerformanceAction = new QAction("&Performances", this);
+    viewPerformanceAction->setShortcut(QKeySequence(Qt::Key_F12));
+    viewPerformanceAction->setStatusTip("Afficher les temps par filtre, la latence de l'aperçu et la mémoire");
+    viewPerformanceAction->setCheckable(true);
+    connect(viewPerformanceAction, &QAction::toggled, this, &MainWindow::onPerformanceHudToggle);
+
     helpAboutAction = new QAction("&À propos", this);
     connect(helpAboutAction, SIGNAL(triggered()), this, SLOT(onAbout()));
 
@@ -110,8 +158,17 @@ void MainWindow::createMenus() {
     fileMenu->addAction(fileOpenAction);
     fileMenu->addAction(fileSaveAction);
     fileMenu->addSeparator();
+    fileMenu->addAction(batchDock->toggleViewAction());
+    fileMenu->addSeparator();
     fileMenu->addAction(fileExitAction);
 
+    QMenu *editMenu = menuBar()->addMenu("É&dition");
+    editMenu->addAction(editUndoAction);
+    editMenu->addAction(editRedoAction);
+
+    QMenu *viewMenu = menuBar()->addMenu("&Affichage");
+    viewMenu->addAction(viewPerformanceAction);
+
     QMenu *helpMenu = menuBar()->addMenu("&Aide");
     helpMenu->addAction(helpAboutAction);
     helpMenu->addAction(helpAboutQtAction);
@@ -123,10 +180,46 @@ void MainWindow::createToolbars() {
     QToolBar *toolbar = addToolBar("Principal");
     toolbar->addAction(fileOpenAction);
     toolbar->addAction(fileSaveAction);
+    toolbar->addSeparator();
+    toolbar->addAction(editUndoAction);
+    toolbar->addAction(editRedoAction);
+}
+
+void MainWindow::createBatchPanel() {
+    batchDock = new QDockWidget("Traitement par lot", this);
+    batchDock->setObjectName("batchDock");
+    batchPanel = new BatchPanel(batchDock);
+    batchDock->setWidget(batchPanel);
+    addDockWidget(Qt::BottomDockWidgetArea, batchDock);
+    batchDock->hide();
+    
+    QAction *toggle = batchDock->toggleViewAction();
+    toggle->setText("&Traitement par lot");
+    toggle->setShortcut(QKeySequence("Ctrl+B"));
+    toggle->setStatusTip("Appliquer le pipeline à un dossier d'images");
+    
+    // Each batch takes a copy of the pipeline as it is when started; the
+    // HUD profiles the editor only
+    batchPanel->setPipelineSource([this] {
+        FilterPipeline copy = pipeline;
+        copy.setProfile(nullptr);
+        return copy;
+    });
+    connect(batchPanel, &BatchPanel::openRequested, this, [this](const QString &path) { loadImage(path); });
+    connect(batchPanel, &BatchPanel::batchFinished, this, [this](int succeeded, int failed) {
+        showStatusMessage("Lot terminé: " + QString::number(succeeded) + " image(s) traitée(s), " +
+                          QString::number(failed) + " échec(s)");
+    });
 }
 
 void MainWindow::createStatusBar() {
     statusBar()->showMessage("Prêt");
+    
+    // Background open/save
+    ioProgressBar = new QProgressBar();
+    ioProgressBar->setMaximumWidth(160);
+    ioProgressBar->setVisible(false);
+    statusBar()->addPermanentWidget(ioProgressBar);
 }
 
 void MainWindow::createCentralWidget() {
@@ -145,28 +238,49 @@ void MainWindow::createImagePanel() {
     
     // Image originale
     QLabel *originalTitle = new QLabel("Image Originale:");
-    originalImageLabel = new QLabel();
-    originalImageLabel->setAlignment(Qt::AlignCenter);
-    originalImageLabel->setMinimumSize(400, 300);
-    originalImageLabel->setFrameStyle(QFrame::Box);
-    originalImageLabel->setText("Aucune image chargée");
-    originalImageLabel->setStyleSheet("QLabel { background-color: #2d2d2d; color: #888; }");
+    originalView = new ImageViewport();
+    originalView->setPlaceholderText("Aucune image chargée");
+    originalView->setTileCache(&originalTiles);
     
     // Image traitée
     QLabel *processedTitle = new QLabel("Image Traitée:");
-    processedImageLabel = new QLabel();
-    processedImageLabel->setAlignment(Qt::AlignCenter);
-    processedImageLabel->setMinimumSize(400, 300);
-    processedImageLabel->setFrameStyle(QFrame::Box);
-    processedImageLabel->setText("Chargez une image pour commencer");
-    processedImageLabel->setStyleSheet("QLabel { background-color: #2d2d2d; color: #888; }");
+    processedView = new ImageViewport();
+    processedView->setPlaceholderText("Chargez une image pour commencer");
+    processedView->setTileCache(&processedTiles);
+    
+    // Same zoom and position in both views
+    connect(originalView, &ImageViewport::viewChanged, processedView, &ImageViewport::setView);
+    connect(processedView, &ImageViewport::viewChanged, originalView, &ImageViewport::setView);
+    connect(processedView, &ImageViewport::renderError, this, &MainWindow::onRenderError);
+    // Speculate only when the view is done, stop as soon as it has work again
+    connect(processedView, &ImageViewport::refinementIdle, this, &MainWindow::speculateNeighbours);
+    connect(originalView, &ImageViewport::viewChanged, &speculator, [this] { speculator.cancel(); });
+    connect(processedView, &ImageViewport::viewChanged, &speculator, [this] { speculator.cancel(); });
+    connect(processedView, &ImageViewport::framePresented, this, &MainWindow::onFramePresented);
+    connect(processedView, &ImageViewport::refinementIdle, this, &MainWindow::onPreviewComplete);
+    connect(processedView, &ImageViewport::refinementProgress, this, [this](int done, int total) {
+        showStatusMessage(done < total ? "Affinage de l'aperçu: " + QString::number(done) + "/" +
+                                             QString::number(total) + " tuiles"
+                                       : "Aperçu à pleine résolution", 2000);
+    });
+    
+    performanceHud = new PerformanceHud(processedView);
+    performanceHud->hide();
+    performanceHud->setMemoryProbe([this] {
+        const EditHistory::Stats historyStats = history.getStats();
+        return std::vector<std::pair<QString, size_t>>{
+            {"tuiles", originalTiles.getStats().bytes + processedTiles.getStats().bytes},
+            {"historique", historyStats.snapshotBytes + historyStats.diffBytes},
+            {"images", (originalImage ? originalImage->size() : 0) + processedImage.size()},
+        };
+    });
+    resetProfile();
     
     imageLayout->addWidget(originalTitle);
-    imageLayout->addWidget(originalImageLabel);
-    imageLayout->addSpacing(20);
+    imageLayout->addWidget(originalView, 1);
+    imageLayout->addSpacing(10);
     imageLayout->addWidget(processedTitle);
-    imageLayout->addWidget(processedImageLabel);
-    imageLayout->addStretch();
+    imageLayout->addWidget(processedView, 1);
     
     mainLayout->addWidget(imageGroup, 2);
 }
@@ -289,20 +403,28 @@ void MainWindow::onFileSave() {
     qDebug() << "onFileSave CALLED!";
     qDebug() << "Processed image width:" << processedImage.getWidth();
     qDebug() << "Processed image height:" << processedImage.getHeight();
+    qDebug() << "Processed image stale:" << processedStale;
     qDebug() << "Save button enabled:" << fileSaveAction->isEnabled();
     qDebug() << "========================================";
 
-    if (processedImage.getWidth() == 0) {
+    if (!hasImage() || pipeline.empty()) {
         qDebug() << "ERROR: No processed image to save!";
         QMessageBox::critical(this, "Erreur de Sauvegarde",
                             "Aucune image traitée à sauvegarder.\n\n"
                             "Veuillez:\n"
                             "1. Charger une image\n"
-                            "2. Ajouter des filtres\n"
-                            "3. Cliquer sur 'Appliquer le Pipeline'");
+                            "2. Ajouter des filtres");
         return;
     }
 
+    // The preview only covers what was displayed: process the full image now
+    if (processedStale) {
+        applyFilters(false);
+        if (processedStale) {
+            return;
+        }
+    }
+
     QString filepath = QFileDialog::getSaveFileName(
         this,
         "Enregistrer l'Image Traitée",
@@ -314,8 +436,8 @@ void MainWindow::onFileSave() {
 
     if (!filepath.isEmpty()) {
         qDebug() << "Attempting to save...";
-        bool success = saveImage(filepath);
-        qDebug() << "Save result:" << (success ? "SUCCESS" : "FAILED");
+        bool started = saveImage(filepath);
+        qDebug() << "Save started:" << (started ? "YES" : "NO");
     } else {
         qDebug() << "Save cancelled by user";
     }
@@ -384,21 +506,61 @@ void MainWindow::onAddFilter() {
         if (brightnessPtr) {
             brightnessFilter = brightnessPtr;
         }
-    } else if (filterId == "boxblur" && !gpuEnabled) {
-        BoxBlurFilter* blurPtr = dynamic_cast<BoxBlurFilter*>(filter.get());
-        if (blurPtr) {
-            blurFilter = blurPtr;
+    } else if (filterId == "boxblur") {
+        // CPU or GPU version, the radius control drives both
+        if (dynamic_cast<BoxBlurRadius*>(filter.get())) {
+            blurFilter = filter.get();
+        }
+    } else if (filterId == "blend") {
+        BlendFilter* blendPtr = dynamic_cast<BlendFilter*>(filter.get());
+        QString overlayPath = QFileDialog::getOpenFileName(
+            this,
+            "Image à Superposer",
+            QFileInfo(currentImagePath).absolutePath(),
+            "Fichiers Image (*.png *.jpg *.jpeg *.bmp *.tga)"
+        );
+        if (overlayPath.isEmpty()) {
+            return;
+        }
+        if (blendPtr) {
+            // Cached: adding the same watermark again does not decode it twice
+            auto overlay = BlendFilter::loadOverlayCached(overlayPath.toStdString());
+            if (!overlay) {
+                showErrorMessage("Erreur de Chargement", "Impossible de charger l'image: " + overlayPath);
+                return;
+            }
+            blendPtr->setOverlay(overlay);
+        }
+    } else if (filterId == "rotate") {
+        WarpFilter* warpPtr = dynamic_cast<WarpFilter*>(filter.get());
+        bool ok = false;
+        double angle = QInputDialog::getDouble(this, "Rotation", "Angle (degrés, sens horaire):",
+                                               0.0, -360.0, 360.0, 2, &ok);
+        if (!ok) {
+            return;
+        }
+        if (warpPtr) {
+            warpPtr->setAngle(angle);
+        }
+    } else if (filterId == "threshold") {
+        ThresholdFilter* thresholdPtr = dynamic_cast<ThresholdFilter*>(filter.get());
+        bool ok = false;
+        int value = QInputDialog::getInt(this, "Seuil", "Seuil (0-255):", 128, 0, 255, 1, &ok);
+        if (!ok) {
+            return;
+        }
+        if (thresholdPtr) {
+            thresholdPtr->setThreshold(value);
         }
     }
 
     qDebug() << "Filtre ajouté:" << QString::fromStdString(filter->getName());
 
+    const QString filterName = QString::fromStdString(filter->getName());
     pipeline.addFilter(std::move(filter));
     updateFilterList();
-
-    if (previewEnabled) {
-        previewTimer.start();
-    }
+    recordEdit(pipeline.size() - 1, 0, 1, "ajout de " + filterName);
+    pipelineChanged();
 }
 
 void MainWindow::onRemoveFilter() {
@@ -407,13 +569,13 @@ void MainWindow::onRemoveFilter() {
         Filter* filter = pipeline.getFilter(index);
         if (filter == brightnessFilter) brightnessFilter = nullptr;
         if (filter == blurFilter) blurFilter = nullptr;
+        const QString filterName = QString::fromStdString(filter->getName());
         
         pipeline.removeFilter(index);
         updateFilterList();
+        recordEdit(index, 1, 0, "retrait de " + filterName);
         
-        if (previewEnabled) {
-            previewTimer.start();
-        }
+        pipelineChanged();
     }
 }
 
@@ -423,10 +585,9 @@ void MainWindow::onMoveFilterUp() {
         pipeline.moveFilterUp(index);
         updateFilterList();
         filterListWidget->setCurrentRow(index - 1);
+        recordEdit(index - 1, 2, 2, "déplacement");
         
-        if (previewEnabled) {
-            previewTimer.start();
-        }
+        pipelineChanged();
     }
 }
 
@@ -436,10 +597,9 @@ void MainWindow::onMoveFilterDown() {
         pipeline.moveFilterDown(index);
         updateFilterList();
         filterListWidget->setCurrentRow(index + 1);
+        recordEdit(index, 2, 2, "déplacement");
         
-        if (previewEnabled) {
-            previewTimer.start();
-        }
+        pipelineChanged();
     }
 }
 
@@ -447,11 +607,13 @@ void MainWindow::onClearPipeline() {
     if (QMessageBox::question(this, "Effacer le Pipeline",
                               "Voulez-vous vraiment effacer tous les filtres ?",
                               QMessageBox::Yes | QMessageBox::No) == QMessageBox::Yes) {
+        const size_t removed = pipeline.size();
         pipeline.clear();
         brightnessFilter = nullptr;
         blurFilter = nullptr;
         updateFilterList();
-        updateImageDisplays();
+        recordEdit(0, removed, 0, "effacement du pipeline");
+        pipelineChanged();
     }
 }
 
@@ -460,19 +622,19 @@ void MainWindow::onFilterSelected(int index) {
         Filter* filter = pipeline.getFilter(index);
         
         brightnessSlider->setEnabled(dynamic_cast<BrightnessFilter*>(filter) != nullptr);
-        blurRadiusSpinBox->setEnabled(dynamic_cast<BoxBlurFilter*>(filter) != nullptr);
+        blurRadiusSpinBox->setEnabled(dynamic_cast<BoxBlurRadius*>(filter) != nullptr);
     }
 }
 
 void MainWindow::onApplyPipeline() {
     qDebug() << "========================================";
     qDebug() << "onApplyPipeline CALLED!";
-    qDebug() << "Image width:" << originalImage.getWidth();
+    qDebug() << "Image loaded:" << hasImage();
     qDebug() << "Pipeline size:" << pipeline.size();
     qDebug() << "Button enabled:" << applyButton->isEnabled();
     qDebug() << "========================================";
 
-    if (originalImage.getWidth() == 0) {
+    if (!hasImage()) {
         qDebug() << "No image loaded!";
         QMessageBox::warning(this, "Aucune image",
                            "Veuillez d'abord charger une image avant d'appliquer des filtres.");
@@ -494,7 +656,7 @@ void MainWindow::onApplyPipeline() {
 
 void MainWindow::onPreviewToggle(bool enabled) {
     previewEnabled = enabled;
-    if (enabled && !pipeline.empty()) {
+    if (enabled) {
         previewTimer.start();
     }
 }
@@ -516,18 +678,38 @@ void MainWindow::onGPUToggle(bool enabled) {
 void MainWindow::onBrightnessChanged(int value) {
     if (brightnessFilter) {
         brightnessFilter->setBrightness(value / 100.0f);
-        if (previewEnabled) {
-            previewTimer.start();
-        }
+        parameterChanged("brightness", value);
+        recordEdit(filterIndex(brightnessFilter), 1, 1, "luminosité", "brightness");
     }
 }
 
 void MainWindow::onBlurRadiusChanged(int value) {
-    if (blurFilter) {
-        blurFilter->setRadius(value);
-        if (previewEnabled) {
-            previewTimer.start();
-        }
+    if (auto *radius = dynamic_cast<BoxBlurRadius*>(blurFilter)) {
+        radius->setRadius(value);
+        parameterChanged("blur", value);
+        recordEdit(filterIndex(blurFilter), 1, 1, "rayon du flou", "blur");
+    }
+}
+
+void MainWindow::onUndo() {
+    if (isProcessing || loading) {
+        return;     // The pipeline is being applied, or the image replaced
+    }
+    const QString label = QString::fromStdString(history.undoLabel());
+    if (history.undo()) {
+        restoreHistoryState();
+        showStatusMessage("Annulé: " + label);
+    }
+}
+
+void MainWindow::onRedo() {
+    if (isProcessing || loading) {
+        return;     // The pipeline is being applied, or the image replaced
+    }
+    const QString label = QString::fromStdString(history.redoLabel());
+    if (history.redo()) {
+        restoreHistoryState();
+        showStatusMessage("Rétabli: " + label);
     }
 }
 
@@ -548,12 +730,92 @@ void MainWindow::onAboutQt() {
 
 bool MainWindow::loadImage(const QString &filepath) {
     qDebug() << "Chargement de l'image:" << filepath;
-    showStatusMessage("Chargement de l'image...");
+    if (isProcessing) {
+        // The pipeline being applied still reads the current image
+        showStatusMessage("Traitement en cours, réessayez après");
+        return false;
+    }
+    showStatusMessage("Chargement de l'image...", 0);
+    
+    // A newer open supersedes this one: its results are dropped on arrival
+    const quint64 request = ++loadRequest;
+    loading = true;
+    setControlsEnabled(false);
+    fileSaveAction->setEnabled(false);
+    editUndoAction->setEnabled(false);
+    editRedoAction->setEnabled(false);
+    updateIoProgress(0);
+    
+    ioPool.start([this, filepath, request] {
+        // 1. Reduced decode for an immediate preview. Only JPEG decodes
+        //    faster at a reduced size (libjpeg scales in the DCT); other
+        //    formats would be decoded twice.
+        QImageReader reader(filepath);
+        const QSize fullSize = reader.size();
+        if (reader.format() == "jpeg" && fullSize.isValid() &&
+            std::max(fullSize.width(), fullSize.height()) > LOAD_PREVIEW_EDGE) {
+            reader.setScaledSize(fullSize.scaled(LOAD_PREVIEW_EDGE, LOAD_PREVIEW_EDGE, Qt::KeepAspectRatio));
+            const QImage reduced = reader.read();
+            if (!reduced.isNull()) {
+                auto preview = std::make_shared<const Image>(ImageViewport::fromQImage(reduced));
+                QMetaObject::invokeMethod(this, [this, request, preview, fullSize] {
+                    showLoadPreview(request, preview, fullSize);
+                }, Qt::QueuedConnection);
+            }
+        }
+        
+        // 2. Full decode, reporting how much of the file was consumed
+        auto image = std::make_shared<Image>();
+        const bool ok = image->loadFromFile(filepath.toStdString(), [this, request](int percent) {
+            QMetaObject::invokeMethod(this, [this, request, percent] {
+                if (request == loadRequest) {
+                    updateIoProgress(percent);
+                }
+            }, Qt::QueuedConnection);
+        });
+        QMetaObject::invokeMethod(this, [this, request, filepath, image, ok] {
+            finishLoading(request, filepath, ok ? image : nullptr);
+        }, Qt::QueuedConnection);
+    });
+    return true;
+}
+
+void MainWindow::showLoadPreview(quint64 request, std::shared_ptr<const Image> preview, const QSize &fullSize) {
+    if (request != loadRequest || !loading) {
+        return;
+    }
+    // Both views show the reduced image without filters until the full decode
+    speculator.invalidate();
+    speculatedControl.clear();
+    originalTiles.setSource(preview);
+    processedTiles.setSource(preview);
+    processedTiles.setPipeline(FilterPipeline());
+    updateImageDisplays();
+    originalView->fitToWindow();
     
-    Image newImage;
-    if (!newImage.loadFromFile(filepath.toStdString())) {
+    showStatusMessage("Aperçu réduit (" + QString::number(fullSize.width()) + "x" +
+                      QString::number(fullSize.height()) + "), décodage complet en cours...", 0);
+}
+
+void MainWindow::finishLoading(quint64 request, const QString &filepath, std::shared_ptr<Image> newImage) {
+    if (request != loadRequest) {
+        return;
+    }
+    loading = false;
+    updateIoProgress();
+    
+    if (!newImage) {
+        // Back to the previous image, if any
+        originalTiles.setSource(originalImage);
+        processedTiles.setSource(originalImage);
+        processedTiles.setPipeline(pipeline);
+        setControlsEnabled(hasImage());
+        fileSaveAction->setEnabled(hasImage());
+        updateHistoryActions();
+        updateImageDisplays();
+        originalView->fitToWindow();
         showErrorMessage("Erreur de Chargement", "Impossible de charger l'image: " + filepath);
-        return false;
+        return;
     }
     
     originalImage = std::move(newImage);
@@ -563,6 +825,17 @@ bool MainWindow::loadImage(const QString &filepath) {
     pipeline.clear();
     brightnessFilter = nullptr;
     blurFilter = nullptr;
+    processedImage = Image();
+    processedStale = true;
+    speculator.invalidate();
+    speculatedControl.clear();
+    history.reset(originalImage, pipeline);
+    updateHistoryActions();
+    
+    // Both views share the image; the processed one starts with an empty pipeline
+    originalTiles.setSource(originalImage);
+    processedTiles.setSource(originalImage);
+    processedTiles.setPipeline(pipeline);
     
     // Enable controls
     setControlsEnabled(true);
@@ -570,13 +843,13 @@ bool MainWindow::loadImage(const QString &filepath) {
     
     updateImageDisplays();
     updateFilterList();
+    originalView->fitToWindow();
     
     showStatusMessage("Chargé: " + QFileInfo(filepath).fileName() +
-                     " (" + QString::number(originalImage.getWidth()) + "x" +
-                     QString::number(originalImage.getHeight()) + ")");
+                     " (" + QString::number(originalImage->getWidth()) + "x" +
+                     QString::number(originalImage->getHeight()) + ")");
     
     qDebug() << "Image chargée avec succès";
-    return true;
 }
 
 bool MainWindow::saveImage(const QString &filepath) {
@@ -585,31 +858,43 @@ bool MainWindow::saveImage(const QString &filepath) {
         return false;
     }
     
-    showStatusMessage("Enregistrement de l'image...");
+    // The worker encodes its own copy: editing and applying go on meanwhile
+    auto snapshot = std::make_shared<const Image>(processedImage);
+    ++pendingSaves;
+    updateIoProgress();
+    showStatusMessage("Enregistrement de " + QFileInfo(filepath).fileName() + "...", 0);
     
-    if (!processedImage.saveToFile(filepath.toStdString())) {
-        showErrorMessage("Erreur de Sauvegarde", "Impossible d'enregistrer l'image: " + filepath);
-        return false;
-    }
-    
-    showStatusMessage("Enregistré: " + QFileInfo(filepath).fileName());
+    ioPool.start([this, snapshot, filepath] {
+        const bool ok = snapshot->saveToFile(filepath.toStdString());
+        QMetaObject::invokeMethod(this, [this, filepath, ok] {
+            --pendingSaves;
+            updateIoProgress();
+            if (ok) {
+                showStatusMessage("Enregistré: " + QFileInfo(filepath).fileName());
+            } else {
+                showErrorMessage("Erreur de Sauvegarde", "Impossible d'enregistrer l'image: " + filepath);
+            }
+        }, Qt::QueuedConnection);
+    });
     return true;
 }
 
-void MainWindow::updateImageDisplays() {
-    if (originalImage.getWidth() == 0) {
-        originalImageLabel->setText("Aucune image chargée");
-        processedImageLabel->setText("Chargez une image pour commencer");
-        return;
-    }
-    
-    originalImageLabel->setPixmap(imageToPixmap(originalImage));
-    
-    if (processedImage.getWidth() > 0) {
-        processedImageLabel->setPixmap(imageToPixmap(processedImage));
+void MainWindow::updateIoProgress(int percent) {
+    // Loading shows its percentage, saving (no progress from the encoders) a busy bar
+    if (loading) {
+        ioProgressBar->setRange(0, 100);
+        if (percent >= 0) {
+            ioProgressBar->setValue(percent);
+        }
     } else {
-        processedImageLabel->setPixmap(imageToPixmap(originalImage));
+        ioProgressBar->setRange(0, 0);
     }
+    ioProgressBar->setVisible(loading || pendingSaves > 0);
+}
+
+void MainWindow::updateImageDisplays() {
+    originalView->refresh();
+    processedView->refresh();
 }
 
 void MainWindow::updateFilterList() {
@@ -631,83 +916,233 @@ void MainWindow::updateFilterList() {
     clearButton->setEnabled(!pipeline.empty());
 }
 
+void MainWindow::pipelineChanged() {
+    // Speculated previews assumed the previous pipeline
+    speculator.invalidate();
+    speculatedControl.clear();
+    schedulePreview();
+}
+
+void MainWindow::recordEdit(size_t position, size_t removed, size_t inserted, const QString &label,
+                            const std::string &mergeKey) {
+    history.record(pipeline, position, removed, inserted, label.toStdString(), mergeKey);
+    updateHistoryActions();
+}
+
+void MainWindow::restoreHistoryState() {
+    const FilterPipeline::ProcessingMode mode = pipeline.getProcessingMode();
+    pipeline = history.getPipeline();
+    pipeline.setProcessingMode(mode);
+
+    // The controls follow the restored filters (last of each kind, as when adding)
+    brightnessFilter = nullptr;
+    blurFilter = nullptr;
+    for (size_t i = 0; i < pipeline.size(); ++i) {
+        Filter *filter = pipeline.getFilter(i);
+        if (auto *brightnessPtr = dynamic_cast<BrightnessFilter*>(filter)) {
+            brightnessFilter = brightnessPtr;
+        } else if (dynamic_cast<BoxBlurRadius*>(filter)) {
+            blurFilter = filter;
+        }
+    }
+    if (brightnessFilter) {
+        const QSignalBlocker blocker(brightnessSlider);
+        brightnessSlider->setValue(qRound(brightnessFilter->getBrightness() * 100.0f));
+    }
+    if (auto *radius = dynamic_cast<BoxBlurRadius*>(blurFilter)) {
+        const QSignalBlocker blocker(blurRadiusSpinBox);
+        blurRadiusSpinBox->setValue(radius->getRadius());
+    }
+
+    updateFilterList();
+    pipelineChanged();
+
+    // A snapshot of this exact pipeline restores the applied result as is
+    const EditHistory::ReplayBase base = history.replayBase();
+    if (!pipeline.empty() && base.first == pipeline.size()) {
+        processedImage = *base.image;
+        processedStale = false;
+    }
+    updateHistoryActions();
+}
+
+void MainWindow::updateHistoryActions() {
+    const bool undo = history.canUndo();
+    const bool redo = history.canRedo();
+    editUndoAction->setEnabled(undo);
+    editRedoAction->setEnabled(redo);
+    editUndoAction->setText(undo ? "&Annuler " + QString::fromStdString(history.undoLabel()) : "&Annuler");
+    editRedoAction->setText(redo ? "&Rétablir " + QString::fromStdString(history.redoLabel()) : "&Rétablir");
+}
+
+size_t MainWindow::filterIndex(const Filter *filter) const {
+    size_t index = 0;
+    while (index < pipeline.size() && pipeline.getFilter(index) != filter) {
+        ++index;
+    }
+    return index;
+}
+
+void MainWindow::parameterChanged(const QString &control, int value) {
+    if (control != speculatedControl) {
+        speculator.invalidate();
+        speculatedControl = control;
+    } else {
+        speculator.cancel();
+        speculationStep = value >= speculatedValue ? 1 : -1;
+    }
+    speculatedValue = value;
+    schedulePreview();
+}
+
+void MainWindow::schedulePreview() {
+    processedStale = true;
+    resetProfile();
+    if (previewEnabled) {
+        if (!latencyPending) {
+            latencyClock.start();
+            latencyPending = true;
+        }
+        latencyArmed = false;
+        previewTimer.start();
+    }
+}
+
+void MainWindow::resetProfile() {
+    // Tiles of the previous pipeline still in flight report to the old profile
+    profile = std::make_shared<PipelineProfile>();
+    pipeline.setProfile(profile);
+    performanceHud->setProfile(profile);
+}
+
+void MainWindow::onFramePresented() {
+    if (latencyArmed && firstLatencyMs < 0.0) {
+        firstLatencyMs = latencyClock.nsecsElapsed() / 1e6;
+        performanceHud->setPreviewLatency(firstLatencyMs, -1.0);
+    }
+}
+
+void MainWindow::onPreviewComplete() {
+    if (latencyArmed) {
+        performanceHud->setPreviewLatency(firstLatencyMs, latencyClock.nsecsElapsed() / 1e6);
+        latencyArmed = false;
+        latencyPending = false;
+    }
+}
+
+void MainWindow::onPerformanceHudToggle(bool visible) {
+    performanceHud->setVisible(visible);
+    if (visible) {
+        performanceHud->raise();
+    }
+}
+
+void MainWindow::speculateNeighbours() {
+    if (speculatedControl.isEmpty() || !previewEnabled || !hasImage() || isProcessing) {
+        return;
+    }
+    const bool brightness = speculatedControl == "brightness";
+    const Filter *tracked = brightness ? static_cast<const Filter*>(brightnessFilter) : blurFilter;
+    const size_t index = filterIndex(tracked);
+    if (!tracked || index == pipeline.size()) {
+        return;
+    }
+
+    const int minimum = brightness ? brightnessSlider->minimum() : blurRadiusSpinBox->minimum();
+    const int maximum = brightness ? brightnessSlider->maximum() : blurRadiusSpinBox->maximum();
+    std::vector<std::pair<int, FilterPipeline>> variants;
+    for (int step : {speculationStep, -speculationStep}) {
+        const int value = speculatedValue + step;
+        if (value < minimum || value > maximum) {
+            continue;
+        }
+        FilterPipeline variant = pipeline;
+        variant.setProfile(nullptr);    // Speculative work is not what the user waits for
+        Filter *filter = variant.getFilter(index);
+        if (auto *brightnessPtr = dynamic_cast<BrightnessFilter*>(filter)) {
+            brightnessPtr->setBrightness(value / 100.0f);
+        } else if (auto *radius = dynamic_cast<BoxBlurRadius*>(filter)) {
+            radius->setRadius(value);
+        }
+        variants.emplace_back(value, std::move(variant));
+    }
+    speculator.speculate(speculatedControl, variants, processedTiles, processedView->previewTiles());
+}
+
 void MainWindow::updatePreview() {
-    if (!previewEnabled || originalImage.getWidth() == 0 || pipeline.empty()) {
+    if (!previewEnabled || !hasImage() || loading) {
         return;
     }
     
     applyFilters(true);
 }
 
+void MainWindow::onRenderError(const QString &message) {
+    showStatusMessage("Erreur d'aperçu: " + message);
+}
+
 void MainWindow::applyFilters(bool preview) {
-    if (originalImage.getWidth() == 0 || pipeline.empty()) {
+    if (!hasImage()) {
         return;
     }
 
     try {
-        if (!preview && !isProcessing) {
+        if (!preview && !isProcessing && !pipeline.empty()) {
             // Show progress bar for full processing
             isProcessing = true;
             progressBar->setVisible(true);
             progressBar->setValue(0);
             applyButton->setEnabled(false);
-
-            // Apply with progress callback
-            processedImage = pipeline.applyWithProgress(originalImage,
+            processedStale = false;
+
+            // Apply with progress callback, from the closest result the
+            // history holds (often the previous Apply, when only the last
+            // filters changed). The callback runs the event loop, where the
+            // user may edit: the pipeline applied is a copy, and the snapshot
+            // is tagged with the history revision it was copied at.
+            const EditHistory::ReplayBase base = history.replayBase();
+            const uint64_t revision = history.getRevision();
+            const FilterPipeline applied = pipeline;
+            QElapsedTimer applyClock;
+            applyClock.start();
+            processedImage = applied.applyWithProgress(*base.image,
                 [this](float percent, const std::string& filterName) {
                     progressBar->setValue(static_cast<int>(percent));
                     showStatusMessage("Traitement: " + QString::fromStdString(filterName) +
                                     " (" + QString::number(static_cast<int>(percent)) + "%)", 0);
                     QApplication::processEvents(); // Update UI
-                });
+                }, base.first);
+            performanceHud->setApplyTime(applyClock.nsecsElapsed() / 1e6);
+            history.addSnapshot(processedImage, revision);
 
             progressBar->setValue(100);
             progressBar->setVisible(false);
             applyButton->setEnabled(true);
             isProcessing = false;
-        } else {
-            // Quick preview without progress bar
-            processedImage = pipeline.apply(originalImage);
         }
 
-        updateImageDisplays();
+        // Preview: hand the pipeline to the tile cache, the view computes
+        // the tiles it shows when it repaints
+        processedTiles.setPipeline(pipeline);
+        if (!speculatedControl.isEmpty()) {
+            // Next slider step: tiles precomputed while idle, if any
+            speculator.take(speculatedControl, speculatedValue, processedTiles);
+        }
+        if (latencyPending) {
+            // The next repaint of the view shows this pipeline
+            latencyArmed = true;
+            firstLatencyMs = -1.0;
+        }
+        processedView->refresh();
     } catch (const std::exception &e) {
         progressBar->setVisible(false);
         applyButton->setEnabled(true);
         isProcessing = false;
+        processedStale = true;
         showErrorMessage("Erreur de Traitement", QString::fromStdString(e.what()));
     }
 }
 
-QPixmap MainWindow::imageToPixmap(const Image &img) const {
-    if (img.getWidth() == 0 || img.getHeight() == 0) {
-        return QPixmap();
-    }
-    
-    QImage qimg(img.getWidth(), img.getHeight(), QImage::Format_RGB888);
-    
-    if (img.getChannels() == 3) {
-        for (int y = 0; y < img.getHeight(); ++y) {
-            for (int x = 0; x < img.getWidth(); ++x) {
-                int r = img.at(x, y, 0);
-                int g = img.at(x, y, 1);
-                int b = img.at(x, y, 2);
-                qimg.setPixel(x, y, qRgb(r, g, b));
-            }
-        }
-    } else if (img.getChannels() == 1) {
-        for (int y = 0; y < img.getHeight(); ++y) {
-            for (int x = 0; x < img.getWidth(); ++x) {
-                int gray = img.at(x, y, 0);
-                qimg.setPixel(x, y, qRgb(gray, gray, gray));
-            }
-        }
-    }
-    
-    QPixmap pixmap = QPixmap::fromImage(qimg);
-    return pixmap.scaled(400, 300, Qt::KeepAspectRatio, Qt::SmoothTransformation);
-}
-
 void MainWindow::setControlsEnabled(bool enabled) {
     addFilterButton->setEnabled(enabled);
     removeFilterButton->setEnabled(enabled && !pipeline.empty());
@@ -731,5 +1166,10 @@ void MainWindow::showErrorMessage(const QString &title, const QString &message)
 }
 
 void MainWindow::closeEvent(QCloseEvent *event) {
+    if (pendingSaves > 0) {
+        // Do not lose an image being written
+        showStatusMessage("Enregistrement en cours...", 0);
+        ioPool.waitForDone();
+    }
     event->accept();
 }
@@ -0,0 +1,161 @@
+/**
+ * @file PerformanceHud.cpp
+ * @brief Sampling and drawing of the performance overlay
+ *
+ * @details
+ * The text is rebuilt by the timer only; paintEvent() draws the last lines
+ * as they are. The resident set is read from /proc/self/statm (Linux); on
+ * other systems the line shows the reported figures only.
+ *
+ * @see PerformanceHud.hpp for the figures shown
+ * @author Rowan HOUPA
+ * @date January 2026
+ */
+
+#include "PerformanceHud.hpp"
+#include <QFont>
+#include <QFontMetrics>
+#include <QPainter>
+#include <algorithm>
+#include <fstream>
+
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+namespace {
+    constexpr int REFRESH_MS = 250;
+    constexpr int MARGIN = 8;
+
+    QString formatMs(double ms) {
+        if (ms < 0.0) {
+            return "…";
+        }
+        return ms < 10.0 ? QString::number(ms, 'f', 2) + " ms" : QString::number(ms, 'f', 0) + " ms";
+    }
+
+    QString formatBytes(size_t bytes) {
+        return QString::number(bytes / (1024.0 * 1024.0), 'f', 1) + " Mo";
+    }
+}
+
+PerformanceHud::PerformanceHud(QWidget *parent) : QWidget(parent) {
+    // Drawn fully opaque: the view below is not repainted with it
+    setAttribute(Qt::WA_OpaquePaintEvent);
+    setAttribute(Qt::WA_TransparentForMouseEvents);
+    QFont font("Monospace");
+    font.setStyleHint(QFont::TypeWriter);
+    font.setPointSize(9);
+    setFont(font);
+
+    refreshTimer.setInterval(REFRESH_MS);
+    connect(&refreshTimer, &QTimer::timeout, this, &PerformanceHud::refreshStats);
+}
+
+void PerformanceHud::setProfile(std::shared_ptr<const PipelineProfile> newProfile) {
+    profile = std::move(newProfile);
+}
+
+void PerformanceHud::setPreviewLatency(double firstMs, double completeMs) {
+    firstLatencyMs = firstMs;
+    completeLatencyMs = completeMs;
+}
+
+void PerformanceHud::setApplyTime(double ms) {
+    applyMs = ms;
+}
+
+void PerformanceHud::setMemoryProbe(std::function<std::vector<std::pair<QString, size_t>>()> probe) {
+    memoryProbe = std::move(probe);
+}
+
+void PerformanceHud::showEvent(QShowEvent *event) {
+    QWidget::showEvent(event);
+    refreshStats();
+    refreshTimer.start();
+}
+
+void PerformanceHud::hideEvent(QHideEvent *event) {
+    QWidget::hideEvent(event);
+    refreshTimer.stop();
+}
+
+void PerformanceHud::refreshStats() {
+    lines.clear();
+
+    const PipelineProfile::Stats stats = profile ? profile->getStats() : PipelineProfile::Stats{};
+    double filterTotal = 0.0;
+    for (const auto &entry : stats.filters) {
+        filterTotal += entry.totalMs;
+    }
+    for (size_t i = 0; i < stats.filters.size(); ++i) {
+        const auto &entry = stats.filters[i];
+        if (entry.calls == 0) {
+            continue;
+        }
+        const double share = filterTotal > 0.0 ? 100.0 * entry.totalMs / filterTotal : 0.0;
+        lines << QString("%1. %2 [%3]").arg(i + 1).arg(QString::fromStdString(entry.name),
+                                                       QString::fromStdString(entry.device));
+        lines << QString("    %1/Mpx  %2 %  dernier %3")
+                     .arg(formatMs(entry.msPerMegapixel()))
+                     .arg(share, 0, 'f', 0)
+                     .arg(formatMs(entry.lastMs));
+    }
+    if (stats.filters.empty()) {
+        lines << "Aucun filtre exécuté";
+    }
+
+    lines << QString("Pipeline: %1/Mpx, dernier passage %2 (%3 Mpx), Appliquer %4")
+                 .arg(formatMs(stats.msPerMegapixel()))
+                 .arg(formatMs(stats.runs ? stats.lastRunMs : -1.0))
+                 .arg(stats.lastRunPixels / 1e6, 0, 'f', 2)
+                 .arg(formatMs(applyMs));
+    lines << QString("Aperçu: 1er affichage %1, pleine résolution %2")
+                 .arg(formatMs(firstLatencyMs))
+                 .arg(formatMs(completeLatencyMs));
+
+    QString memory = "Mémoire: ";
+    const size_t resident = residentBytes();
+    memory += resident ? formatBytes(resident) + " résidents" : QString("?");
+    if (memoryProbe) {
+        for (const auto &[label, bytes] : memoryProbe()) {
+            memory += ", " + label + " " + formatBytes(bytes);
+        }
+    }
+    lines << memory;
+
+    const QFontMetrics metrics(font());
+    int width = 0;
+    for (const QString &line : lines) {
+        width = std::max(width, metrics.horizontalAdvance(line));
+    }
+    resize(width + 2 * MARGIN, static_cast<int>(lines.size()) * metrics.lineSpacing() + 2 * MARGIN);
+    move(MARGIN, MARGIN);
+    update();
+}
+
+void PerformanceHud::paintEvent(QPaintEvent *event) {
+    Q_UNUSED(event);
+    QPainter painter(this);
+    painter.fillRect(rect(), QColor(20, 20, 20));
+    painter.setPen(QColor(0x9a, 0xe6, 0x9a));
+
+    const QFontMetrics metrics(font());
+    int y = MARGIN + metrics.ascent();
+    for (const QString &line : lines) {
+        painter.drawText(MARGIN, y, line);
+        y += metrics.lineSpacing();
+    }
+}
+
+size_t PerformanceHud::residentBytes() {
+#ifdef __linux__
+    std::ifstream statm("/proc/self/statm");
+    size_t totalPages = 0;
+    size_t residentPages = 0;
+    if (statm >> totalPages >> residentPages) {
+        return residentPages * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    }
+#endif
+    return 0;
+}
@@ -0,0 +1,113 @@
+/**
+ * @file PreviewSpeculator.cpp
+ * @brief Side caches for neighbouring parameter values and their hand-over
+ *
+ * @details
+ * Jobs hold a shared_ptr to their side cache, so evicting an entry while
+ * one of its tiles is being filtered is safe (the tile is simply lost).
+ * take() is a copy of tile pointers under the two caches' locks: no pixel
+ * is copied and no filter runs on the GUI thread.
+ *
+ * @see PreviewSpeculator.hpp for the speculation policy
+ * @author Rowan HOUPA
+ * @date January 2026
+ */
+
+#include "PreviewSpeculator.hpp"
+#include <QThread>
+#include <algorithm>
+
+namespace {
+    constexpr size_t SIDE_CACHE_BYTES = size_t(32) << 20;
+}
+
+PreviewSpeculator::PreviewSpeculator(size_t capacity, QObject *parent)
+    : QObject(parent), capacity(std::max<size_t>(1, capacity)) {
+    pool.setMaxThreadCount(1);
+    pool.setThreadPriority(QThread::LowestPriority);
+}
+
+PreviewSpeculator::~PreviewSpeculator() {
+    stop();
+}
+
+std::list<PreviewSpeculator::Entry>::iterator PreviewSpeculator::findEntry(const QString &control, int value) {
+    for (auto it = entries.begin(); it != entries.end(); ++it) {
+        if (it->value == value && it->control == control) {
+            return it;
+        }
+    }
+    return entries.end();
+}
+
+void PreviewSpeculator::speculate(const QString &control,
+                                  const std::vector<std::pair<int, FilterPipeline>> &variants,
+                                  const TileCache &base, const std::vector<TileIndex> &tiles) {
+    cancel();
+    if (!base.hasSource() || tiles.empty()) {
+        return;
+    }
+
+    const uint64_t current = epoch.load();
+    for (const auto &[value, variantPipeline] : variants) {
+        auto it = findEntry(control, value);
+        if (it == entries.end()) {
+            auto cache = std::make_shared<TileCache>(base.getTileSize(), SIDE_CACHE_BYTES);
+            cache->shareSource(base);
+            cache->setPipeline(variantPipeline);
+            entries.push_front({control, value, std::move(cache)});
+            if (entries.size() > capacity) {
+                entries.pop_back();
+            }
+        } else {
+            entries.splice(entries.begin(), entries, it);
+        }
+
+        std::shared_ptr<TileCache> cache = entries.front().tiles;
+        for (const TileIndex &index : tiles) {
+            if (cache->find(index.level, index.tx, index.ty)) {
+                continue;
+            }
+            pool.start([this, cache, index, current] {
+                if (epoch.load() != current) {
+                    return;
+                }
+                try {
+                    cache->tile(index.level, index.tx, index.ty);
+                } catch (const std::exception &) {
+                    // The live preview reports pipeline errors
+                }
+            });
+        }
+    }
+}
+
+bool PreviewSpeculator::take(const QString &control, int value, TileCache &target) {
+    auto it = findEntry(control, value);
+    if (it == entries.end()) {
+        ++misses;
+        return false;
+    }
+    entries.splice(entries.begin(), entries, it);
+    if (target.adoptTiles(*it->tiles) == 0) {
+        ++misses;
+        return false;
+    }
+    ++hits;
+    return true;
+}
+
+void PreviewSpeculator::cancel() {
+    ++epoch;
+    pool.clear();
+}
+
+void PreviewSpeculator::invalidate() {
+    cancel();
+    entries.clear();
+}
+
+void PreviewSpeculator::stop() {
+    cancel();
+    pool.waitForDone();
+}
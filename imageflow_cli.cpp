@@ -10,14 +10,32 @@
  * - list: Show all image files in current directory
  * - process <file>: Interactive filter selection for single image
  * - batch: Apply same pipeline to all images in directory
+ * - stream: Filter raw RGB/RGBA or Y4M frames from stdin (or a file) to
+ *   stdout (or a file); decode, filtering and encode overlap (FrameStream).
+ *   --temporal reuses unchanged tiles between frames, --ema adds temporal
+ *   denoising (TemporalProcessor)
+ * - scan: Recursive parallel search for images with a persistent index
+ *   (ImageScanner); --list writes the paths for shard --init
+ * - shard: Work a batch shared by several processes or machines through a
+ *   queue directory (WorkQueue); --init fills it from a folder or a list
+ * - shard-report: Item counts and per-worker throughput of a queue
  * - help: Display usage information
  *
  * Features:
  * - ANSI color output for better terminal readability
  * - Dynamic filter discovery from FilterFactory
  * - Supports both CPU and GPU filter variants
- * - Parameter prompts for configurable filters (brightness, blur)
+ * - Parameter prompts for configurable filters (brightness, blur, blend, rotate,
+ *   nlmeans, threshold, adaptive, dither, quantize)
  * - Timing information for performance analysis
+ * - Batch mode: optional near-duplicate detection (perceptual hash + BK-tree)
+ *   right after decoding; duplicates are skipped or aliased (hard link to the
+ *   first output) and the time saved is reported
+ * - Batch mode: optional contact sheets (contact_sheet_<n>.jpg) built from
+ *   thumbnails of the in-memory results, without reloading the outputs
+ * - Batch mode: completed images are journaled (.imageflow_batch.journal,
+ *   BatchJournal); a run restarted with the same pipeline and options skips
+ *   those whose input is unchanged and whose output is intact
  *
  * Filter Selection:
  * - Queries FilterFactory at runtime for available filters
@@ -25,8 +43,13 @@
  * - Prompts for parameters where needed (brightness factor, blur radius)
  *
  * Output Naming:
- * - Single image: <name>_processed.<ext>
+ * - Single image: <name>_processed.<ext>, or the name given after the image
+ * - Batch mode with a final threshold filter: optionally <name>_batch.pbm
  * - Batch mode: <name>_batch.<ext>
+ * - Shard mode: <name>_batch.<ext> next to the input, or in --out, written as
+ *   <name>_batch.<worker>.tmp.<ext> and then renamed onto it
+ * - Pipelines ending with a quantize filter are saved as indexed .png
+ * - Pipelines ending with a threshold filter and saved as .pbm are written 1 bit per pixel
  *
  * @see FilterFactory for filter registration system
  * @author Rowan HOUPA
@@ -40,12 +63,35 @@
 #include <filesystem>
 #include <algorithm>
 #include <memory>
+#include <sstream>
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+#include <fstream>
+#include <thread>
+
+#ifdef __unix__
+#include <unistd.h>
+#endif
 
 #include "Image.hpp"
 #include "FilterPipeline.hpp"
 #include "FilterFactory.hpp"
+#include "PerceptualHash.hpp"
+#include "ContactSheet.hpp"
+#include "FrameStream.hpp"
+#include "TemporalProcessor.hpp"
+#include "WorkQueue.hpp"
+#include "BatchJournal.hpp"
+#include "ImageScanner.hpp"
 #include "filters/BrightnessFilter.hpp"  // For parameter input only
 #include "filters/BoxBlurFilter.hpp"     // For parameter input only
+#include "filters/BlendFilter.hpp"       // For parameter input only
+#include "filters/WarpFilter.hpp"        // For parameter input only
+#include "filters/NLMeansFilter.hpp"     // For parameter input only
+#include "filters/ThresholdFilter.hpp"   // For parameter input and packed PBM output
+#include "filters/DitherFilter.hpp"      // For parameter input only
+#include "filters/QuantizeFilter.hpp"    // For parameter input and indexed PNG output
 
 namespace fs = std::filesystem;
 
@@ -75,7 +121,16 @@ void printHelp() {
     std::cout << BOLD << "COMMANDES:\n" << RESET;
     std::cout << "  " << GREEN << "list" << RESET << "                Liste les images dans le dossier\n";
     std::cout << "  " << GREEN << "process" << RESET << " <image>     Traiter une image spécifique\n";
+    std::cout << "         [sortie]  (.pbm: 1 bit par pixel si le dernier filtre est un seuil)\n";
     std::cout << "  " << GREEN << "batch" << RESET << "               Traiter toutes les images du dossier\n";
+    std::cout << "  " << GREEN << "stream" << RESET << " <fmt> <filtres> Filtrer un flux de trames (rgb, rgba, y4m)\n";
+    std::cout << "         [--size LxH] [--in fichier] [--out fichier]  (défaut: stdin → stdout)\n";
+    std::cout << "         [--temporal] [--tile N] [--threshold N] [--ema 0-0.95]  (mode temporel)\n";
+    std::cout << "  " << GREEN << "scan" << RESET << " <dossier>      Recenser les images d'une arborescence (index persistant)\n";
+    std::cout << "         [--list fichier] [--threads N] [--no-hash] [--verify]\n";
+    std::cout << "  " << GREEN << "shard" << RESET << " <file> <filtres> Traiter une file partagée entre processus/machines\n";
+    std::cout << "         [--init dossier|liste] [--worker id] [--out dossier] [--stale s] [--heartbeat s]\n";
+    std::cout << "  " << GREEN << "shard-report" << RESET << " <file>  Débit par worker et total d'une file\n";
     std::cout << "  " << GREEN << "help" << RESET << "                Afficher cette aide\n\n";
 
     std::cout << BOLD << "FILTRES DISPONIBLES:\n" << RESET;
@@ -105,7 +160,13 @@ void printHelp() {
     std::cout << BOLD << "EXEMPLES:\n" << RESET;
     std::cout << "  imageflow_cli list\n";
     std::cout << "  imageflow_cli process photo.jpg\n";
-    std::cout << "  imageflow_cli batch\n\n";
+    std::cout << "  imageflow_cli process scan.png page.pbm\n";
+    std::cout << "  imageflow_cli batch\n";
+    std::cout << "  capture | imageflow_cli stream y4m grayscale,boxblur > out.y4m\n";
+    std::cout << "  imageflow_cli stream rgb invert --size 1920x1080 --in frames.raw --out inv.raw\n";
+    std::cout << "  capture | imageflow_cli stream y4m nlmeans --temporal --ema 0.6 > out.y4m\n";
+    std::cout << "  imageflow_cli scan /mnt/nfs/archive --list archive.txt\n";
+    std::cout << "  imageflow_cli shard /mnt/nfs/file grayscale,sepia --init /mnt/nfs/photos\n\n";
 }
 
 std::vector<std::string> listImages(const std::string& directory = ".") {
@@ -117,14 +178,8 @@ std::vector<std::string> listImages(const std::string& directory = ".") {
     }
     
     for (const auto& entry : fs::directory_iterator(directory)) {
-        if (entry.is_regular_file()) {
-            std::string ext = entry.path().extension().string();
-            std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
-            
-            if (ext == ".png" || ext == ".jpg" || ext == ".jpeg" || 
-                ext == ".bmp" || ext == ".tga") {
-                images.push_back(entry.path().filename().string());
-            }
+        if (entry.is_regular_file() && ImageScanner::isImagePath(entry.path().filename().string())) {
+            images.push_back(entry.path().filename().string());
         }
     }
     
@@ -241,6 +296,122 @@ std::unique_ptr<Filter> createFilter(int choice) {
             filter = std::make_unique<BoxBlurFilter>(radius);
         }
     }
+    else if (selectedId == "blend") {
+        std::cout << "Image à superposer (chemin): ";
+        std::string overlayPath;
+        std::cin >> overlayPath;
+        std::cout << "Mode (over, multiply, screen, overlay): ";
+        std::string modeName;
+        std::cin >> modeName;
+        std::cout << "Opacité (0.0 - 1.0): ";
+        float opacity;
+        std::cin >> opacity;
+        std::cout << "Position X Y: ";
+        int offsetX, offsetY;
+        std::cin >> offsetX >> offsetY;
+
+        // Decoded once, shared by every image of a batch
+        auto overlay = BlendFilter::loadOverlayCached(overlayPath);
+        if (!overlay) {
+            std::cerr << RED << "Erreur: Impossible de charger " << overlayPath << RESET << "\n";
+            return nullptr;
+        }
+
+        BlendMode mode = BlendMode::Over;
+        if (!BlendFilter::modeFromString(modeName, mode)) {
+            std::cout << YELLOW << "Mode inconnu, 'over' utilisé\n" << RESET;
+        }
+
+        filter = factory.create(selectedId, useGPU);
+        auto* blendFilter = dynamic_cast<BlendFilter*>(filter.get());
+        if (blendFilter) {
+            blendFilter->setOverlay(overlay);
+            blendFilter->setMode(mode);
+            blendFilter->setOpacity(opacity);
+            blendFilter->setOffset(offsetX, offsetY);
+        }
+    }
+    else if (selectedId == "rotate") {
+        std::cout << "Angle en degrés (sens horaire): ";
+        double angle;
+        std::cin >> angle;
+        std::cout << "Interpolation (1 = bilinéaire, 2 = bicubique): ";
+        int interpolation;
+        std::cin >> interpolation;
+
+        filter = factory.create(selectedId, useGPU);
+        auto* warpFilter = dynamic_cast<WarpFilter*>(filter.get());
+        if (warpFilter) {
+            warpFilter->setAngle(angle);
+            warpFilter->setInterpolation(interpolation == 2 ? WarpInterpolation::Bicubic
+                                                            : WarpInterpolation::Bilinear);
+        }
+    }
+    else if (selectedId == "nlmeans") {
+        std::cout << "Force du débruitage h (5 = léger, 10 = normal, 20 = fort): ";
+        float strength;
+        std::cin >> strength;
+        std::cout << "Mode rapide (o/n): ";
+        std::string fast;
+        std::cin >> fast;
+
+        filter = factory.create(selectedId, useGPU);
+        auto* nlmFilter = dynamic_cast<NLMeansFilter*>(filter.get());
+        if (nlmFilter) {
+            nlmFilter->setStrength(strength);
+            nlmFilter->setFastMode(fast == "o" || fast == "O");
+        }
+    }
+    else if (selectedId == "threshold") {
+        std::cout << "Seuil (0-255): ";
+        int value;
+        std::cin >> value;
+
+        filter = factory.create(selectedId, useGPU);
+        auto* thresholdFilter = dynamic_cast<ThresholdFilter*>(filter.get());
+        if (thresholdFilter) {
+            thresholdFilter->setThreshold(value);
+        }
+    }
+    else if (selectedId == "adaptive") {
+        std::cout << "Méthode (1 = Sauvola, 2 = Bradley): ";
+        int method;
+        std::cin >> method;
+        std::cout << "Rayon de la fenêtre (1-50, 15 = normal): ";
+        int radius;
+        std::cin >> radius;
+
+        filter = factory.create(selectedId, useGPU);
+        auto* adaptiveFilter = dynamic_cast<AdaptiveThresholdFilter*>(filter.get());
+        if (adaptiveFilter) {
+            AdaptiveMethod chosen = (method == 2) ? AdaptiveMethod::Bradley : AdaptiveMethod::Sauvola;
+            adaptiveFilter->setMethod(chosen);
+            adaptiveFilter->setK(AdaptiveThresholdFilter::defaultK(chosen));
+            adaptiveFilter->setWindowRadius(radius);
+        }
+    }
+    else if (selectedId == "dither") {
+        std::cout << "Méthode (1 = Floyd-Steinberg, 2 = Bayer): ";
+        int method;
+        std::cin >> method;
+        std::cout << "Niveaux par canal (2 = noir et blanc, 2-256): ";
+        int levels;
+        std::cin >> levels;
+
+        filter = std::make_unique<DitherFilter>(
+            method == 2 ? DitherMode::Ordered : DitherMode::FloydSteinberg, levels);
+    }
+    else if (selectedId == "quantize") {
+        std::cout << "Méthode (1 = k-means, 2 = median cut): ";
+        int method;
+        std::cin >> method;
+        std::cout << "Nombre de couleurs (2-256): ";
+        int colors;
+        std::cin >> colors;
+
+        filter = std::make_unique<QuantizeFilter>(
+            method == 2 ? QuantizeMethod::MedianCut : QuantizeMethod::KMeans, colors);
+    }
     else {
         // No parameters needed - use factory directly
         filter = factory.create(selectedId, useGPU);
@@ -249,11 +420,16 @@ std::unique_ptr<Filter> createFilter(int choice) {
     return filter;
 }
 
-bool processImage(const std::string& inputPath, FilterPipeline& pipeline, const std::string& outputSuffix = "_processed") {
+struct ProcessResult {
+    bool success = false;
+    std::string outputPath;
+    double durationMs = 0.0;    // Pipeline time
+};
+
+bool loadInput(const std::string& inputPath, Image& input) {
     std::cout << "\n" << CYAN << "Traitement de: " << inputPath << RESET << "\n";
     
     // Charger l'image
-    Image input;
     if (!input.loadFromFile(inputPath)) {
         std::cerr << RED << "Erreur: Impossible de charger " << inputPath << RESET << "\n";
         return false;
@@ -262,34 +438,150 @@ bool processImage(const std::string& inputPath, FilterPipeline& pipeline, const
     std::cout << GREEN << "✓" << RESET << " Image chargée: " 
               << input.getWidth() << "x" << input.getHeight() 
               << " (" << input.getChannels() << " canaux)\n";
+    return true;
+}
+
+ProcessResult processLoadedImage(const std::string& inputPath, const Image& input, FilterPipeline& pipeline,
+                                 const std::string& outputSuffix, ContactSheet* contactSheet = nullptr,
+                                 const std::string& outputDirectory = "", const std::string& outputName = "",
+                                 const std::string& workerTag = "") {
+    ProcessResult result;
+    
+    // Générer le nom du fichier de sortie (outputName, s'il est donné, le remplace)
+    fs::path inputPathFs(inputPath);
+    const fs::path outputFolder(outputDirectory);
+    std::string outputPath = outputName.empty()
+        ? (outputFolder / (inputPathFs.stem().string() + outputSuffix +
+                           inputPathFs.extension().string())).string()
+        : outputName;
+    
+    // Seuil en dernier et sortie .pbm: la dernière étape écrit directement 1 bit par pixel
+    auto* thresholder = pipeline.size() > 0 && fs::path(outputPath).extension() == ".pbm"
+        ? dynamic_cast<ThresholdFilter*>(pipeline.getFilter(pipeline.size() - 1))
+        : nullptr;
     
     // Appliquer le pipeline
     std::cout << YELLOW << "⚙ Application de " << pipeline.size() << " filtre(s)...\n" << RESET;
     
     auto start = std::chrono::high_resolution_clock::now();
-    Image output = pipeline.apply(input);
+    Image output;
+    BinaryImage bits;
+    if (thresholder) {
+        FilterPipeline prefix = pipeline;
+        prefix.removeFilter(prefix.size() - 1);
+        thresholder->applyPacked(prefix.apply(input), bits);
+    } else {
+        output = pipeline.apply(input);
+    }
     auto end = std::chrono::high_resolution_clock::now();
     
     double duration = std::chrono::duration<double, std::milli>(end - start).count();
+    result.durationMs = duration;
     
     std::cout << GREEN << "✓" << RESET << " Traitement terminé en " 
               << std::fixed << std::setprecision(2) << duration << " ms\n";
     
-    // Générer le nom du fichier de sortie
-    fs::path inputPathFs(inputPath);
-    std::string outputPath = inputPathFs.stem().string() + outputSuffix + inputPathFs.extension().string();
+    // Vignette depuis le résultat en mémoire (pas de relecture de la sortie)
+    if (contactSheet) {
+        contactSheet->add(thresholder ? bits.toImage() : output);
+    }
+    
+    // Sauvegarder (palette en sortie: PNG indexé, 1 octet ou moins par pixel)
+    const auto* quantizer = pipeline.size() > 0
+        ? dynamic_cast<const QuantizeFilter*>(pipeline.getFilter(pipeline.size() - 1))
+        : nullptr;
+    if (quantizer) {
+        outputPath = fs::path(outputPath).replace_extension(".png").string();
+    }
+    
+    // Avec workerTag: écrit sous un nom propre au worker puis renommé sur la sortie,
+    // pour qu'une image faite deux fois ne laisse jamais un fichier mêlant deux écritures
+    // (l'extension reste en dernier, elle choisit le format)
+    std::string writePath = outputPath;
+    if (!workerTag.empty()) {
+        const fs::path finalPath(outputPath);
+        writePath = (finalPath.parent_path() / (finalPath.stem().string() + "." + workerTag + ".tmp" +
+                                                finalPath.extension().string())).string();
+    }
+    
+    bool saved = false;
+    if (thresholder) {
+        saved = bits.saveToFile(writePath);
+    } else if (quantizer) {
+        IndexedImage indexed = IndexedImage::fromImage(output, quantizer->getColors());
+        saved = indexed.empty() ? output.saveToFile(writePath) : indexed.saveToFile(writePath);
+    } else {
+        saved = output.saveToFile(writePath);
+    }
+    if (writePath != outputPath) {
+        std::error_code error;
+        if (saved) {
+            fs::rename(writePath, outputPath, error);
+            saved = !error;
+        }
+        if (!saved) {
+            fs::remove(writePath, error);
+        }
+    }
     
-    // Sauvegarder
-    if (!output.saveToFile(outputPath)) {
+    if (!saved) {
         std::cerr << RED << "Erreur: Impossible de sauvegarder " << outputPath << RESET << "\n";
-        return false;
+        return result;
     }
     
     std::cout << GREEN << "✓" << RESET << " Sauvegardé: " << BOLD << outputPath << RESET << "\n";
+    result.success = true;
+    result.outputPath = outputPath;
+    return result;
+}
+
+bool processImage(const std::string& inputPath, FilterPipeline& pipeline, const std::string& outputSuffix = "_processed",
+                  const std::string& outputName = "") {
+    Image input;
+    if (!loadInput(inputPath, input)) {
+        return false;
+    }
+    return processLoadedImage(inputPath, input, pipeline, outputSuffix, nullptr, "", outputName).success;
+}
+
+// Output of a near-duplicate: hard link to the original's output (copy if linking fails).
+// Never replaces an existing file: the name can already be the original's own output
+// (same photo in two formats) or another image's output.
+bool aliasOutput(const std::string& originalOutput, const std::string& inputPath, const std::string& outputSuffix,
+                 std::string* aliasOutputPath = nullptr) {
+    fs::path inputPathFs(inputPath);
+    const std::string stem = inputPathFs.stem().string() + outputSuffix;
+    const std::string extension = fs::path(originalOutput).extension().string();
+    fs::path aliasPath = stem + extension;
+    
+    std::error_code ec;
+    if (aliasPath == fs::path(originalOutput) || fs::equivalent(aliasPath, originalOutput, ec)) {
+        std::cout << GREEN << "✓" << RESET << " Alias: " << BOLD << aliasPath.string() << RESET
+                  << " (déjà la sortie de l'original)\n";
+        if (aliasOutputPath) *aliasOutputPath = aliasPath.string();
+        return true;
+    }
+    for (int n = 1; fs::exists(aliasPath, ec); ++n) {
+        aliasPath = stem + "_" + std::to_string(n) + extension;
+    }
+    
+    ec.clear();
+    fs::create_hard_link(originalOutput, aliasPath, ec);
+    if (ec) {
+        ec.clear();
+        fs::copy_file(originalOutput, aliasPath, fs::copy_options::none, ec);
+    }
+    if (ec) {
+        std::cerr << RED << "Erreur: Impossible de créer " << aliasPath.string() << RESET << "\n";
+        return false;
+    }
+    std::cout << GREEN << "✓" << RESET << " Alias: " << BOLD << aliasPath.string() << RESET
+              << " → " << originalOutput << "\n";
+    if (aliasOutputPath) *aliasOutputPath = aliasPath.string();
     return true;
 }
 
-void interactiveMode(const std::string& imagePath) {
+void interactiveMode(const std::string& imagePath, const std::string& outputName = "") {
     Image input;
     if (!input.loadFromFile(imagePath)) {
         std::cerr << RED << "Erreur: Impossible de charger " << imagePath << RESET << "\n";
@@ -323,7 +615,7 @@ void interactiveMode(const std::string& imagePath) {
     }
     
     // Traiter
-    processImage(imagePath, pipeline);
+    processImage(imagePath, pipeline, "_processed", outputName);
 }
 
 void batchMode() {
@@ -356,34 +648,538 @@ void batchMode() {
         return;
     }
     
+    // Quasi-doublons: 0 = tout traiter, 1 = ignorer, 2 = alias vers la sortie de l'original
+    std::cout << "\nQuasi-doublons (0 = tout traiter, 1 = ignorer, 2 = alias): ";
+    int duplicateMode;
+    std::cin >> duplicateMode;
+    int maxDistance = 0;
+    if (duplicateMode == 1 || duplicateMode == 2) {
+        std::cout << "Distance de Hamming max (0-64, 6 = normal): ";
+        std::cin >> maxDistance;
+        maxDistance = std::clamp(maxDistance, 0, 64);
+    } else {
+        duplicateMode = 0;
+    }
+    
+    std::cout << "Planche contact des résultats (o/n): ";
+    char sheetChoice;
+    std::cin >> sheetChoice;
+    std::unique_ptr<ContactSheet> contactSheet;
+    if (sheetChoice == 'o' || sheetChoice == 'O') {
+        contactSheet = std::make_unique<ContactSheet>();
+    }
+    
+    // Seuil en dernier: sorties .pbm à 1 bit par pixel au lieu de l'extension d'entrée
+    bool packedOutput = false;
+    if (dynamic_cast<const ThresholdFilter*>(pipeline.getFilter(pipeline.size() - 1))) {
+        std::cout << "Sorties .pbm à 1 bit par pixel (o/n): ";
+        char packedChoice;
+        std::cin >> packedChoice;
+        packedOutput = packedChoice == 'o' || packedChoice == 'O';
+    }
+    
+    // Same pipeline and options as the journal's run: its completed images are skipped
+    std::ostringstream runKey;
+    runKey << pipeline.getDescription() << "|_batch|" << duplicateMode << "|" << maxDistance
+           << (packedOutput ? "|pbm" : "");
+    BatchJournal journal(".imageflow_batch.journal", runKey.str());
+    if (!journal.isOpen()) {
+        std::cerr << YELLOW << "Journal indisponible: une interruption fera tout recommencer" << RESET << "\n";
+    }
+    
     std::cout << "\n" << BOLD << "Pipeline: " << pipeline.getDescription() << RESET << "\n";
     std::cout << "\n" << CYAN << "Traitement de " << images.size() << " image(s)...\n" << RESET;
     std::cout << std::string(60, '=') << "\n";
     
     int success = 0;
     int failed = 0;
+    int resumed = 0;
+    int unsheeted = 0;                         // Resumed outputs missing from the contact sheet
+    int duplicates = 0;
+    double pipelineTime = 0.0;
+    double hashTime = 0.0;
+    
+    BKTree seen;                               // pHash → index in images
+    std::vector<std::string> outputs(images.size());
     
-    for (const auto& img : images) {
-        if (processImage(img, pipeline, "_batch")) {
+    for (size_t i = 0; i < images.size(); ++i) {
+        const std::string& img = images[i];
+        
+        BatchJournal::Entry previous;
+        if (journal.completed(img, previous)) {
+            resumed++;
+            success++;
+            outputs[i] = previous.outputPath;
+            // Vignette depuis la sortie de l'exécution précédente (.pbm non relisible)
+            Image previousOutput;
+            if (contactSheet && previousOutput.loadFromFile(previous.outputPath)) {
+                contactSheet->add(previousOutput);
+            } else if (contactSheet) {
+                unsheeted++;
+            }
+            if (duplicateMode != 0 && previous.perceptualHash != 0) {
+                seen.insert(previous.perceptualHash, i);
+                pipelineTime += previous.ms;
+            }
+            continue;
+        }
+        
+        Image input;
+        if (!loadInput(img, input)) {
+            failed++;
+            std::cout << std::string(60, '-') << "\n";
+            continue;
+        }
+        
+        uint64_t hash = 0;
+        size_t original = 0;
+        int distance = 0;
+        if (duplicateMode != 0) {
+            auto hashStart = std::chrono::high_resolution_clock::now();
+            hash = PerceptualHash::pHash(input);
+            auto hashEnd = std::chrono::high_resolution_clock::now();
+            hashTime += std::chrono::duration<double, std::milli>(hashEnd - hashStart).count();
+        }
+        
+        if (duplicateMode != 0 && seen.findNearest(hash, maxDistance, original, distance)) {
+            duplicates++;
+            std::cout << YELLOW << "≈ Quasi-doublon de " << images[original]
+                      << " (distance " << distance << ")" << RESET << "\n";
+            if (duplicateMode == 2) {
+                std::string aliasPath;
+                if (aliasOutput(outputs[original], img, "_batch", &aliasPath)) {
+                    success++;
+                    journal.record(img, aliasPath, 0, 0.0);
+                } else {
+                    failed++;
+                }
+            }
+            std::cout << std::string(60, '-') << "\n";
+            continue;
+        }
+        
+        const std::string outputName = packedOutput ? fs::path(img).stem().string() + "_batch.pbm" : "";
+        ProcessResult result = processLoadedImage(img, input, pipeline, "_batch", contactSheet.get(), "", outputName);
+        if (result.success) {
             success++;
+            pipelineTime += result.durationMs;
+            outputs[i] = result.outputPath;
+            journal.record(img, result.outputPath, duplicateMode != 0 ? hash : 0, result.durationMs);
+            // Only processed images can serve as originals
+            if (duplicateMode != 0) seen.insert(hash, i);
         } else {
             failed++;
         }
         std::cout << std::string(60, '-') << "\n";
     }
     
+    journal.flush();
+    
     std::cout << std::string(60, '=') << "\n";
     std::cout << BOLD << "RÉSUMÉ:\n" << RESET;
     std::cout << GREEN << "  Réussis: " << success << RESET << "\n";
+    if (resumed > 0) {
+        std::cout << CYAN << "  Repris du journal (déjà traités): " << resumed << RESET << "\n";
+    }
     if (failed > 0) {
         std::cout << RED << "  Échoués: " << failed << RESET << "\n";
     }
+    if (duplicateMode != 0) {
+        int processed = static_cast<int>(seen.size());
+        double averageTime = processed > 0 ? pipelineTime / processed : 0.0;
+        std::cout << YELLOW << "  Quasi-doublons " << (duplicateMode == 1 ? "ignorés" : "aliasés")
+                  << ": " << duplicates << RESET << "\n";
+        std::cout << "  Hachage perceptuel: " << std::fixed << std::setprecision(2)
+                  << hashTime << " ms au total\n";
+        std::cout << "  Temps de pipeline économisé (estimé): " << duplicates * averageTime / 1000.0
+                  << " s\n";
+    }
+    if (contactSheet && contactSheet->getImageCount() > 0) {
+        int sheets = contactSheet->save("contact_sheet.jpg");
+        std::cout << GREEN << "  Planches contact: " << sheets << " (contact_sheet_<n>.jpg, "
+                  << contactSheet->getImageCount() << " vignettes)" << RESET << "\n";
+    }
+    if (unsheeted > 0) {
+        std::cout << YELLOW << "  Sorties reprises absentes des planches (illisibles): " << unsheeted
+                  << RESET << "\n";
+    }
+}
+
+// Filtres séparés par des virgules ("boxblur,grayscale-gpu"), paramètres par défaut
+bool buildStreamPipeline(const std::string& list, FilterPipeline& pipeline) {
+    auto& factory = FilterFactory::instance();
+    std::stringstream ids(list);
+    std::string id;
+    while (std::getline(ids, id, ',')) {
+        bool useGPU = id.size() > 4 && id.compare(id.size() - 4, 4, "-gpu") == 0;
+        std::string baseId = useGPU ? id.substr(0, id.size() - 4) : id;
+        auto filter = factory.create(baseId, useGPU);
+        if (!filter) {
+            std::cerr << RED << "Filtre inconnu: " << id << RESET << "\n";
+            std::cerr << "Filtres disponibles (suffixe -gpu si supporté):";
+            for (const auto& known : factory.getFilterIds()) {
+                std::cerr << " " << known;
+            }
+            std::cerr << "\n";
+            return false;
+        }
+        pipeline.addFilter(std::move(filter));
+    }
+    return !pipeline.empty();
+}
+
+int streamMode(int argc, char* argv[]) {
+    if (argc < 4) {
+        std::cerr << RED << "Usage: imageflow_cli stream <rgb|rgba|y4m> <filtres> "
+                  << "[--size LxH] [--in fichier] [--out fichier]" << RESET << "\n";
+        return 1;
+    }
+    
+    std::string formatName = argv[2];
+    FrameFormat format;
+    if (formatName == "rgb") {
+        format = FrameFormat::RawRGB;
+    } else if (formatName == "rgba") {
+        format = FrameFormat::RawRGBA;
+    } else if (formatName == "y4m") {
+        format = FrameFormat::Y4M;
+    } else {
+        std::cerr << RED << "Format inconnu: " << formatName << RESET << "\n";
+        return 1;
+    }
+    
+    FilterPipeline pipeline;
+    if (!buildStreamPipeline(argv[3], pipeline)) {
+        return 1;
+    }
+    
+    int width = 0;
+    int height = 0;
+    std::string inputPath = "-";
+    std::string outputPath = "-";
+    bool temporal = false;
+    TemporalOptions temporalOptions;
+    for (int i = 4; i < argc; ++i) {
+        std::string option = argv[i];
+        if (option == "--temporal") {
+            temporal = true;
+            continue;
+        }
+        if (i + 1 >= argc) break;
+        if (option == "--size") {
+            std::sscanf(argv[i + 1], "%dx%d", &width, &height);
+        } else if (option == "--in") {
+            inputPath = argv[i + 1];
+        } else if (option == "--out") {
+            outputPath = argv[i + 1];
+        } else if (option == "--tile") {
+            temporalOptions.tileSize = std::atoi(argv[i + 1]);
+            temporal = true;
+        } else if (option == "--threshold") {
+            temporalOptions.changeThreshold = std::atoi(argv[i + 1]);
+            temporal = true;
+        } else if (option == "--ema") {
+            temporalOptions.denoiseStrength = static_cast<float>(std::atof(argv[i + 1]));
+            temporal = true;
+        }
+        ++i;
+    }
+    
+    std::FILE* in = inputPath == "-" ? stdin : std::fopen(inputPath.c_str(), "rb");
+    std::FILE* out = outputPath == "-" ? stdout : std::fopen(outputPath.c_str(), "wb");
+    if (!in || !out) {
+        std::cerr << RED << "Erreur: Impossible d'ouvrir " << (!in ? inputPath : outputPath) << RESET << "\n";
+        if (in && in != stdin) std::fclose(in);
+        if (out && out != stdout) std::fclose(out);
+        return 1;
+    }
+    
+    FrameReader reader(in, format, width, height);
+    int status = 0;
+    if (!reader.open()) {
+        std::cerr << RED << "Erreur: " << reader.getError() << RESET << "\n";
+        status = 1;
+    } else {
+        std::cerr << CYAN << "Flux " << formatName << " " << reader.getWidth() << "x" << reader.getHeight()
+                  << " → " << pipeline.getDescription() << RESET << "\n";
+        
+        FrameWriter writer(out, format, reader.getChroma(), reader.getStreamParameters());
+        StreamStats stats;
+        if (temporal) {
+            TemporalProcessor processor(pipeline, temporalOptions);
+            if (!processor.isTileReuseEnabled()) {
+                std::cerr << YELLOW << "Un filtre dépend de l'image entière: trames traitées en entier"
+                          << RESET << "\n";
+            }
+            stats = FrameStream::run(reader, writer,
+                                     [&processor](Image&& frame) { return processor.process(std::move(frame)); });
+            std::cerr << CYAN << "Mode temporel: " << std::fixed << std::setprecision(1)
+                      << processor.getStats().skippedFraction() * 100.0 << "% des tuiles réutilisées ("
+                      << processor.getStats().tilesSkipped << "/" << processor.getStats().tiles << ")"
+                      << RESET << "\n";
+        } else {
+            stats = FrameStream::run(reader, writer, pipeline);
+        }
+        
+        std::cerr << GREEN << "✓ " << stats.frames << " trame(s) en " << std::fixed << std::setprecision(2)
+                  << stats.totalMs << " ms (filtres: " << stats.filterMs << " ms, "
+                  << (stats.totalMs > 0.0 ? stats.frames * 1000.0 / stats.totalMs : 0.0) << " trames/s)"
+                  << RESET << "\n";
+        if (!stats.error.empty()) {
+            std::cerr << RED << "Erreur: " << stats.error << RESET << "\n";
+            status = 1;
+        }
+    }
+    
+    if (in != stdin) std::fclose(in);
+    if (out != stdout) std::fclose(out);
+    return status;
+}
+
+int scanMode(int argc, char* argv[]) {
+    if (argc < 3) {
+        std::cerr << RED << "Usage: imageflow_cli scan <dossier> [--list fichier] [--threads N] "
+                  << "[--no-hash] [--verify]" << RESET << "\n";
+        return 1;
+    }
+    
+    const std::string directory = argv[2];
+    if (!fs::is_directory(directory)) {
+        std::cerr << RED << "Erreur: Le dossier n'existe pas: " << directory << RESET << "\n";
+        return 1;
+    }
+    ImageScanner scanner(directory);
+    std::string listPath;
+    for (int i = 3; i < argc; ++i) {
+        std::string option = argv[i];
+        if (option == "--no-hash") {
+            scanner.setHashContents(false);
+        } else if (option == "--verify") {
+            scanner.setVerifyFiles(true);
+        } else if (i + 1 < argc && option == "--list") {
+            listPath = argv[++i];
+        } else if (i + 1 < argc && option == "--threads") {
+            scanner.setThreads(std::atoi(argv[++i]));
+        }
+    }
+    
+    std::vector<ScannedImage> images = scanner.scan();
+    const ImageScanner::Stats& stats = scanner.getStats();
+    
+    uint64_t pixels = 0;
+    size_t undecodable = 0;
+    for (const auto& image : images) {
+        pixels += static_cast<uint64_t>(image.width) * image.height;
+        if (image.width == 0) undecodable++;
+    }
+    std::cout << GREEN << "✓ " << images.size() << " image(s) dans " << stats.directories << " dossier(s) en "
+              << std::fixed << std::setprecision(2) << stats.ms << " ms" << RESET << "\n";
+    std::cout << "  Dossiers relus: " << stats.directoriesListed << " (les autres depuis l'index)\n";
+    std::cout << "  Images analysées: " << stats.imagesProbed << " ("
+              << stats.bytesRead / (1024.0 * 1024.0) << " Mo lus)\n";
+    std::cout << "  Total: " << pixels / 1e6 << " Mpx";
+    if (undecodable > 0) {
+        std::cout << ", " << YELLOW << undecodable << " illisible(s)" << RESET;
+    }
+    std::cout << "\n  Index: " << scanner.getIndexPath() << "\n";
+    
+    if (!listPath.empty()) {
+        std::ofstream list(listPath);
+        for (const auto& image : images) {
+            list << image.path << "\n";
+        }
+        if (!list) {
+            std::cerr << RED << "Erreur: Impossible d'écrire " << listPath << RESET << "\n";
+            return 1;
+        }
+        std::cout << GREEN << "✓" << RESET << " Liste: " << BOLD << listPath << RESET << "\n";
+    }
+    return 0;
+}
+
+// Default worker id: <host>-<pid>, unique across the machines sharing a queue
+std::string defaultWorkerId() {
+    std::string host = "worker";
+    long pid = 0;
+#ifdef __unix__
+    char name[256] = {};
+    if (gethostname(name, sizeof(name) - 1) == 0 && name[0] != '\0') {
+        host = name;
+    }
+    pid = static_cast<long>(getpid());
+#endif
+    return host + "-" + std::to_string(pid);
+}
+
+// Inputs of a shard queue: the images of a folder tree, or a list with one path per line
+std::vector<std::string> readShardInputs(const std::string& source) {
+    std::vector<std::string> inputs;
+    if (fs::is_directory(source)) {
+        ImageScanner scanner(source);
+        scanner.setHashContents(false);     // Headers only: planning, not deduplication
+        for (const auto& image : scanner.scan()) {
+            inputs.push_back(image.path);
+        }
+        return inputs;
+    }
+    std::ifstream list(source);
+    if (!list) {
+        std::cerr << RED << "Erreur: Impossible de lire " << source << RESET << "\n";
+        return inputs;
+    }
+    std::string line;
+    while (std::getline(list, line)) {
+        if (!line.empty() && line[0] != '#') inputs.push_back(line);
+    }
+    return inputs;
+}
+
+void printShardReport(const std::string& queueDir) {
+    const WorkQueue::Report report = WorkQueue::report(queueDir);
+    
+    std::cout << BOLD << "FILE " << queueDir << ":\n" << RESET;
+    std::cout << "  En attente: " << report.pending << ", en cours: " << report.claimed
+              << ", " << GREEN << "terminés: " << report.done << RESET;
+    if (report.failed > 0) {
+        std::cout << ", " << RED << "échoués: " << report.failed << RESET;
+    }
+    std::cout << "\n\n";
+    
+    std::cout << BOLD << "  " << std::left << std::setw(28) << "Worker" << std::right
+              << std::setw(9) << "Traités" << std::setw(9) << "Échoués" << std::setw(9) << "Perdus"
+              << std::setw(10) << "img/s" << std::setw(10) << "Mpx/s" << std::setw(12) << "ms/image"
+              << RESET << "\n";
+    auto printRow = [](const WorkQueue::WorkerStats& worker) {
+        const size_t items = worker.done + worker.failed + worker.lost;
+        std::cout << "  " << std::left << std::setw(28) << worker.worker << std::right
+                  << std::setw(9) << worker.done << std::setw(9) << worker.failed << std::setw(9) << worker.lost
+                  << std::fixed << std::setprecision(2)
+                  << std::setw(10) << worker.itemsPerSecond() << std::setw(10) << worker.megapixelsPerSecond()
+                  << std::setw(12) << (items > 0 ? worker.busyMs / items : 0.0) << "\n";
+    };
+    for (const auto& worker : report.workers) {
+        printRow(worker);
+    }
+    if (report.workers.size() > 1) {
+        std::cout << "  " << std::string(85, '-') << "\n";
+        printRow(report.total);
+    }
+}
+
+int shardMode(int argc, char* argv[]) {
+    if (argc < 4) {
+        std::cerr << RED << "Usage: imageflow_cli shard <dossier-file> <filtres> [--init dossier|liste] "
+                  << "[--worker id] [--out dossier] [--stale s] [--heartbeat s]" << RESET << "\n";
+        return 1;
+    }
+    
+    const std::string queueDir = argv[2];
+    FilterPipeline pipeline;
+    if (!buildStreamPipeline(argv[3], pipeline)) {
+        return 1;
+    }
+    
+    std::string initSource;
+    std::string workerId = defaultWorkerId();
+    std::string outputDirectory;
+    double staleSeconds = 120.0;    // 0: never requeue other workers' claims
+    double heartbeatSeconds = 10.0;
+    for (int i = 4; i + 1 < argc; i += 2) {
+        std::string option = argv[i];
+        if (option == "--init") {
+            initSource = argv[i + 1];
+        } else if (option == "--worker") {
+            workerId = argv[i + 1];
+        } else if (option == "--out") {
+            outputDirectory = argv[i + 1];
+        } else if (option == "--stale") {
+            staleSeconds = std::atof(argv[i + 1]);
+        } else if (option == "--heartbeat") {
+            heartbeatSeconds = std::atof(argv[i + 1]);
+        }
+    }
+    if (staleSeconds > 0.0 && staleSeconds < 3.0 * heartbeatSeconds) {
+        // A live worker must get a few heartbeats in before its claims look stale
+        heartbeatSeconds = staleSeconds / 3.0;
+    }
+    
+    WorkQueue queue(queueDir, workerId);
+    if (!initSource.empty() && !queue.exists()) {
+        // Only the worker that creates the queue scans; the others wait for
+        // it (a large tree may take minutes to scan)
+        size_t created = 0;
+        const bool creator = queue.create([&] {
+            std::vector<std::string> inputs = readShardInputs(initSource);
+            created = inputs.size();
+            return inputs;
+        }, 3600.0);
+        if (creator) {
+            std::cout << GREEN << "✓ File créée: " << created << " image(s)" << RESET << "\n";
+        }
+    }
+    if (!queue.exists()) {
+        std::cerr << RED << "Erreur: Aucune file dans " << queueDir << " (utilisez --init)" << RESET << "\n";
+        return 1;
+    }
+    if (!outputDirectory.empty()) {
+        std::error_code error;
+        fs::create_directories(outputDirectory, error);
+    }
+    
+    std::cout << BOLD << "Worker " << queue.getWorkerId() << ": " << pipeline.getDescription() << RESET << "\n";
+    std::cout << std::string(60, '=') << "\n";
+    queue.startHeartbeat(heartbeatSeconds, staleSeconds);
+    
+    bool waiting = false;
+    while (true) {
+        WorkQueue::Item item;
+        if (!queue.claim(item)) {
+            // Stay while other workers hold claims: a dead one's are requeued by the heartbeat
+            if (staleSeconds <= 0.0 || queue.isFinished()) break;
+            if (!waiting) {
+                std::cout << CYAN << "En attente des images en cours chez les autres workers...\n" << RESET;
+                waiting = true;
+            }
+            std::this_thread::sleep_for(std::chrono::seconds(1));
+            continue;
+        }
+        waiting = false;
+        
+        auto start = std::chrono::steady_clock::now();
+        Image input;
+        ProcessResult result;
+        if (loadInput(item.path, input)) {
+            const std::string folder = outputDirectory.empty()
+                ? fs::path(item.path).parent_path().string() : outputDirectory;
+            result = processLoadedImage(item.path, input, pipeline, "_batch", nullptr, folder, "",
+                                        queue.getWorkerId());
+        }
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        
+        uint64_t pixels = static_cast<uint64_t>(input.getWidth()) * input.getHeight();
+        if (!queue.complete(item, result.success, ms, pixels)) {
+            std::cout << YELLOW << "⚠ Image " << item.id << " remise en file pendant son traitement"
+                      << " (heartbeat trop lent ?)" << RESET << "\n";
+        }
+        std::cout << std::string(60, '-') << "\n";
+    }
+    queue.stopHeartbeat();
+    
+    std::cout << std::string(60, '=') << "\n";
+    printShardReport(queueDir);
+    return 0;
 }
 
 // Forward declaration for filter registration
 extern void registerAllFilters();
 
 int main(int argc, char* argv[]) {
+    // Stream mode: stdout carries the frames, all messages go to stderr
+    const bool streaming = argc > 1 && std::string(argv[1]) == "stream";
+    if (streaming) {
+        std::cout.rdbuf(std::cerr.rdbuf());
+    }
+    
     // CRITICAL: Initialize filters before using CLI
     std::cout << CYAN << "Initialisation des filtres...\n" << RESET;
     registerAllFilters();
@@ -410,14 +1206,31 @@ int main(int argc, char* argv[]) {
     else if (command == "process") {
         if (argc < 3) {
             std::cerr << RED << "Erreur: Nom de fichier manquant\n" << RESET;
-            std::cout << "Usage: imageflow_cli process <image.jpg>\n";
+            std::cout << "Usage: imageflow_cli process <image.jpg> [sortie.png|sortie.pbm]\n";
             return 1;
         }
-        interactiveMode(argv[2]);
+        interactiveMode(argv[2], argc > 3 ? argv[3] : "");
     }
     else if (command == "batch") {
         batchMode();
     }
+    else if (streaming) {
+        return streamMode(argc, argv);
+    }
+    else if (command == "scan") {
+        return scanMode(argc, argv);
+    }
+    else if (command == "shard") {
+        return shardMode(argc, argv);
+    }
+    else if (command == "shard-report") {
+        if (argc < 3) {
+            std::cerr << RED << "Erreur: Dossier de file manquant\n" << RESET;
+            std::cout << "Usage: imageflow_cli shard-report <dossier-file>\n";
+            return 1;
+        }
+        printShardReport(argv[2]);
+    }
     else {
         std::cerr << RED << "Commande inconnue: " << command << RESET << "\n";
         printHelp();
@@ -0,0 +1,142 @@
+/**
+ * @file test_components.cpp
+ * @brief ConnectedComponents checked against a sequential BFS reference
+ *
+ * Random binary images (several sizes and densities, so components cross
+ * the 64-row bands of the parallel labeling) are labeled by
+ * ConnectedComponents and by a plain breadth-first search that visits
+ * seeds in raster order. Both number components in raster order of their
+ * first pixel, so the label images must be equal, as well as the area,
+ * bounding box and centroid of every component.
+ *
+ * @details
+ * - 4- and 8-connectivity
+ * - Sizes include odd widths (packed rows with padding bits) and heights
+ *   that are not multiples of the band height
+ * - Exit code 1 on the first mismatch
+ *
+ * @author Rowan HOUPA
+ * @date January 2026
+ */
+
+#include "BinaryImage.hpp"
+#include "ConnectedComponents.hpp"
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <queue>
+#include <random>
+#include <vector>
+
+namespace {
+    struct Reference {
+        std::vector<uint32_t> labels;
+        std::vector<ComponentStats> components;
+    };
+
+    Reference bfsLabel(const BinaryImage& image, bool eight) {
+        const int width = image.getWidth();
+        const int height = image.getHeight();
+        Reference result;
+        result.labels.assign(static_cast<size_t>(width) * height, 0);
+
+        std::queue<std::pair<int, int>> pending;
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x) {
+                if (!image.get(x, y) || result.labels[static_cast<size_t>(y) * width + x] != 0) continue;
+
+                const uint32_t label = static_cast<uint32_t>(result.components.size() + 1);
+                ComponentStats stats;
+                stats.minX = stats.maxX = x;
+                stats.minY = stats.maxY = y;
+                double sumX = 0.0, sumY = 0.0;
+                result.labels[static_cast<size_t>(y) * width + x] = label;
+                pending.push({x, y});
+                while (!pending.empty()) {
+                    auto [px, py] = pending.front();
+                    pending.pop();
+                    ++stats.area;
+                    sumX += px;
+                    sumY += py;
+                    stats.minX = std::min(stats.minX, px);
+                    stats.maxX = std::max(stats.maxX, px);
+                    stats.minY = std::min(stats.minY, py);
+                    stats.maxY = std::max(stats.maxY, py);
+                    for (int dy = -1; dy <= 1; ++dy) {
+                        for (int dx = -1; dx <= 1; ++dx) {
+                            if ((dx == 0 && dy == 0) || (!eight && dx != 0 && dy != 0)) continue;
+                            const int nx = px + dx, ny = py + dy;
+                            if (nx < 0 || ny < 0 || nx >= width || ny >= height || !image.get(nx, ny)) continue;
+                            uint32_t& neighbour = result.labels[static_cast<size_t>(ny) * width + nx];
+                            if (neighbour == 0) {
+                                neighbour = label;
+                                pending.push({nx, ny});
+                            }
+                        }
+                    }
+                }
+                stats.centroidX = sumX / stats.area;
+                stats.centroidY = sumY / stats.area;
+                result.components.push_back(stats);
+            }
+        }
+        return result;
+    }
+
+    bool check(int width, int height, double density, bool eight, unsigned seed) {
+        std::mt19937 rng(seed);
+        std::bernoulli_distribution bit(density);
+        BinaryImage image(width, height);
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x) {
+                image.set(x, y, bit(rng));
+            }
+        }
+
+        ConnectedComponents labeling(eight ? ConnectedComponents::Connectivity::Eight
+                                           : ConnectedComponents::Connectivity::Four);
+        labeling.label(image);
+        const Reference reference = bfsLabel(image, eight);
+
+        const char* name = eight ? "8-connexité" : "4-connexité";
+        if (labeling.getLabels() != reference.labels) {
+            std::cout << "✗ " << width << "x" << height << " densité " << density << " " << name
+                      << ": étiquettes différentes\n";
+            return false;
+        }
+        const auto& components = labeling.getComponents();
+        bool statsMatch = components.size() == reference.components.size();
+        for (size_t i = 0; statsMatch && i < components.size(); ++i) {
+            const ComponentStats& a = components[i];
+            const ComponentStats& b = reference.components[i];
+            statsMatch = a.area == b.area && a.minX == b.minX && a.maxX == b.maxX && a.minY == b.minY &&
+                         a.maxY == b.maxY && std::abs(a.centroidX - b.centroidX) < 1e-6 &&
+                         std::abs(a.centroidY - b.centroidY) < 1e-6;
+        }
+        if (!statsMatch) {
+            std::cout << "✗ " << width << "x" << height << " densité " << density << " " << name
+                      << ": statistiques différentes\n";
+            return false;
+        }
+        std::cout << "✓ " << width << "x" << height << " densité " << density << " " << name << ": "
+                  << components.size() << " composantes\n";
+        return true;
+    }
+}
+
+int main() {
+    const int sizes[][2] = {{1, 1}, {17, 3}, {257, 130}, {640, 480}, {1001, 777}};
+    const double densities[] = {0.1, 0.45, 0.6, 0.9};
+
+    bool passed = true;
+    unsigned seed = 1;
+    for (const auto& size : sizes) {
+        for (double density : densities) {
+            for (bool eight : {false, true}) {
+                passed = check(size[0], size[1], density, eight, seed++) && passed;
+            }
+        }
+    }
+    std::cout << (passed ? "Tous les tests réussis\n" : "Échec\n");
+    return passed ? 0 : 1;
+}
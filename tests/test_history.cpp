@@ -0,0 +1,133 @@
+/**
+ * @file test_history.cpp
+ * @brief EditHistory undo/redo, slider merging and snapshot replay
+ *
+ * A pipeline is edited the way MainWindow does it (add, slider drag,
+ * parameter change) and every undo/redo is checked against the pipeline
+ * expected at that step. Snapshots must give back the applied result,
+ * only while the filters they cover are unchanged, and a snapshot of a
+ * revision the history has left is refused.
+ *
+ * @details
+ * - Filters are compared by name, which carries their parameters
+ * - The memory cap is checked with snapshots much larger than the diffs
+ * - Exit code 1 on the first failure
+ *
+ * @author Rowan HOUPA
+ * @date January 2026
+ */
+
+#include "EditHistory.hpp"
+#include "filters/BoxBlurFilter.hpp"
+#include "filters/BrightnessFilter.hpp"
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+    bool passed = true;
+
+    void check(bool condition, const std::string& what) {
+        std::cout << (condition ? "✓ " : "✗ ") << what << "\n";
+        passed = condition && passed;
+    }
+
+    std::vector<std::string> names(const FilterPipeline& pipeline) {
+        std::vector<std::string> result;
+        for (size_t i = 0; i < pipeline.size(); ++i) {
+            result.push_back(pipeline.getFilter(i)->getName());
+        }
+        return result;
+    }
+
+    bool samePixels(const Image& a, const Image& b) {
+        return a.getWidth() == b.getWidth() && a.getHeight() == b.getHeight() &&
+               a.getChannels() == b.getChannels() && std::memcmp(a.data(), b.data(), a.size()) == 0;
+    }
+
+    // Result of pipeline from a replay base, as MainWindow's Apply computes it
+    Image replay(const EditHistory& history, const FilterPipeline& pipeline) {
+        const EditHistory::ReplayBase base = history.replayBase();
+        return pipeline.applyWithProgress(*base.image, [](float, const std::string&) {}, base.first);
+    }
+}
+
+int main() {
+    std::mt19937 rng(3);
+    auto original = std::make_shared<Image>(96, 64, 3);
+    for (size_t i = 0; i < original->size(); ++i) original->data()[i] = static_cast<uint8_t>(rng());
+
+    EditHistory history;
+    FilterPipeline pipeline;
+    history.reset(original, pipeline);
+    check(!history.canUndo() && !history.canRedo(), "Historique vide après reset");
+
+    // Add, add, then a slider drag over three values (one merged step)
+    pipeline.addFilter(std::make_unique<BrightnessFilter>(1.2f));
+    history.record(pipeline, 0, 0, 1, "ajout luminosité");
+    const std::vector<std::string> afterBrightness = names(pipeline);
+    pipeline.addFilter(std::make_unique<BoxBlurFilter>(2));
+    history.record(pipeline, 1, 0, 1, "ajout flou");
+    const std::vector<std::string> afterBlur = names(pipeline);
+    for (float value : {1.3f, 1.4f, 1.5f}) {
+        static_cast<BrightnessFilter*>(pipeline.getFilter(0))->setBrightness(value);
+        history.record(pipeline, 0, 1, 1, "luminosité", "brightness");
+    }
+    const std::vector<std::string> afterDrag = names(pipeline);
+
+    check(history.getStats().steps == 3, "Glissement fusionné en une étape");
+    check(names(history.getPipeline()) == afterDrag, "Pipeline courant de l'historique");
+    check(history.undoLabel() == "luminosité", "Libellé d'annulation");
+
+    check(history.undo() && names(history.getPipeline()) == afterBlur, "Annuler le glissement");
+    check(history.undo() && names(history.getPipeline()) == afterBrightness, "Annuler l'ajout du flou");
+    check(history.undo() && history.getPipeline().empty() && !history.canUndo(), "Retour au pipeline vide");
+    check(history.redoLabel() == "ajout luminosité", "Libellé de rétablissement");
+    check(history.redo() && history.redo() && history.redo() && !history.canRedo() &&
+          names(history.getPipeline()) == afterDrag, "Tout rétablir");
+
+    // A new edit after undo drops the redo branch
+    history.undo();
+    pipeline = history.getPipeline();
+    static_cast<BoxBlurFilter*>(pipeline.getFilter(1))->setRadius(4);
+    history.record(pipeline, 1, 1, 1, "rayon du flou", "blur");
+    check(!history.canRedo() && history.getStats().steps == 3, "Nouvelle modification après annulation");
+
+    // Snapshot of the applied result, replayed as is
+    const uint64_t revision = history.getRevision();
+    const Image applied = pipeline.apply(*original);
+    check(history.addSnapshot(applied, revision), "Instantané ajouté");
+    const EditHistory::ReplayBase base = history.replayBase();
+    check(base.first == pipeline.size() && samePixels(*base.image, applied), "Instantané restitué tel quel");
+    check(!history.addSnapshot(applied, revision - 1), "Instantané d'une révision dépassée refusé");
+
+    // Editing the last filter keeps the first one's output (prefix 1 is not
+    // stored here, so replay starts from the original) and undo finds it again
+    static_cast<BoxBlurFilter*>(pipeline.getFilter(1))->setRadius(1);
+    history.record(pipeline, 1, 1, 1, "rayon du flou");
+    check(history.replayBase().first == 0, "Instantané ignoré après modification de son filtre");
+    check(samePixels(replay(history, pipeline), pipeline.apply(*original)), "Rejeu depuis l'original");
+    history.undo();
+    check(history.replayBase().first == 2, "Instantané retrouvé après annulation");
+    check(samePixels(replay(history, history.getPipeline()), applied), "Rejeu après annulation");
+
+    // Memory cap: room for about two snapshots
+    EditHistory bounded(2 * original->size() + 4096);
+    FilterPipeline growing;
+    bounded.reset(original, growing);
+    for (int i = 0; i < 8; ++i) {
+        growing.addFilter(std::make_unique<BrightnessFilter>(1.0f + 0.01f * i));
+        bounded.record(growing, growing.size() - 1, 0, 1, "ajout");
+        bounded.addSnapshot(growing.apply(*original), bounded.getRevision());
+    }
+    const EditHistory::Stats stats = bounded.getStats();
+    check(stats.snapshotBytes + stats.diffBytes <= bounded.getMaxBytes() && stats.steps == 8,
+          "Plafond mémoire respecté");
+    check(samePixels(replay(bounded, growing), growing.apply(*original)), "Rejeu sous plafond mémoire");
+
+    std::cout << (passed ? "Tous les tests réussis\n" : "Échec\n");
+    return passed ? 0 : 1;
+}
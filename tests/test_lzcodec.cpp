@@ -0,0 +1,105 @@
+/**
+ * @file test_lzcodec.cpp
+ * @brief LZCodec round trips and corrupt-input rejection
+ *
+ * Every buffer is compressed, decompressed into a buffer of its size and
+ * compared byte for byte. The shapes cover what the codec special-cases:
+ * empty and tiny inputs (literals only), zeros and short periods (long
+ * matches and continued length bytes), random bytes (skipped literal
+ * runs), image-like gradients, and sizes around the 1 MiB block boundary.
+ *
+ * @details
+ * - Truncated, extended or bit-flipped streams must make decompress()
+ *   return false (or, for a flipped literal, still stay in bounds)
+ * - Exit code 1 on the first mismatch
+ *
+ * @author Rowan HOUPA
+ * @date January 2026
+ */
+
+#include "LZCodec.hpp"
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+    bool roundTrip(const std::string& name, const std::vector<uint8_t>& data) {
+        const std::vector<uint8_t> packed = LZCodec::compress(data.data(), data.size());
+        std::vector<uint8_t> restored(data.size(), 0xAA);
+        if (!LZCodec::decompress(packed, restored.data(), restored.size()) || restored != data) {
+            std::cout << "✗ " << name << ": données différentes après décompression\n";
+            return false;
+        }
+        std::cout << "✓ " << name << ": " << data.size() << " -> " << packed.size() << " octets\n";
+        return true;
+    }
+
+    bool rejectsCorruption(const std::vector<uint8_t>& data) {
+        const std::vector<uint8_t> packed = LZCodec::compress(data.data(), data.size());
+        std::vector<uint8_t> restored(data.size());
+        bool passed = true;
+
+        std::vector<uint8_t> truncated(packed.begin(), packed.end() - 1);
+        if (LZCodec::decompress(truncated, restored.data(), restored.size())) {
+            std::cout << "✗ Flux tronqué accepté\n";
+            passed = false;
+        }
+        std::vector<uint8_t> extended = packed;
+        extended.push_back(0);
+        if (LZCodec::decompress(extended, restored.data(), restored.size())) {
+            std::cout << "✗ Flux prolongé accepté\n";
+            passed = false;
+        }
+        // Any flipped byte: false or a bounded decode, never a crash
+        std::mt19937 rng(7);
+        for (int i = 0; i < 200; ++i) {
+            std::vector<uint8_t> flipped = packed;
+            flipped[rng() % flipped.size()] ^= static_cast<uint8_t>(1 + rng() % 255);
+            LZCodec::decompress(flipped, restored.data(), restored.size());
+        }
+        if (passed) {
+            std::cout << "✓ Flux corrompus rejetés\n";
+        }
+        return passed;
+    }
+}
+
+int main() {
+    std::mt19937 rng(42);
+    bool passed = true;
+
+    passed = roundTrip("Vide", {}) && passed;
+    passed = roundTrip("Un octet", {0x5A}) && passed;
+    passed = roundTrip("Texte court", std::vector<uint8_t>({'a', 'b', 'c', 'a', 'b', 'c', 'a', 'b', 'c', 'd'})) && passed;
+    passed = roundTrip("Zéros (3 blocs)", std::vector<uint8_t>(3 * LZCodec::BLOCK_SIZE + 17, 0)) && passed;
+
+    std::vector<uint8_t> random(LZCodec::BLOCK_SIZE + LZCodec::BLOCK_SIZE / 2);
+    for (uint8_t& byte : random) byte = static_cast<uint8_t>(rng());
+    passed = roundTrip("Aléatoire", random) && passed;
+
+    for (size_t period : {1, 3, 7, 300, 70000}) {
+        std::vector<uint8_t> repeated(2 * LZCodec::BLOCK_SIZE);
+        for (size_t i = 0; i < repeated.size(); ++i) repeated[i] = static_cast<uint8_t>((i % period) * 31 + 5);
+        passed = roundTrip("Période " + std::to_string(period), repeated) && passed;
+    }
+
+    std::vector<uint8_t> gradient(1024 * 768 * 3);
+    for (size_t i = 0; i < gradient.size(); ++i) {
+        const size_t pixel = i / 3;
+        gradient[i] = static_cast<uint8_t>((pixel % 1024) / 4 + (pixel / 1024) / 3 + (rng() % 3));
+    }
+    passed = roundTrip("Dégradé bruité", gradient) && passed;
+
+    for (size_t size : {LZCodec::BLOCK_SIZE - 1, LZCodec::BLOCK_SIZE, LZCodec::BLOCK_SIZE + 1}) {
+        std::vector<uint8_t> mixed(size);
+        for (size_t i = 0; i < size; ++i) mixed[i] = (i / 4096) % 2 ? static_cast<uint8_t>(rng()) : 0;
+        passed = roundTrip("Limite de bloc " + std::to_string(size), mixed) && passed;
+    }
+
+    passed = rejectsCorruption(gradient) && passed;
+
+    std::cout << (passed ? "Tous les tests réussis\n" : "Échec\n");
+    return passed ? 0 : 1;
+}
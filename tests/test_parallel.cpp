@@ -16,7 +16,7 @@
  * Test 2: GPU vs CPU
  * - Compares GrayscaleFilter (CPU) vs GrayscaleFilterGPU (GPU)
  * - Image size: 2048x2048 RGB (~12 MB)
- * - Verifies results match between implementations
+ * - Verifies results match between implementations (ImageCompare, ±1)
  *
  * Output Includes:
  * - Execution times in milliseconds
@@ -31,6 +31,7 @@
 #include <iostream>
 #include <iomanip>
 #include "core/Image.hpp"
+#include "core/ImageCompare.hpp"
 #include "core/filters/GrayscaleFilter.hpp"
 #include "core/filters/GrayscaleFilterGPU.hpp"
 #include "core/filters/InvertFilter.hpp"
@@ -82,25 +83,14 @@ void testGPUvsCPU() {
     std::cout << "GPU (SYCL): " << gpuTime << " ms\n";
     std::cout << "Speedup: " << cpuTime / gpuTime << "x\n";
     
-    // Vérifier que les résultats sont identiques
-    bool resultsMatch = true;
-    int errors = 0;
-    for (int i = 0; i < std::min(cpuResult.size(), gpuResult.size()); ++i) {
-        if (std::abs(cpuResult.data()[i] - gpuResult.data()[i]) > 1) {
-            resultsMatch = false;
-            errors++;
-            if (errors < 5) {
-                std::cout << "Mismatch à l'index " << i 
-                          << ": CPU=" << (int)cpuResult.data()[i]
-                          << ", GPU=" << (int)gpuResult.data()[i] << std::endl;
-            }
-        }
-    }
+    // Vérifier que les résultats sont identiques (tolérance ±1)
+    CompareResult diff = ImageCompare::difference(cpuResult, gpuResult, 1);
     
-    if (resultsMatch) {
-        std::cout << "✓ Résultats CPU/GPU identiques\n";
+    if (diff.mismatches == 0) {
+        std::cout << "✓ Résultats CPU/GPU identiques (écart max " << diff.maxAbsDiff << ")\n";
     } else {
-        std::cout << "✗ " << errors << " différences trouvées\n";
+        std::cout << "✗ " << diff.mismatches << " différences trouvées (écart max "
+                  << diff.maxAbsDiff << ", PSNR " << diff.psnr << " dB)\n";
     }
 }
 
@@ -0,0 +1,142 @@
+/**
+ * @file test_workqueue.cpp
+ * @brief Several processes sharing one WorkQueue directory
+ *
+ * Six local processes work one queue of 2000 items the way the CLI's shard
+ * mode does. One dies holding a claim, another stalls past the stale
+ * timeout with a claim and finds it requeued. Every item must end in
+ * done/ and be completed by exactly one worker.
+ *
+ * @details
+ * - Each worker logs the items whose complete() succeeded to its own file;
+ *   the parent counts them once all workers have exited
+ * - Heartbeat 0.2 s, stale timeout 1 s, as in the shard mode's ratio
+ * - Unix only (fork); elsewhere the test reports itself skipped
+ * - Exit code 1 on the first failure
+ *
+ * @author Rowan HOUPA
+ * @date January 2026
+ */
+
+#include "WorkQueue.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef __unix__
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace {
+    bool passed = true;
+
+    void check(bool condition, const std::string& what) {
+        std::cout << (condition ? "✓ " : "✗ ") << what << "\n";
+        passed = condition && passed;
+    }
+
+    constexpr int ITEMS = 2000;
+    constexpr int WORKERS = 6;
+    constexpr double HEARTBEAT = 0.2;
+    constexpr double STALE = 1.0;
+
+    enum class Role { Normal, Dies, Stalls };
+
+    // Worker loop of the shard mode; returns the process exit code
+    int runWorker(const fs::path& root, const std::string& id, Role role) {
+        WorkQueue queue((root / "queue").string(), id);
+        std::ofstream log(root / (id + ".log"));
+        queue.startHeartbeat(HEARTBEAT, STALE);
+
+        int claims = 0;
+        while (true) {
+            WorkQueue::Item item;
+            if (!queue.claim(item)) {
+                if (queue.isFinished()) break;
+                std::this_thread::sleep_for(std::chrono::milliseconds(50));
+                continue;
+            }
+            ++claims;
+            if (role == Role::Dies && claims == 3) {
+                log.flush();
+                std::_Exit(0);                  // Claim left behind, no heartbeat any more
+            }
+            if (role == Role::Stalls && claims == 3) {
+                queue.stopHeartbeat();
+                std::this_thread::sleep_for(std::chrono::duration<double>(STALE * 2.5));
+                queue.startHeartbeat(HEARTBEAT, STALE);
+            }
+            if (queue.complete(item, true, 1.0, 1)) {
+                log << item.id << "\n";
+            }
+        }
+        queue.stopHeartbeat();
+        return 0;
+    }
+}
+
+int main() {
+#ifdef __unix__
+    const fs::path root = fs::temp_directory_path() / ("imageflow_test_workqueue_" + std::to_string(getpid()));
+    fs::remove_all(root);
+    fs::create_directories(root);
+
+    WorkQueue creator((root / "queue").string(), "creator");
+    check(creator.create([] {
+        std::vector<std::string> inputs;
+        for (int i = 0; i < ITEMS; ++i) inputs.push_back("/images/photo" + std::to_string(i) + ".png");
+        return inputs;
+    }), "File créée");
+
+    std::vector<pid_t> children;
+    for (int w = 0; w < WORKERS; ++w) {
+        const Role role = w == 0 ? Role::Dies : (w == 1 ? Role::Stalls : Role::Normal);
+        const pid_t pid = fork();
+        if (pid == 0) {
+            std::_Exit(runWorker(root, "w" + std::to_string(w), role));
+        }
+        children.push_back(pid);
+    }
+    bool exited = true;
+    for (pid_t pid : children) {
+        int status = 0;
+        exited = waitpid(pid, &status, 0) == pid && WIFEXITED(status) && WEXITSTATUS(status) == 0 && exited;
+    }
+    check(exited, "Tous les workers terminés");
+
+    const WorkQueue::Report report = WorkQueue::report((root / "queue").string());
+    check(report.pending == 0 && report.claimed == 0, "Plus rien en attente ni réservé");
+    check(report.done == ITEMS && report.failed == 0, "Toutes les images dans done/");
+
+    std::map<std::string, int> completions;
+    for (int w = 0; w < WORKERS; ++w) {
+        std::ifstream log(root / ("w" + std::to_string(w) + ".log"));
+        for (std::string id; std::getline(log, id);) completions[id]++;
+    }
+    bool once = completions.size() == ITEMS;
+    for (const auto& [id, count] : completions) once = once && count == 1;
+    check(once, "Chaque image terminée par un seul worker");
+
+    size_t lost = 0;
+    for (const WorkQueue::WorkerStats& worker : report.workers) {
+        if (worker.worker == "w1") lost = worker.lost;
+    }
+    check(lost == 1, "Réservation du worker bloqué remise en file et perdue pour lui");
+
+    fs::remove_all(root);
+#else
+    std::cout << "- Test multi-processus ignoré (fork indisponible)\n";
+#endif
+
+    std::cout << (passed ? "Tous les tests réussis\n" : "Échec\n");
+    return passed ? 0 : 1;
+}